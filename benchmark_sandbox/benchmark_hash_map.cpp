@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+#include "core/config.h"
+#include "core/hash_map.h"
+#include "core/type.h"
+#include "core/vector.h"
+#include "memory/allocators/malloc_allocator.h"
+
+using namespace soul;
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static memory::MallocAllocator s_malloc_allocator("Benchmark Malloc Allocator"_str);
+    return &s_malloc_allocator;
+  }
+} // namespace soul
+
+namespace
+{
+  template <HashTableBackend BackendV>
+  using SoulHashMap =
+    HashMap<u64, u64, HashOp<u64>, std::equal_to<u64>, memory::Allocator, BackendV>;
+
+  using StdHashMap = std::unordered_map<u64, u64>;
+
+  template <HashTableBackend BackendV>
+  void map_insert(SoulHashMap<BackendV>* map, u64 key, u64 value)
+  {
+    map->insert(key, value);
+  }
+
+  void map_insert(StdHashMap* map, u64 key, u64 value)
+  {
+    map->emplace(key, value);
+  }
+
+  template <HashTableBackend BackendV>
+  auto map_find(const SoulHashMap<BackendV>& map, u64 key) -> const u64*
+  {
+    return map.find(key);
+  }
+
+  auto map_find(const StdHashMap& map, u64 key) -> const u64*
+  {
+    const auto it = map.find(key);
+    return it == map.end() ? nullptr : &it->second;
+  }
+
+  struct KeySet
+  {
+    Vector<u64> keys;
+    Vector<u64> lookup_keys; // the same keys in a different order
+    Vector<u64> miss_keys;
+  };
+
+  // NOTE(kevinyu): Hit keys have the top bit clear and miss keys have it set, so a miss key is
+  // never in the map.
+  auto generate_key_set(usize count) -> KeySet
+  {
+    std::mt19937_64 random_engine(count);
+    std::uniform_int_distribution<u64> key_distribution(0, (u64{1} << 63) - 1);
+    KeySet key_set;
+    key_set.keys.reserve(count);
+    key_set.miss_keys.reserve(count);
+    for (usize key_index = 0; key_index < count; key_index++)
+    {
+      key_set.keys.push_back(key_distribution(random_engine));
+      key_set.miss_keys.push_back(key_distribution(random_engine) | (u64{1} << 63));
+    }
+    key_set.lookup_keys = key_set.keys.clone();
+    std::shuffle(key_set.lookup_keys.begin(), key_set.lookup_keys.end(), random_engine);
+    return key_set;
+  }
+
+  template <typename MapT>
+  auto build_map(const KeySet& key_set) -> MapT
+  {
+    MapT map;
+    for (const u64 key : key_set.keys)
+    {
+      map_insert(&map, key, key);
+    }
+    return map;
+  }
+
+  template <typename MapT>
+  void bm_insert(benchmark::State& state)
+  {
+    const KeySet key_set = generate_key_set(soul::cast<usize>(state.range(0)));
+    for (auto _ : state)
+    {
+      MapT map = build_map<MapT>(key_set);
+      benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template <typename MapT>
+  void run_lookup(benchmark::State& state, b8 is_hit)
+  {
+    const KeySet key_set    = generate_key_set(soul::cast<usize>(state.range(0)));
+    const MapT map          = build_map<MapT>(key_set);
+    const Vector<u64>& keys = is_hit ? key_set.lookup_keys : key_set.miss_keys;
+    for (auto _ : state)
+    {
+      u64 sum = 0;
+      for (const u64 key : keys)
+      {
+        const u64* value = map_find(map, key);
+        sum += value != nullptr ? *value : 1;
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template <typename MapT>
+  void bm_lookup_hit(benchmark::State& state)
+  {
+    run_lookup<MapT>(state, true);
+  }
+
+  template <typename MapT>
+  void bm_lookup_miss(benchmark::State& state)
+  {
+    run_lookup<MapT>(state, false);
+  }
+
+  void add_element_counts(benchmark::internal::Benchmark* benchmark)
+  {
+    benchmark->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+  }
+} // namespace
+
+BENCHMARK(bm_insert<SoulHashMap<HashTableBackend::ROBIN>>)->Apply(add_element_counts);
+BENCHMARK(bm_insert<SoulHashMap<HashTableBackend::SWISS>>)->Apply(add_element_counts);
+BENCHMARK(bm_insert<StdHashMap>)->Apply(add_element_counts);
+
+BENCHMARK(bm_lookup_hit<SoulHashMap<HashTableBackend::ROBIN>>)->Apply(add_element_counts);
+BENCHMARK(bm_lookup_hit<SoulHashMap<HashTableBackend::SWISS>>)->Apply(add_element_counts);
+BENCHMARK(bm_lookup_hit<StdHashMap>)->Apply(add_element_counts);
+
+BENCHMARK(bm_lookup_miss<SoulHashMap<HashTableBackend::ROBIN>>)->Apply(add_element_counts);
+BENCHMARK(bm_lookup_miss<SoulHashMap<HashTableBackend::SWISS>>)->Apply(add_element_counts);
+BENCHMARK(bm_lookup_miss<StdHashMap>)->Apply(add_element_counts);
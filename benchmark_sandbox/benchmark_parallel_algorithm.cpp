@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "core/config.h"
+#include "core/type.h"
+#include "core/vector.h"
+#include "memory/allocators/malloc_allocator.h"
+#include "runtime/parallel_algorithm.h"
+#include "runtime/runtime.h"
+
+#include "scoped_runtime.h"
+
+using namespace soul;
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static memory::MallocAllocator s_malloc_allocator("Benchmark Malloc Allocator"_str);
+    if (runtime::is_worker_thread())
+    {
+      return runtime::get_context_allocator();
+    }
+    return &s_malloc_allocator;
+  }
+} // namespace soul
+
+namespace
+{
+  constexpr u32 ELEMENT_COUNT = 1 << 16;
+
+  // NOTE(kevinyu): The cost of an element grows with its index, so an even split up front leave
+  // the workers that got the tail of the range with most of the work.
+  auto compute_imbalanced_element(u32 index) -> f32
+  {
+    f32 value            = soul::cast<f32>(index);
+    const u32 iterations = 1 + index / 1024;
+    for (u32 iteration = 0; iteration < iterations; iteration++)
+    {
+      value = std::sqrt(value * value + 1.0f);
+    }
+    return value;
+  }
+
+  template <typename CreateTaskFn>
+  void run_imbalanced_parallel_for(benchmark::State& state, CreateTaskFn create_task_fn)
+  {
+    ScopedRuntime scoped_runtime(0);
+    const auto block_size = soul::cast<u32>(state.range(0));
+    auto values           = Vector<f32>::WithSize(ELEMENT_COUNT);
+
+    for (auto _ : state)
+    {
+      const runtime::TaskID task_id = create_task_fn(
+        runtime::TaskID::ROOT(),
+        ELEMENT_COUNT,
+        block_size,
+        [&values](int index)
+        {
+          values[index] = compute_imbalanced_element(soul::cast<u32>(index));
+        });
+      runtime::run_and_wait_task(task_id);
+      benchmark::DoNotOptimize(values.data());
+      benchmark::ClobberMemory();
+      runtime::begin_frame();
+    }
+    state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+  }
+
+  void bm_imbalanced_parallel_for_adaptive(benchmark::State& state)
+  {
+    run_imbalanced_parallel_for(
+      state,
+      [](runtime::TaskID parent, u32 count, u32 block_size, auto&& fn) -> runtime::TaskID
+      {
+        return runtime::parallel_for_task_create(parent, count, block_size, fn);
+      });
+  }
+
+  void bm_imbalanced_parallel_for_fixed_grain(benchmark::State& state)
+  {
+    run_imbalanced_parallel_for(
+      state,
+      [](runtime::TaskID parent, u32 count, u32 block_size, auto&& fn) -> runtime::TaskID
+      {
+        return runtime::parallel_for_task_create_fixed_grain(parent, count, block_size, fn);
+      });
+  }
+
+  auto generate_values(u32 count) -> Vector<u64>
+  {
+    std::mt19937_64 random_engine(count);
+    auto values = Vector<u64>::WithSize(count);
+    std::generate(values.begin(), values.end(), random_engine);
+    return values;
+  }
+
+  void bm_std_reduce(benchmark::State& state)
+  {
+    const auto values = generate_values(soul::cast<u32>(state.range(0)));
+    for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(std::reduce(values.begin(), values.end(), u64(0)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void bm_parallel_reduce(benchmark::State& state)
+  {
+    ScopedRuntime scoped_runtime(0);
+    const auto values = generate_values(soul::cast<u32>(state.range(0)));
+    for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(runtime::parallel_reduce(
+        soul::cast<u32>(values.size()),
+        4096,
+        u64(0),
+        [&values](u32 index) -> u64
+        {
+          return values[index];
+        },
+        std::plus<u64>()));
+      runtime::begin_frame();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void bm_std_sort(benchmark::State& state)
+  {
+    const auto source = generate_values(soul::cast<u32>(state.range(0)));
+    auto values       = source.clone();
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      std::copy(source.begin(), source.end(), values.begin());
+      state.ResumeTiming();
+      std::sort(values.begin(), values.end());
+      benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void bm_parallel_sort(benchmark::State& state)
+  {
+    ScopedRuntime scoped_runtime(0);
+    const auto source = generate_values(soul::cast<u32>(state.range(0)));
+    auto values       = source.clone();
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      std::copy(source.begin(), source.end(), values.begin());
+      state.ResumeTiming();
+      runtime::parallel_sort<u64>(values.span(), 4096);
+      benchmark::DoNotOptimize(values.data());
+      runtime::begin_frame();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+} // namespace
+
+BENCHMARK(bm_imbalanced_parallel_for_adaptive)->Arg(16)->Arg(256)->Arg(4096)->UseRealTime();
+BENCHMARK(bm_imbalanced_parallel_for_fixed_grain)->Arg(16)->Arg(256)->Arg(4096)->UseRealTime();
+BENCHMARK(bm_std_reduce)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(bm_parallel_reduce)->Arg(1 << 16)->Arg(1 << 22)->UseRealTime();
+BENCHMARK(bm_std_sort)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(bm_parallel_sort)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
@@ -0,0 +1,167 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/config.h"
+#include "core/deque.h"
+#include "core/option.h"
+#include "core/ring_queue.h"
+#include "core/type.h"
+#include "memory/allocators/malloc_allocator.h"
+
+using namespace soul;
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static memory::MallocAllocator s_malloc_allocator("Benchmark Malloc Allocator"_str);
+    return &s_malloc_allocator;
+  }
+} // namespace soul
+
+namespace
+{
+  constexpr usize ITEM_COUNT     = 1 << 20;
+  constexpr usize QUEUE_CAPACITY = 1024;
+
+  // NOTE(kevinyu): The baseline, a Deque behind a mutex and bounded to the same capacity as the
+  // ring queues so a fast producer cannot run away from the consumers.
+  class MutexDeque
+  {
+  public:
+    explicit MutexDeque(usize capacity) : capacity_(capacity) {}
+
+    auto try_push(u64 value) -> b8
+    {
+      std::lock_guard guard(mutex_);
+      if (deque_.size() >= capacity_)
+      {
+        return false;
+      }
+      deque_.push_back(value);
+      return true;
+    }
+
+    auto try_pop() -> Option<u64>
+    {
+      std::lock_guard guard(mutex_);
+      if (deque_.empty())
+      {
+        return nilopt;
+      }
+      return deque_.pop_front();
+    }
+
+  private:
+    usize capacity_;
+    std::mutex mutex_;
+    Deque<u64> deque_;
+  };
+
+  template <typename QueueT>
+  void produce(QueueT* queue, u64 begin, u64 end)
+  {
+    for (u64 value = begin; value < end; value++)
+    {
+      while (!queue->try_push(value))
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  template <typename QueueT>
+  void bm_spsc(benchmark::State& state)
+  {
+    QueueT queue(QUEUE_CAPACITY);
+    for (auto _ : state)
+    {
+      std::thread producer(
+        [&queue]()
+        {
+          produce(&queue, 0, ITEM_COUNT);
+        });
+      u64 sum = 0;
+      for (usize item_index = 0; item_index < ITEM_COUNT;)
+      {
+        const Option<u64> value = queue.try_pop();
+        if (value.is_some())
+        {
+          sum += value.unwrap();
+          item_index++;
+        }
+      }
+      producer.join();
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ITEM_COUNT);
+  }
+
+  // NOTE(kevinyu): range(0) producers and range(1) consumers share one queue. Consumers stop once
+  // ITEM_COUNT items have been popped in total.
+  template <typename QueueT>
+  void bm_mpmc(benchmark::State& state)
+  {
+    const auto producer_count     = soul::cast<usize>(state.range(0));
+    const auto consumer_count     = soul::cast<usize>(state.range(1));
+    const usize item_per_producer = ITEM_COUNT / producer_count;
+    const usize item_count        = item_per_producer * producer_count;
+    QueueT queue(QUEUE_CAPACITY);
+    for (auto _ : state)
+    {
+      std::atomic<usize> popped_count = 0;
+      std::atomic<u64> sum            = 0;
+      std::vector<std::thread> threads;
+      for (usize producer_index = 0; producer_index < producer_count; producer_index++)
+      {
+        threads.emplace_back(
+          [&queue, producer_index, item_per_producer]()
+          {
+            const u64 begin = producer_index * item_per_producer;
+            produce(&queue, begin, begin + item_per_producer);
+          });
+      }
+      for (usize consumer_index = 0; consumer_index < consumer_count; consumer_index++)
+      {
+        threads.emplace_back(
+          [&queue, &popped_count, &sum, item_count]()
+          {
+            u64 local_sum = 0;
+            while (popped_count.load(std::memory_order_relaxed) < item_count)
+            {
+              const Option<u64> value = queue.try_pop();
+              if (value.is_some())
+              {
+                local_sum += value.unwrap();
+                popped_count.fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+            sum.fetch_add(local_sum, std::memory_order_relaxed);
+          });
+      }
+      for (std::thread& thread : threads)
+      {
+        thread.join();
+      }
+      benchmark::DoNotOptimize(sum.load());
+    }
+    state.SetItemsProcessed(state.iterations() * item_count);
+  }
+
+  void add_thread_counts(benchmark::internal::Benchmark* benchmark)
+  {
+    benchmark->ArgNames({"producer", "consumer"});
+    benchmark->Args({1, 1})->Args({2, 2})->Args({4, 1})->Args({1, 4})->Args({4, 4});
+  }
+} // namespace
+
+BENCHMARK(bm_spsc<SpscQueue<u64>>)->UseRealTime();
+BENCHMARK(bm_spsc<MpmcQueue<u64>>)->UseRealTime();
+BENCHMARK(bm_spsc<MutexDeque>)->UseRealTime();
+
+BENCHMARK(bm_mpmc<MpmcQueue<u64>>)->Apply(add_thread_counts)->UseRealTime();
+BENCHMARK(bm_mpmc<MutexDeque>)->Apply(add_thread_counts)->UseRealTime();
@@ -0,0 +1,123 @@
+#include <cmath>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "core/config.h"
+#include "core/type.h"
+#include "core/vector.h"
+#include "memory/allocators/malloc_allocator.h"
+#include "runtime/runtime.h"
+
+#include "scoped_runtime.h"
+
+using namespace soul;
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static memory::MallocAllocator s_malloc_allocator("Benchmark Malloc Allocator"_str);
+    if (runtime::is_worker_thread())
+    {
+      return runtime::get_context_allocator();
+    }
+    return &s_malloc_allocator;
+  }
+} // namespace soul
+
+namespace
+{
+  constexpr u32 ELEMENT_COUNT = 1 << 18;
+  constexpr u32 BLOCK_SIZE    = 256;
+
+  // NOTE(kevinyu): Enough arithmetic per element that the loop is compute bound, so the speedup
+  // over one worker show the scheduler overhead instead of the memory bandwidth.
+  auto compute_element(u32 index) -> f32
+  {
+    f32 value = soul::cast<f32>(index);
+    for (u32 iteration = 0; iteration < 16; iteration++)
+    {
+      value = std::sqrt(value * value + 1.0f);
+    }
+    return value;
+  }
+
+  void add_worker_counts(benchmark::internal::Benchmark* benchmark)
+  {
+    const auto hardware_thread_count = std::max(1u, std::thread::hardware_concurrency());
+    u32 thread_count                 = 1;
+    for (; thread_count < hardware_thread_count; thread_count *= 2)
+    {
+      benchmark->Arg(thread_count);
+    }
+    benchmark->Arg(hardware_thread_count);
+  }
+
+  template <typename CreateTaskFn>
+  void run_parallel_for(benchmark::State& state, CreateTaskFn create_task_fn)
+  {
+    ScopedRuntime scoped_runtime(soul::cast<u16>(state.range(0)));
+    auto values = Vector<f32>::WithSize(ELEMENT_COUNT);
+
+    for (auto _ : state)
+    {
+      const runtime::TaskID task_id = create_task_fn(
+        runtime::TaskID::ROOT(),
+        ELEMENT_COUNT,
+        BLOCK_SIZE,
+        [&values](int index)
+        {
+          values[index] = compute_element(soul::cast<u32>(index));
+        });
+      runtime::run_and_wait_task(task_id);
+      benchmark::DoNotOptimize(values.data());
+      benchmark::ClobberMemory();
+      runtime::begin_frame();
+    }
+    state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+  }
+
+  void bm_parallel_for_adaptive(benchmark::State& state)
+  {
+    run_parallel_for(
+      state,
+      [](runtime::TaskID parent, u32 count, u32 block_size, auto&& fn) -> runtime::TaskID
+      {
+        return runtime::parallel_for_task_create(parent, count, block_size, fn);
+      });
+  }
+
+  void bm_parallel_for_fixed_grain(benchmark::State& state)
+  {
+    run_parallel_for(
+      state,
+      [](runtime::TaskID parent, u32 count, u32 block_size, auto&& fn) -> runtime::TaskID
+      {
+        return runtime::parallel_for_task_create_fixed_grain(parent, count, block_size, fn);
+      });
+  }
+
+  // NOTE(kevinyu): Many empty tasks, measure the cost of create, steal and finish alone.
+  void bm_task_spawn(benchmark::State& state)
+  {
+    ScopedRuntime scoped_runtime(soul::cast<u16>(state.range(0)));
+    constexpr u32 TASK_COUNT = 4096;
+
+    for (auto _ : state)
+    {
+      const runtime::TaskID parent_id = runtime::create_task();
+      for (u32 task_index = 0; task_index < TASK_COUNT; task_index++)
+      {
+        runtime::create_and_run_task(parent_id, [](runtime::TaskID) {});
+      }
+      runtime::run_and_wait_task(parent_id);
+      runtime::begin_frame();
+    }
+    state.SetItemsProcessed(state.iterations() * TASK_COUNT);
+  }
+} // namespace
+
+BENCHMARK(bm_parallel_for_adaptive)->Apply(add_worker_counts)->UseRealTime();
+BENCHMARK(bm_parallel_for_fixed_grain)->Apply(add_worker_counts)->UseRealTime();
+BENCHMARK(bm_task_spawn)->Apply(add_worker_counts)->UseRealTime();
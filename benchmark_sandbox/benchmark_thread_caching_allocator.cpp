@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "core/config.h"
+#include "core/type.h"
+#include "core/vector.h"
+#include "memory/allocators/malloc_allocator.h"
+#include "memory/allocators/page_allocator.h"
+#include "memory/allocators/proxy_allocator.h"
+#include "memory/allocators/thread_caching_allocator.h"
+
+using namespace soul;
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static memory::MallocAllocator s_malloc_allocator("Benchmark Malloc Allocator"_str);
+    return &s_malloc_allocator;
+  }
+} // namespace soul
+
+namespace
+{
+  constexpr usize BATCH_SIZE      = 256;
+  constexpr usize SIZE_LIST_COUNT = 4096;
+
+  // NOTE(kevinyu): Mostly small blocks with a tail of medium and large ones, roughly what the
+  // engine containers ask the default allocator for.
+  auto generate_sizes(u32 seed) -> Vector<usize>
+  {
+    std::mt19937 random_engine(seed);
+    std::uniform_int_distribution<usize> small_distribution(8, 256);
+    std::uniform_int_distribution<usize> medium_distribution(257, 8 * ONE_KILOBYTE);
+    std::uniform_int_distribution<usize> large_distribution(
+      64 * ONE_KILOBYTE, 512 * ONE_KILOBYTE);
+    std::uniform_int_distribution<u32> kind_distribution(0, 99);
+    Vector<usize> sizes;
+    sizes.reserve(SIZE_LIST_COUNT);
+    for (usize size_index = 0; size_index < SIZE_LIST_COUNT; size_index++)
+    {
+      const u32 kind = kind_distribution(random_engine);
+      if (kind < 80)
+      {
+        sizes.push_back(small_distribution(random_engine));
+      } else if (kind < 98)
+      {
+        sizes.push_back(medium_distribution(random_engine));
+      } else
+      {
+        sizes.push_back(large_distribution(random_engine));
+      }
+    }
+    return sizes;
+  }
+
+  // NOTE(kevinyu): Every benchmark thread allocate a batch of mixed size blocks, touch them and
+  // free them in a different order than they were allocated.
+  void run_allocate_free(benchmark::State& state, memory::Allocator* allocator)
+  {
+    const Vector<usize> sizes = generate_sizes(soul::cast<u32>(state.thread_index()));
+    void* addrs[BATCH_SIZE];
+    usize size_index = 0;
+    for (auto _ : state)
+    {
+      for (usize block_index = 0; block_index < BATCH_SIZE; block_index++)
+      {
+        addrs[block_index] = allocator->allocate(sizes[size_index], alignof(std::max_align_t));
+        *soul::cast<byte*>(addrs[block_index]) = byte{1};
+        size_index                             = (size_index + 1) % SIZE_LIST_COUNT;
+      }
+      benchmark::ClobberMemory();
+      for (usize block_index = 0; block_index < BATCH_SIZE; block_index += 2)
+      {
+        allocator->deallocate(addrs[block_index]);
+      }
+      for (usize block_index = 1; block_index < BATCH_SIZE; block_index += 2)
+      {
+        allocator->deallocate(addrs[block_index]);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+  }
+
+  void bm_malloc_allocator(benchmark::State& state)
+  {
+    static memory::MallocAllocator s_allocator("Benchmark Malloc Allocator"_str);
+    run_allocate_free(state, &s_allocator);
+  }
+
+  // NOTE(kevinyu): The default allocator before the proxies became thread safe without a lock.
+  void bm_mutex_malloc_allocator(benchmark::State& state)
+  {
+    static memory::MallocAllocator s_malloc_allocator("Benchmark Malloc Allocator"_str);
+    static memory::ProxyAllocator<memory::MallocAllocator, memory::MutexProxy> s_allocator(
+      &s_malloc_allocator, memory::MutexProxy::Config());
+    run_allocate_free(state, &s_allocator);
+  }
+
+  void bm_thread_caching_allocator(benchmark::State& state)
+  {
+    static memory::PageAllocator s_page_allocator("Benchmark Page Allocator"_str);
+    static memory::ThreadCachingAllocator s_allocator(
+      "Benchmark Thread Caching Allocator"_str, &s_page_allocator);
+    run_allocate_free(state, &s_allocator);
+  }
+
+  void add_thread_counts(benchmark::internal::Benchmark* benchmark)
+  {
+    const auto hardware_thread_count = std::max(1u, std::thread::hardware_concurrency());
+    u32 thread_count                 = 1;
+    for (; thread_count < hardware_thread_count; thread_count *= 2)
+    {
+      benchmark->Threads(soul::cast<int>(thread_count));
+    }
+    benchmark->Threads(soul::cast<int>(hardware_thread_count));
+  }
+} // namespace
+
+BENCHMARK(bm_malloc_allocator)->Apply(add_thread_counts)->UseRealTime();
+BENCHMARK(bm_mutex_malloc_allocator)->Apply(add_thread_counts)->UseRealTime();
+BENCHMARK(bm_thread_caching_allocator)->Apply(add_thread_counts)->UseRealTime();
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/type.h"
+#include "memory/allocators/linear_allocator.h"
+#include "memory/allocators/page_allocator.h"
+#include "memory/allocators/proxy_allocator.h"
+#include "runtime/runtime.h"
+
+// NOTE(kevinyu): Same allocator setup as app::AppRuntime, but with a configurable worker count
+// so each benchmark run can init and shutdown its own runtime.
+class ScopedRuntime
+{
+public:
+  explicit ScopedRuntime(soul::u16 thread_count)
+      : page_allocator_("Page allocator"_str),
+#if defined(SOUL_THREAD_CACHING_DEFAULT_ALLOCATOR)
+        default_backing_allocator_("Default Allocator"_str, &page_allocator_),
+#else
+        default_backing_allocator_("Default Allocator"_str),
+#endif
+        default_allocator_(
+          &default_backing_allocator_,
+          runtime::DefaultAllocatorProxy::Config(
+            memory::ProfileProxy::Config(),
+            runtime::FrameAllocationProxy::Config(),
+            memory::CounterProxy::Config(),
+            memory::ClearValuesProxy::Config{u8{0xFA}, u8{0xFF}},
+            memory::BoundGuardProxy::Config())),
+        linear_allocator_("Main Thread Temporary Allocator"_str, ONE_GIGABYTE, &page_allocator_),
+        temp_allocator_(&linear_allocator_, runtime::TempProxy::Config())
+  {
+    runtime::init({thread_count, 4096, &temp_allocator_, ONE_GIGABYTE, &default_allocator_});
+  }
+
+  ScopedRuntime(const ScopedRuntime&)                    = delete;
+  ScopedRuntime(ScopedRuntime&&)                         = delete;
+  auto operator=(const ScopedRuntime&) -> ScopedRuntime& = delete;
+  auto operator=(ScopedRuntime&&) -> ScopedRuntime&      = delete;
+
+  ~ScopedRuntime()
+  {
+    runtime::shutdown();
+  }
+
+private:
+  memory::PageAllocator page_allocator_;
+  runtime::DefaultBackingAllocator default_backing_allocator_;
+  runtime::DefaultAllocator default_allocator_;
+  memory::LinearAllocator linear_allocator_;
+  runtime::TempAllocator temp_allocator_;
+};
@@ -9,6 +9,8 @@
 #include "misc/json.h"
 #include "misc/string_util.h"
 
+#include "runtime/runtime.h"
+
 #include <curl/curl.h>
 #include <curl/easy.h>
 
@@ -71,25 +73,47 @@ namespace khaos
     return doc.dump();
   }
 
+  struct StreamingWriteContext
+  {
+    StreamingBuffer* buffer;
+    const std::atomic_bool* cancel_flag;
+
+    [[nodiscard]]
+    auto is_cancelled() const -> b8
+    {
+      return cancel_flag->load(std::memory_order_relaxed) ||
+             runtime::is_background_cancel_requested();
+    }
+  };
+
   auto streaming_write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) -> size_t
   {
     const auto full_response = StringView(ptr, nmemb);
     SOUL_LOG_INFO("Response : {}", full_response);
-    auto* buffer = reinterpret_cast<StreamingBuffer*>(userdata);
+    const auto* context = reinterpret_cast<const StreamingWriteContext*>(userdata);
+    // NOTE(kevinyu): Returning less than the received size make curl abort the transfer.
+    if (context->is_cancelled())
+    {
+      return 0;
+    }
     if (nmemb < 4)
     {
       return size * nmemb;
     }
     str::for_each_line(full_response, 
-      [buffer](u64 line_i, StringView line)
+      [context](u64 line_i, StringView line)
       {
+        if (context->is_cancelled())
+        {
+          return;
+        }
         if (StringView(line.data(), 4) == "data"_str)
         {
           const auto trimmed_response = str::trim(StringView(line.data() + 6, line.size() - 6));
           if (trimmed_response != "[DONE]"_str)
           {
             const auto response         = from_json_string<TextgenResponse>(trimmed_response);
-            buffer->push(response.choices.back().text.cview());
+            context->buffer->push(response.choices.back().text.cview());
           }
         }
       });
@@ -108,6 +132,7 @@ namespace khaos
 
   void TextgenBackend::request_streaming_completion(
     StreamingBuffer* buffer,
+    const std::atomic_bool* cancel_flag,
     StringView url,
     StringView prompt,
     const SamplerParameter& parameter,
@@ -130,10 +155,14 @@ namespace khaos
     SOUL_LOG_INFO("Request body : {}", request_body.c_str());
     curl_easy_setopt(handle_, CURLOPT_POSTFIELDS, request_body.c_str());
     curl_easy_setopt(handle_, CURLOPT_WRITEFUNCTION, streaming_write_callback);
-    curl_easy_setopt(handle_, CURLOPT_WRITEDATA, reinterpret_cast<void*>(buffer));
+    StreamingWriteContext write_context = {.buffer = buffer, .cancel_flag = cancel_flag};
+    curl_easy_setopt(handle_, CURLOPT_WRITEDATA, reinterpret_cast<void*>(&write_context));
     const auto result = curl_easy_perform(handle_);
 
-    if (result != CURLE_OK)
+    if (result == CURLE_WRITE_ERROR && write_context.is_cancelled())
+    {
+      SOUL_LOG_INFO("Streaming completion cancelled");
+    } else if (result != CURLE_OK)
     {
       SOUL_LOG_ERROR("curl_easy_perform() failed: {}", curl_easy_strerror(result));
     }
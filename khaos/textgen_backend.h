@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "streaming_buffer.h"
 #include "type.h"
 
@@ -19,8 +21,11 @@ namespace khaos
     auto operator=(const TextgenBackend&) -> TextgenBackend& = delete;
     auto operator=(TextgenBackend&&) -> TextgenBackend&      = default;
 
+    // NOTE(kevinyu): The request is aborted between two streamed tokens once cancel_flag is set or
+    // the runtime is shutting down.
     void request_streaming_completion(
       StreamingBuffer* buffer,
+      const std::atomic_bool* cancel_flag,
       StringView url,
       StringView prompt,
       const SamplerParameter& parameter,
@@ -1,11 +1,35 @@
 #include "textgen_system.h"
 #include "textgen_backend.h"
 
+#include "runtime/runtime.h"
+
 namespace khaos
 {
+  TextgenSystem::~TextgenSystem()
+  {
+    cancel();
+    // NOTE(kevinyu): The background task reference this, wait until its closure has returned.
+    if (background_task_id_.is_some())
+    {
+      runtime::wait_background_task(background_task_id_.some_ref());
+    }
+  }
+
+  void TextgenSystem::cancel()
+  {
+    textgen_task_queue_.clear();
+    is_cancel_requested_ = true;
+  }
+
+  auto TextgenSystem::is_task_running() const -> b8
+  {
+    return background_task_id_.is_some() &&
+           !runtime::is_background_task_complete(background_task_id_.some_ref());
+  }
+
   void TextgenSystem::on_new_frame()
   {
-    if (is_task_running_)
+    if (is_task_running())
     {
       return;
     }
@@ -22,9 +46,9 @@ namespace khaos
       return;
     }
 
-    is_task_running_ = true;
-    active_task_     = textgen_task_queue_.pop_back();
-    thread_          = std::thread(
+    is_cancel_requested_ = false;
+    active_task_         = textgen_task_queue_.pop_back();
+    background_task_id_  = runtime::create_background_task(
       [this]()
       {
         const auto& task = active_task_.some_ref();
@@ -59,14 +83,13 @@ namespace khaos
         TextgenBackend backend;
         backend.request_streaming_completion(
           &streaming_buffer_,
+          &is_cancel_requested_,
           task.api_url.cview(),
           prompt.cview(),
           task.sampler_parameter,
           task.max_token_count,
           task.grammar_string.cview());
-        is_task_running_ = false;
       });
-    thread_.detach();
   }
   
   void TextgenSystem::push_task(OwnRef<TextgenTask> task)
@@ -76,7 +99,7 @@ namespace khaos
 
   auto TextgenSystem::is_any_pending_response() const -> b8
   {
-    return (is_task_running_ || !textgen_task_queue_.empty());
+    return (is_task_running() || !textgen_task_queue_.empty());
   }
 
   auto TextgenSystem::streaming_buffer_cview() const -> StringView
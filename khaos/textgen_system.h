@@ -2,6 +2,8 @@
 
 #include "core/function.h"
 #include "core/deque.h"
+#include "core/option.h"
+#include "runtime/data.h"
 
 #include "streaming_buffer.h"
 #include "type.h"
@@ -26,8 +28,20 @@ namespace khaos
   class TextgenSystem
   {
   public:
+    TextgenSystem() = default;
+
+    TextgenSystem(const TextgenSystem&)                    = delete;
+    TextgenSystem(TextgenSystem&&)                         = delete;
+    auto operator=(const TextgenSystem&) -> TextgenSystem& = delete;
+    auto operator=(TextgenSystem&&) -> TextgenSystem&      = delete;
+
+    ~TextgenSystem();
+
     void on_new_frame();
 
+    // Abort the running request after its current token and drop the queued tasks
+    void cancel();
+
     void push_task(OwnRef<TextgenTask> task);
 
     auto is_any_pending_response() const -> b8;
@@ -37,8 +51,10 @@ namespace khaos
     void consume(NotNull<String*> dst);
 
   private:
-    std::thread thread_;
-    std::atomic_bool is_task_running_ = false;
+    auto is_task_running() const -> b8;
+
+    Option<runtime::BackgroundTaskID> background_task_id_;
+    std::atomic_bool is_cancel_requested_ = false;
     StreamingBuffer streaming_buffer_;
     Deque<TextgenTask> textgen_task_queue_;
     Option<TextgenTask> active_task_;
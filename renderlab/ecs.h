@@ -2,6 +2,7 @@
 
 #include <limits>
 
+#include "core/architecture.h"
 #include "core/boolean.h"
 #include "core/builtins.h"
 #include "core/compiler.h"
@@ -261,7 +262,13 @@ namespace renderlab
 
     Vector<Metadata> metadatas_;
     Deque<u64> free_indices_;
-    SoaVector<EntityStructure> entities_;
+    // NOTE(kevinyu): Cache line aligned columns, so the transform columns can be processed with
+    // aligned SIMD loads and uploaded without sharing a cache line with another column.
+    SoaVector<
+      EntityStructure,
+      soul::memory::Allocator,
+      soul::SoaVectorConfig{.column_alignment = soul::SOUL_CACHELINE_SIZE}>
+      entities_;
     Tuple<ComponentManager<ComponentTs>...> component_managers_;
     EntityId root_entity_;
 
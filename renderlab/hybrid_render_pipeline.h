@@ -64,14 +64,14 @@ namespace renderlab
     }
 
   public:
-    static constexpr CompStr gbuffer_node_name          = "GBuffer Generation Node"_str;
-    static constexpr CompStr deferred_shading_node_name = "Deferred Shading Node"_str;
-    static constexpr CompStr shadow_node_name           = "Shadow Node"_str;
-    static constexpr CompStr rtao_node_name             = "Rtao Node"_str;
-    static constexpr CompStr ddgi_node_name             = "Ddgi Node"_str;
-    static constexpr CompStr rt_reflection_node_name    = "Rt Reflection Node"_str;
-    static constexpr CompStr taa_node_name              = "Taa Node"_str;
-    static constexpr CompStr tone_map_node_name         = "Tone Map Node"_str;
+    static inline const StringId gbuffer_node_name          = "GBuffer Generation Node"_sid;
+    static inline const StringId deferred_shading_node_name = "Deferred Shading Node"_sid;
+    static inline const StringId shadow_node_name           = "Shadow Node"_sid;
+    static inline const StringId rtao_node_name             = "Rtao Node"_sid;
+    static inline const StringId ddgi_node_name             = "Ddgi Node"_sid;
+    static inline const StringId rt_reflection_node_name    = "Rt Reflection Node"_sid;
+    static inline const StringId taa_node_name              = "Taa Node"_sid;
+    static inline const StringId tone_map_node_name         = "Tone Map Node"_sid;
 
     static auto Create(NotNull<Scene*> scene) -> RenderPipeline
     {
@@ -155,56 +155,56 @@ namespace renderlab
         UNIT_CUBE_INDICES);
 
       render_pipeline.generate_node(
-        String::From(gbuffer_node_name),
+        gbuffer_node_name,
         [&]
         {
           return GBufferGenerateNode(gpu_system);
         });
 
       render_pipeline.generate_node(
-        String::From(shadow_node_name),
+        shadow_node_name,
         [&]
         {
           return ShadowNode(gpu_system);
         });
 
       render_pipeline.generate_node(
-        String::From(rtao_node_name),
+        rtao_node_name,
         [&]
         {
           return RtaoNode(gpu_system);
         });
 
       render_pipeline.generate_node(
-        String::From(ddgi_node_name),
+        ddgi_node_name,
         [&]
         {
           return DdgiNode(gpu_system);
         });
 
       render_pipeline.generate_node(
-        String::From(rt_reflection_node_name),
+        rt_reflection_node_name,
         [&]
         {
           return RtReflectionNode(gpu_system);
         });
 
       render_pipeline.generate_node(
-        String::From(deferred_shading_node_name),
+        deferred_shading_node_name,
         [&]
         {
           return DeferredShadingNode(gpu_system);
         });
 
       render_pipeline.generate_node(
-        String::From(taa_node_name),
+        taa_node_name,
         [&]
         {
           return TaaNode(gpu_system);
         });
 
       render_pipeline.generate_node(
-        String::From(tone_map_node_name),
+        tone_map_node_name,
         [&]
         {
           return ToneMapNode(gpu_system);
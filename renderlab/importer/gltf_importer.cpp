@@ -554,9 +554,9 @@ namespace renderlab
   auto GLTFImporter::create_entity(const cgltf_node& src_node, ImportContext import_context)
     -> EntityId
   {
-    if (entity_map_.contains(&src_node))
+    if (const EntityId* cached_entity_id = entity_map_.find(&src_node); cached_entity_id != nullptr)
     {
-      return entity_map_[&src_node];
+      return *cached_entity_id;
     }
 
     const auto parent_entity_id = src_node.parent == nullptr
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/string.h"
+#include "core/string_id.h"
 #include "gpu/id.h"
 #include "gpu/render_graph.h"
 #include "scene.h"
@@ -21,8 +22,8 @@ namespace renderlab
 {
   struct RenderData
   {
-    HashMap<String, gpu::TextureNodeID> textures;
-    HashMap<String, gpu::BufferNodeID> buffers;
+    HashMap<StringId, gpu::TextureNodeID> textures;
+    HashMap<StringId, gpu::BufferNodeID> buffers;
 
     gpu::TextureNodeID overlay_texture = gpu::TextureNodeID();
   };
@@ -37,11 +38,11 @@ namespace renderlab
   {
     // TODO(kevinyu) : Implement iterable HashMap and use that instead of having separate vector for
     // names
-    HashMap<String, gpu::TextureID> textures;
-    Vector<String> texture_names;
+    HashMap<StringId, gpu::TextureID> textures;
+    Vector<StringId> texture_names;
 
-    HashMap<String, gpu::BufferID> buffers;
-    Vector<String> buffer_names;
+    HashMap<StringId, gpu::BufferID> buffers;
+    Vector<StringId> buffer_names;
   };
 
   struct RenderNodeField
@@ -53,17 +54,17 @@ namespace renderlab
       COUNT
     };
 
-    CompStr name;
+    StringId name;
     Type type;
 
     [[nodiscard]]
-    static constexpr auto Texture2D(CompStr name) -> RenderNodeField
+    static constexpr auto Texture2D(StringId name) -> RenderNodeField
     {
       return {name, Type::TEXTURE_2D};
     }
 
     [[nodiscard]]
-    static constexpr auto Buffer(CompStr name) -> RenderNodeField
+    static constexpr auto Buffer(StringId name) -> RenderNodeField
     {
       return {name, Type::BUFFER};
     }
@@ -403,8 +403,7 @@ namespace renderlab
     frame_counter_++;
 
     RenderData outputs;
-    outputs.textures.insert(
-      String::From(OUTPUT), sample_irradiance_node.get_parameter().output_texture);
+    outputs.textures.insert(OUTPUT, sample_irradiance_node.get_parameter().output_texture);
 
     if (!show_overlay_)
     {
@@ -594,8 +593,7 @@ namespace renderlab
         });
       });
 
-    outputs.textures.insert(
-      String::From(OUTPUT), sample_irradiance_node.get_parameter().output_texture);
+    outputs.textures.insert(OUTPUT, sample_irradiance_node.get_parameter().output_texture);
     outputs.overlay_texture = ray_overlay_pass.get_color_attachment_node_id(0);
     return outputs;
   } // namespace renderlab
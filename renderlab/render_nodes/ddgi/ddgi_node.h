@@ -67,17 +67,17 @@ namespace renderlab
     b8 probe_placement_dirty_;
 
   public:
-    static constexpr auto NORMAL_ROUGHNESS_INPUT = "normal_roughness"_str;
-    static constexpr auto DEPTH_INPUT            = "depth"_str;
+    static inline const auto NORMAL_ROUGHNESS_INPUT = "normal_roughness"_sid;
+    static inline const auto DEPTH_INPUT            = "depth"_sid;
 
-    static constexpr auto OUTPUT = "output"_str;
+    static inline const auto OUTPUT = "output"_sid;
 
-    static constexpr auto INPUT_FIELDS = Array{
+    static inline const auto INPUT_FIELDS = Array{
       RenderNodeField::Texture2D(NORMAL_ROUGHNESS_INPUT),
       RenderNodeField::Texture2D(DEPTH_INPUT),
     };
 
-    static constexpr auto OUTPUT_FIELDS = Array{
+    static inline const auto OUTPUT_FIELDS = Array{
       RenderNodeField::Texture2D(OUTPUT),
     };
 
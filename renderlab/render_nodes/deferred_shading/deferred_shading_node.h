@@ -28,19 +28,19 @@ namespace renderlab
     f32 indirect_specular_intensity_ = 1.0f;
 
   public:
-    static constexpr auto OUTPUT = "output"_str;
-
-    static constexpr auto LIGHT_VISIBILITY_INPUT  = "light_visibility"_str;
-    static constexpr auto AO_INPUT                = "ao_input"_str;
-    static constexpr auto ALBEDO_METALLIC_INPUT   = "albedo_metallic"_str;
-    static constexpr auto NORMAL_ROUGHNESS_INPUT  = "normal_roughness"_str;
-    static constexpr auto MOTION_CURVE_INPUT      = "motion_curve"_str;
-    static constexpr auto EMISSIVE_INPUT          = "emissive_input"_str;
-    static constexpr auto DEPTH_INPUT             = "depth"_str;
-    static constexpr auto INDIRECT_DIFFUSE_INPUT  = "indirect_diffuse"_str;
-    static constexpr auto INDIRECT_SPECULAR_INPUT = "indirect_specular"_str;
-
-    static constexpr auto INPUT_FIELDS = Array{
+    static inline const auto OUTPUT = "output"_sid;
+
+    static inline const auto LIGHT_VISIBILITY_INPUT  = "light_visibility"_sid;
+    static inline const auto AO_INPUT                = "ao_input"_sid;
+    static inline const auto ALBEDO_METALLIC_INPUT   = "albedo_metallic"_sid;
+    static inline const auto NORMAL_ROUGHNESS_INPUT  = "normal_roughness"_sid;
+    static inline const auto MOTION_CURVE_INPUT      = "motion_curve"_sid;
+    static inline const auto EMISSIVE_INPUT          = "emissive_input"_sid;
+    static inline const auto DEPTH_INPUT             = "depth"_sid;
+    static inline const auto INDIRECT_DIFFUSE_INPUT  = "indirect_diffuse"_sid;
+    static inline const auto INDIRECT_SPECULAR_INPUT = "indirect_specular"_sid;
+
+    static inline const auto INPUT_FIELDS = Array{
       RenderNodeField::Texture2D(LIGHT_VISIBILITY_INPUT),
       RenderNodeField::Texture2D(AO_INPUT),
       RenderNodeField::Texture2D(ALBEDO_METALLIC_INPUT),
@@ -51,7 +51,7 @@ namespace renderlab
       RenderNodeField::Texture2D(INDIRECT_SPECULAR_INPUT),
     };
 
-    static constexpr auto OUTPUT_FIELDS = Array{
+    static inline const auto OUTPUT_FIELDS = Array{
       RenderNodeField::Texture2D(OUTPUT),
     };
 
@@ -156,18 +156,17 @@ namespace renderlab
       render_graph, "GBuffer Store Previous GBuffer Pass"_str, store_previous_pass.cspan());
 
     RenderData outputs;
-    outputs.textures.insert(String(GBUFFER_ALBEDO_METAL), pass.get_color_attachment_node_id(0));
-    outputs.textures.insert(String(GBUFFER_NORMAL_ROUGHNESS), pass.get_color_attachment_node_id(1));
-    outputs.textures.insert(String(GBUFFER_MOTION_CURVE), pass.get_color_attachment_node_id(2));
-    outputs.textures.insert(String(GBUFFER_MESHID), pass.get_color_attachment_node_id(3));
-    outputs.textures.insert(String(GBUFFER_EMISSIVE), pass.get_color_attachment_node_id(4));
-    outputs.textures.insert(String(GBUFFER_DEPTH), pass.get_depth_stencil_attachment_node_id());
-
-    outputs.textures.insert(
-      String(PREV_GBUFFER_NORMAL_ROUGHNESS), prev_normal_roughness_gbuffers_node);
-    outputs.textures.insert(String(PREV_GBUFFER_MOTION_CURVE), prev_motion_curve_gbuffers_node);
-    outputs.textures.insert(String(PREV_GBUFFER_MESHID), prev_meshid_gbuffers_node);
-    outputs.textures.insert(String(PREV_GBUFFER_DEPTH), prev_depth_gbuffers_node);
+    outputs.textures.insert(GBUFFER_ALBEDO_METAL, pass.get_color_attachment_node_id(0));
+    outputs.textures.insert(GBUFFER_NORMAL_ROUGHNESS, pass.get_color_attachment_node_id(1));
+    outputs.textures.insert(GBUFFER_MOTION_CURVE, pass.get_color_attachment_node_id(2));
+    outputs.textures.insert(GBUFFER_MESHID, pass.get_color_attachment_node_id(3));
+    outputs.textures.insert(GBUFFER_EMISSIVE, pass.get_color_attachment_node_id(4));
+    outputs.textures.insert(GBUFFER_DEPTH, pass.get_depth_stencil_attachment_node_id());
+
+    outputs.textures.insert(PREV_GBUFFER_NORMAL_ROUGHNESS, prev_normal_roughness_gbuffers_node);
+    outputs.textures.insert(PREV_GBUFFER_MOTION_CURVE, prev_motion_curve_gbuffers_node);
+    outputs.textures.insert(PREV_GBUFFER_MESHID, prev_meshid_gbuffers_node);
+    outputs.textures.insert(PREV_GBUFFER_DEPTH, prev_depth_gbuffers_node);
     return outputs;
   } // namespace renderlab
 
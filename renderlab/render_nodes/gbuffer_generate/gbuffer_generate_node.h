@@ -31,19 +31,19 @@ namespace renderlab
     vec2u32 viewport_ = {0, 0};
 
   public:
-    static constexpr auto PREV_GBUFFER_NORMAL_ROUGHNESS = "prev_gbuffer_normal_roughness"_str;
-    static constexpr auto PREV_GBUFFER_MOTION_CURVE     = "prev_gbuffer_motion_curve"_str;
-    static constexpr auto PREV_GBUFFER_MESHID           = "prev_gbuffer_mesh_id"_str;
-    static constexpr auto PREV_GBUFFER_DEPTH            = "prev_gbuffer_depth"_str;
-
-    static constexpr auto GBUFFER_ALBEDO_METAL     = "gbuffer_albedo_metal"_str;
-    static constexpr auto GBUFFER_EMISSIVE         = "gbuffer_emissive"_str;
-    static constexpr auto GBUFFER_NORMAL_ROUGHNESS = "gbuffer_normal_roughness"_str;
-    static constexpr auto GBUFFER_MOTION_CURVE     = "gbuffer_motion_curve"_str;
-    static constexpr auto GBUFFER_MESHID           = "gbuffer_mesh_id"_str;
-    static constexpr auto GBUFFER_DEPTH            = "gbuffer_depth"_str;
-
-    static constexpr auto OUTPUT_FIELDS = Array{
+    static inline const auto PREV_GBUFFER_NORMAL_ROUGHNESS = "prev_gbuffer_normal_roughness"_sid;
+    static inline const auto PREV_GBUFFER_MOTION_CURVE     = "prev_gbuffer_motion_curve"_sid;
+    static inline const auto PREV_GBUFFER_MESHID           = "prev_gbuffer_mesh_id"_sid;
+    static inline const auto PREV_GBUFFER_DEPTH            = "prev_gbuffer_depth"_sid;
+
+    static inline const auto GBUFFER_ALBEDO_METAL     = "gbuffer_albedo_metal"_sid;
+    static inline const auto GBUFFER_EMISSIVE         = "gbuffer_emissive"_sid;
+    static inline const auto GBUFFER_NORMAL_ROUGHNESS = "gbuffer_normal_roughness"_sid;
+    static inline const auto GBUFFER_MOTION_CURVE     = "gbuffer_motion_curve"_sid;
+    static inline const auto GBUFFER_MESHID           = "gbuffer_mesh_id"_sid;
+    static inline const auto GBUFFER_DEPTH            = "gbuffer_depth"_sid;
+
+    static inline const auto OUTPUT_FIELDS = Array{
       RenderNodeField::Texture2D(PREV_GBUFFER_NORMAL_ROUGHNESS),
       RenderNodeField::Texture2D(PREV_GBUFFER_MOTION_CURVE),
       RenderNodeField::Texture2D(PREV_GBUFFER_MESHID),
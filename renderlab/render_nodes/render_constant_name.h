@@ -1,6 +1,6 @@
 #pragma once
 
-#include "core/comp_str.h"
+#include "core/string_id.h"
 
 using namespace soul;
 
@@ -8,14 +8,14 @@ namespace renderlab
 {
   struct RenderConstantName
   {
-    static constexpr CompStr SOBOL_TEXTURE    = "sobol"_str;
-    static constexpr CompStr SCRAMBLE_TEXTURE = "scramble"_str;
-    static constexpr CompStr BRDF_LUT_TEXTURE = "brdf_lut"_str;
+    static inline const StringId SOBOL_TEXTURE    = "sobol"_sid;
+    static inline const StringId SCRAMBLE_TEXTURE = "scramble"_sid;
+    static inline const StringId BRDF_LUT_TEXTURE = "brdf_lut"_sid;
 
-    static constexpr CompStr QUAD_VERTEX_BUFFER = "quad_vertex_buffer"_str;
-    static constexpr CompStr QUAD_INDEX_BUFFER  = "quad_index_buffer"_str;
+    static inline const StringId QUAD_VERTEX_BUFFER = "quad_vertex_buffer"_sid;
+    static inline const StringId QUAD_INDEX_BUFFER  = "quad_index_buffer"_sid;
 
-    static constexpr CompStr UNIT_CUBE_VERTEX_BUFFER = "unit_cube_vertex_buffer"_str;
-    static constexpr CompStr UNIT_CUBE_INDEX_BUFFER  = "unit_cube_index_buffer"_str;
+    static inline const StringId UNIT_CUBE_VERTEX_BUFFER = "unit_cube_vertex_buffer"_sid;
+    static inline const StringId UNIT_CUBE_INDEX_BUFFER  = "unit_cube_index_buffer"_sid;
   };
 } // namespace renderlab
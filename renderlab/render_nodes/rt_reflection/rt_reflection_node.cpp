@@ -454,14 +454,13 @@ namespace renderlab
     }
 
     RenderData outputs;
-    outputs.textures.insert(String::From(OUTPUT), atrous_input);
+    outputs.textures.insert(OUTPUT, atrous_input);
+    outputs.textures.insert(RAY_TRACE_OUTPUT, ray_trace_node.get_parameter().output_texture);
     outputs.textures.insert(
-      String::From(RAY_TRACE_OUTPUT), ray_trace_node.get_parameter().output_texture);
-    outputs.textures.insert(
-      String::From(TEMPORAL_ACCUMULATION_OUTPUT),
+      TEMPORAL_ACCUMULATION_OUTPUT,
       temporal_accumulation_pass.get_parameter().output_color_variance_texture);
     outputs.textures.insert(
-      String::From(TEMPORAL_ACCUMULATION_MOMENT_OUTPUT),
+      TEMPORAL_ACCUMULATION_MOMENT_OUTPUT,
       temporal_accumulation_pass.get_parameter().output_moment_length_texture);
     return outputs;
   }
@@ -45,22 +45,22 @@ namespace renderlab
     f32 lobe_trim          = 0.8f;
 
   public:
-    static constexpr auto PREV_GBUFFER_NORMAL_ROUGHNESS_INPUT = "prev_normal_roughness"_str;
-    static constexpr auto PREV_GBUFFER_MOTION_CURVE_INPUT     = "prev_motion_curve"_str;
-    static constexpr auto PREV_GBUFFER_MESHID_INPUT           = "prev_meshid"_str;
-    static constexpr auto PREV_GBUFFER_DEPTH_INPUT            = "prev_depth"_str;
-    static constexpr auto GBUFFER_NORMAL_ROUGHNESS_INPUT      = "normal_roughness"_str;
-    static constexpr auto GBUFFER_MOTION_CURVE_INPUT          = "motion_curve"_str;
-    static constexpr auto GBUFFER_MESHID_INPUT                = "meshid"_str;
-    static constexpr auto GBUFFER_DEPTH_INPUT                 = "depth"_str;
-
-    static constexpr auto OUTPUT                       = "output"_str;
-    static constexpr auto RAY_TRACE_OUTPUT             = "ray_trace_output"_str;
-    static constexpr auto TEMPORAL_ACCUMULATION_OUTPUT = "temporal_accumulation_output"_str;
-    static constexpr auto TEMPORAL_ACCUMULATION_MOMENT_OUTPUT =
-      "temporal_accumulation_moment_output"_str;
-
-    static constexpr auto INPUT_FIELDS = Array{
+    static inline const auto PREV_GBUFFER_NORMAL_ROUGHNESS_INPUT = "prev_normal_roughness"_sid;
+    static inline const auto PREV_GBUFFER_MOTION_CURVE_INPUT     = "prev_motion_curve"_sid;
+    static inline const auto PREV_GBUFFER_MESHID_INPUT           = "prev_meshid"_sid;
+    static inline const auto PREV_GBUFFER_DEPTH_INPUT            = "prev_depth"_sid;
+    static inline const auto GBUFFER_NORMAL_ROUGHNESS_INPUT      = "normal_roughness"_sid;
+    static inline const auto GBUFFER_MOTION_CURVE_INPUT          = "motion_curve"_sid;
+    static inline const auto GBUFFER_MESHID_INPUT                = "meshid"_sid;
+    static inline const auto GBUFFER_DEPTH_INPUT                 = "depth"_sid;
+
+    static inline const auto OUTPUT                       = "output"_sid;
+    static inline const auto RAY_TRACE_OUTPUT             = "ray_trace_output"_sid;
+    static inline const auto TEMPORAL_ACCUMULATION_OUTPUT = "temporal_accumulation_output"_sid;
+    static inline const auto TEMPORAL_ACCUMULATION_MOMENT_OUTPUT =
+      "temporal_accumulation_moment_output"_sid;
+
+    static inline const auto INPUT_FIELDS = Array{
       RenderNodeField::Texture2D(PREV_GBUFFER_NORMAL_ROUGHNESS_INPUT),
       RenderNodeField::Texture2D(PREV_GBUFFER_MOTION_CURVE_INPUT),
       RenderNodeField::Texture2D(PREV_GBUFFER_MESHID_INPUT),
@@ -72,7 +72,7 @@ namespace renderlab
       RenderNodeField::Texture2D(GBUFFER_DEPTH_INPUT),
     };
 
-    static constexpr auto OUTPUT_FIELDS = Array{
+    static inline const auto OUTPUT_FIELDS = Array{
       RenderNodeField::Texture2D(OUTPUT),
       RenderNodeField::Texture2D(RAY_TRACE_OUTPUT),
       RenderNodeField::Texture2D(TEMPORAL_ACCUMULATION_OUTPUT),
@@ -399,9 +399,9 @@ namespace renderlab
     feedback_ao_texture_node = vertical_blur_pass.get_parameter().output_texture;
 
     RenderData outputs;
-    outputs.textures.insert(String::From(OUTPUT), feedback_ao_texture_node);
+    outputs.textures.insert(OUTPUT, feedback_ao_texture_node);
     outputs.textures.insert(
-      String::From(HISTORY_LENGTH_OUTPUT),
+      HISTORY_LENGTH_OUTPUT,
       temporal_accumulation_pass.get_parameter().output_history_length_texture);
     return outputs;
   }
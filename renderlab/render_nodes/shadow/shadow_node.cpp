@@ -431,11 +431,11 @@ namespace renderlab
     }
 
     RenderData outputs;
-    outputs.textures.insert(String::From(OUTPUT), atrous_input);
+    outputs.textures.insert(OUTPUT, atrous_input);
     outputs.textures.insert(
-      String::From(TEMPORAL_ACCUMULATION_COLOR_OUTPUT), temporal_denoise_output_texture_node);
+      TEMPORAL_ACCUMULATION_COLOR_OUTPUT, temporal_denoise_output_texture_node);
     outputs.textures.insert(
-      String::From(TEMPORAL_ACCUMULATION_MOMENT_OUTPUT),
+      TEMPORAL_ACCUMULATION_MOMENT_OUTPUT,
       temporal_denoise_pass.get_parameter().output_moment_length_texture);
     return outputs;
   }
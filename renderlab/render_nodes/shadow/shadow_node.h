@@ -43,22 +43,23 @@ namespace renderlab
     i32 feedback_iteration = 1;
 
   public:
-    static constexpr auto OUTPUT                             = "output"_str;
-    static constexpr auto TEMPORAL_ACCUMULATION_COLOR_OUTPUT = "temporal_accumulation_output"_str;
-    static constexpr auto TEMPORAL_ACCUMULATION_MOMENT_OUTPUT =
-      "temporal_accumulation_moment_output"_str;
-
-    static constexpr auto PREV_GBUFFER_NORMAL_ROUGHNESS_INPUT = "prev_normal_roughness"_str;
-    static constexpr auto PREV_GBUFFER_MOTION_CURVE_INPUT     = "prev_motion_curve"_str;
-    static constexpr auto PREV_GBUFFER_MESHID_INPUT           = "prev_meshid"_str;
-    static constexpr auto PREV_GBUFFER_DEPTH_INPUT            = "prev_depth"_str;
-
-    static constexpr auto GBUFFER_NORMAL_ROUGHNESS_INPUT = "normal_roughness"_str;
-    static constexpr auto GBUFFER_MOTION_CURVE_INPUT     = "motion_curve"_str;
-    static constexpr auto GBUFFER_MESHID_INPUT           = "meshid"_str;
-    static constexpr auto GBUFFER_DEPTH_INPUT            = "depth"_str;
-
-    static constexpr auto INPUT_FIELDS = Array{
+    static inline const auto OUTPUT = "output"_sid;
+    static inline const auto TEMPORAL_ACCUMULATION_COLOR_OUTPUT =
+      "temporal_accumulation_output"_sid;
+    static inline const auto TEMPORAL_ACCUMULATION_MOMENT_OUTPUT =
+      "temporal_accumulation_moment_output"_sid;
+
+    static inline const auto PREV_GBUFFER_NORMAL_ROUGHNESS_INPUT = "prev_normal_roughness"_sid;
+    static inline const auto PREV_GBUFFER_MOTION_CURVE_INPUT     = "prev_motion_curve"_sid;
+    static inline const auto PREV_GBUFFER_MESHID_INPUT           = "prev_meshid"_sid;
+    static inline const auto PREV_GBUFFER_DEPTH_INPUT            = "prev_depth"_sid;
+
+    static inline const auto GBUFFER_NORMAL_ROUGHNESS_INPUT = "normal_roughness"_sid;
+    static inline const auto GBUFFER_MOTION_CURVE_INPUT     = "motion_curve"_sid;
+    static inline const auto GBUFFER_MESHID_INPUT           = "meshid"_sid;
+    static inline const auto GBUFFER_DEPTH_INPUT            = "depth"_sid;
+
+    static inline const auto INPUT_FIELDS = Array{
       RenderNodeField::Texture2D(PREV_GBUFFER_NORMAL_ROUGHNESS_INPUT),
       RenderNodeField::Texture2D(PREV_GBUFFER_MOTION_CURVE_INPUT),
       RenderNodeField::Texture2D(PREV_GBUFFER_MESHID_INPUT),
@@ -69,7 +70,7 @@ namespace renderlab
       RenderNodeField::Texture2D(GBUFFER_DEPTH_INPUT),
     };
 
-    static constexpr auto OUTPUT_FIELDS = Array{
+    static inline const auto OUTPUT_FIELDS = Array{
       RenderNodeField::Texture2D(OUTPUT),
       RenderNodeField::Texture2D(TEMPORAL_ACCUMULATION_COLOR_OUTPUT),
       RenderNodeField::Texture2D(TEMPORAL_ACCUMULATION_MOMENT_OUTPUT),
@@ -34,7 +34,7 @@ namespace renderlab
     if (!enable_pass_)
     {
       RenderData outputs;
-      outputs.textures.insert(String::From(OUTPUT), inputs.textures[COLOR_INPUT]);
+      outputs.textures.insert(OUTPUT, inputs.textures[COLOR_INPUT]);
       return outputs;
     }
     const auto viewport = scene.get_viewport();
@@ -99,8 +99,8 @@ namespace renderlab
       });
 
     RenderData outputs;
-    outputs.textures.insert(String::From(OUTPUT), compute_pass.get_parameter().output_texture);
-    outputs.textures.insert(String::From(HISTORY_OUTPUT), history_color_texture_node);
+    outputs.textures.insert(OUTPUT, compute_pass.get_parameter().output_texture);
+    outputs.textures.insert(HISTORY_OUTPUT, history_color_texture_node);
     return outputs;
   }
 
@@ -36,22 +36,22 @@ namespace renderlab
     bool dilation_enable_ = true;
 
   public:
-    static constexpr auto COLOR_INPUT                = "color"_str;
-    static constexpr auto DEPTH_INPUT                = "depth"_str;
-    static constexpr auto GBUFFER_MOTION_CURVE_INPUT = "motion_curve"_str;
-    static constexpr auto GBUFFER_DEPTH_INPUT        = "depth"_str;
+    static inline const auto COLOR_INPUT                = "color"_sid;
+    static inline const auto DEPTH_INPUT                = "depth"_sid;
+    static inline const auto GBUFFER_MOTION_CURVE_INPUT = "motion_curve"_sid;
+    static inline const auto GBUFFER_DEPTH_INPUT        = "depth"_sid;
 
-    static constexpr auto OUTPUT         = "output"_str;
-    static constexpr auto HISTORY_OUTPUT = "history_output"_str;
+    static inline const auto OUTPUT         = "output"_sid;
+    static inline const auto HISTORY_OUTPUT = "history_output"_sid;
 
-    static constexpr auto INPUT_FIELDS = Array{
+    static inline const auto INPUT_FIELDS = Array{
       RenderNodeField::Texture2D(COLOR_INPUT),
       RenderNodeField::Texture2D(DEPTH_INPUT),
       RenderNodeField::Texture2D(GBUFFER_MOTION_CURVE_INPUT),
       RenderNodeField::Texture2D(GBUFFER_DEPTH_INPUT),
     };
 
-    static constexpr auto OUTPUT_FIELDS = Array{
+    static inline const auto OUTPUT_FIELDS = Array{
       RenderNodeField::Texture2D(OUTPUT),
       RenderNodeField::Texture2D(HISTORY_OUTPUT),
     };
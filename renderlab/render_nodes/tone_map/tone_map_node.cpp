@@ -76,7 +76,7 @@ namespace renderlab
       });
 
     RenderData outputs;
-    outputs.textures.insert(String::From(OUTPUT), compute_pass.get_parameter().output_texture);
+    outputs.textures.insert(OUTPUT, compute_pass.get_parameter().output_texture);
     return outputs;
   }
 
@@ -27,14 +27,14 @@ namespace renderlab
     gpu::ProgramID program_id_;
 
   public:
-    static constexpr auto INPUT  = "input"_str;
-    static constexpr auto OUTPUT = "output"_str;
+    static inline const auto INPUT  = "input"_sid;
+    static inline const auto OUTPUT = "output"_sid;
 
-    static constexpr auto INPUT_FIELDS = Array{
+    static inline const auto INPUT_FIELDS = Array{
       RenderNodeField::Texture2D(INPUT),
     };
 
-    static constexpr auto OUTPUT_FIELDS = Array{
+    static inline const auto OUTPUT_FIELDS = Array{
       RenderNodeField::Texture2D(OUTPUT),
     };
 
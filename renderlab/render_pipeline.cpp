@@ -40,7 +40,7 @@ namespace renderlab
     }
   }
 
-  void RenderPipeline::create_constant_texture(String&& name, const ImageData& image_data, b8 srgb)
+  void RenderPipeline::create_constant_texture(StringId name, const ImageData& image_data, b8 srgb)
   {
     const gpu::TextureFormat format = [&]
     {
@@ -85,31 +85,32 @@ namespace renderlab
       .generate_mipmap = false,
     };
 
-    create_constant_texture(std::move(name), texture_desc, load_desc);
+    create_constant_texture(name, texture_desc, load_desc);
   }
 
   void RenderPipeline::create_constant_texture(
-    String&& name, const gpu::TextureDesc& desc, const gpu::TextureLoadDesc& load_desc)
+    StringId name, const gpu::TextureDesc& desc, const gpu::TextureLoadDesc& load_desc)
   {
-    const auto texture_id = gpu_system_->create_texture(name.clone(), desc, load_desc);
+    const auto texture_id =
+      gpu_system_->create_texture(String::From(name.cview()), desc, load_desc);
     gpu_system_->flush_texture(texture_id, desc.usage_flags);
 
-    render_constant_.texture_names.push_back(name.clone());
-    render_constant_.textures.insert(std::move(name), texture_id);
+    render_constant_.texture_names.push_back(name);
+    render_constant_.textures.insert(name, texture_id);
   }
 
   void RenderPipeline::create_constant_buffer(
-    String&& name, const gpu::BufferDesc& desc, const void* data)
+    StringId name, const gpu::BufferDesc& desc, const void* data)
   {
-    const auto buffer_id = gpu_system_->create_buffer(name.clone(), desc, data);
+    const auto buffer_id = gpu_system_->create_buffer(String::From(name.cview()), desc, data);
     gpu_system_->flush_buffer(buffer_id);
 
-    render_constant_.buffer_names.push_back(name.clone());
-    render_constant_.buffers.insert(std::move(name), buffer_id);
+    render_constant_.buffer_names.push_back(name);
+    render_constant_.buffers.insert(name, buffer_id);
   }
 
   void RenderPipeline::add_texture_edge(
-    StringView src_node, StringView src_channel, StringView dst_node, StringView dst_channel)
+    StringId src_node, StringId src_channel, StringId dst_node, StringId dst_channel)
   {
     SOUL_ASSERT(0, name_to_node_index_.contains(src_node));
     SOUL_ASSERT(0, name_to_node_index_.contains(dst_node));
@@ -117,14 +118,14 @@ namespace renderlab
     const auto dst_node_index = name_to_node_index_[dst_node];
     SOUL_ASSERT(0, src_node_index < dst_node_index);
     render_node_contexts_[dst_node_index].input_textures.push_back(RenderNodeInput{
-      .channel_name     = String::From(dst_channel),
+      .channel_name     = dst_channel,
       .src_node_index   = src_node_index,
-      .src_channel_name = String::From(src_channel),
+      .src_channel_name = src_channel,
     });
   }
 
   void RenderPipeline::add_buffer_edge(
-    StringView src_node, StringView src_channel, StringView dst_node, StringView dst_channel)
+    StringId src_node, StringId src_channel, StringId dst_node, StringId dst_channel)
   {
     SOUL_ASSERT(0, name_to_node_index_.contains(src_node));
     SOUL_ASSERT(0, name_to_node_index_.contains(dst_node));
@@ -132,16 +133,16 @@ namespace renderlab
     const auto dst_node_index = name_to_node_index_[dst_node];
     SOUL_ASSERT(0, src_node_index < dst_node_index);
     render_node_contexts_[dst_node_index].input_buffers.push_back(RenderNodeInput{
-      .channel_name     = String::From(dst_channel),
+      .channel_name     = dst_channel,
       .src_node_index   = src_node_index,
-      .src_channel_name = String::From(src_channel),
+      .src_channel_name = src_channel,
     });
   }
 
-  void RenderPipeline::set_output(StringView node_name, StringView channel_name)
+  void RenderPipeline::set_output(StringId node_name, StringId channel_name)
   {
     selected_node_idx_   = name_to_node_index_[node_name];
-    selected_field_name_ = String::From(channel_name);
+    selected_field_name_ = channel_name;
   }
 
   auto RenderPipeline::get_output() const -> gpu::TextureNodeID
@@ -171,13 +172,13 @@ namespace renderlab
       for (const auto& texture_input : context.input_textures)
       {
         inputs.textures.insert(
-          texture_input.channel_name.clone(),
+          texture_input.channel_name,
           node_outputs_[texture_input.src_node_index].textures[texture_input.src_channel_name]);
       }
       for (const auto& buffer_input : context.input_buffers)
       {
         inputs.buffers.insert(
-          buffer_input.channel_name.clone(),
+          buffer_input.channel_name,
           node_outputs_[buffer_input.src_node_index].buffers[buffer_input.src_channel_name]);
       }
       inputs.overlay_texture = overlay_texture_node;
@@ -201,8 +202,8 @@ namespace renderlab
       if (selected_node_idx_.is_some() && selected_field_name_.is_some())
       {
         const auto node_idx      = selected_node_idx_.unwrap();
-        const auto& channel_name = selected_field_name_.some_ref();
-        return node_outputs_[node_idx].textures[channel_name.cview()];
+        const auto channel_name  = selected_field_name_.some_ref();
+        return node_outputs_[node_idx].textures[channel_name];
       } else
       {
         return gpu::TextureNodeID();
@@ -324,14 +325,14 @@ namespace renderlab
       for (const RenderNodeField& field : selected_node->get_output_fields())
       {
         const b8 is_selected = selected_field_name_.is_some_and(
-          [&field](const String& name)
+          [&field](StringId name)
           {
             return name == field.name;
           });
 
-        if (gui->selectable(field.name, is_selected))
+        if (gui->selectable(field.name.cview(), is_selected))
         {
-          selected_field_name_ = String::From(field.name);
+          selected_field_name_ = field.name;
         }
         if (is_selected)
         {
@@ -2,6 +2,7 @@
 
 #include "core/config.h"
 #include "core/sbo_vector.h"
+#include "core/string_id.h"
 #include "core/type_traits.h"
 #include "core/vector.h"
 
@@ -33,7 +34,7 @@ namespace renderlab
   struct RenderNodeChannel
   {
     u32 node_index;
-    String name;
+    StringId name;
   };
 
   class RenderPipeline
@@ -41,15 +42,15 @@ namespace renderlab
   private:
     struct RenderNodeInput
     {
-      String channel_name;
+      StringId channel_name;
       u32 src_node_index;
-      String src_channel_name;
+      StringId src_channel_name;
     };
 
     struct RenderNodeContext
     {
       NotNull<RenderNode*> node;
-      String name;
+      StringId name;
       SBOVector<RenderNodeInput> input_textures = SBOVector<RenderNodeInput>();
       SBOVector<RenderNodeInput> input_buffers  = SBOVector<RenderNodeInput>();
     };
@@ -61,10 +62,10 @@ namespace renderlab
     Vector<String> render_constant_texture_names_;
     Vector<RenderNodeContext> render_node_contexts_;
     Vector<RenderData> node_outputs_;
-    HashMap<String, u32> name_to_node_index_;
+    HashMap<StringId, u32> name_to_node_index_;
 
     Option<u32> selected_node_idx_;
-    Option<String> selected_field_name_;
+    Option<StringId> selected_field_name_;
     PostProcessOption postprocess_option_;
     Array<ValueOption, 4> value_options_;
 
@@ -87,15 +88,15 @@ namespace renderlab
 
     template <ts_invocable Fn>
       requires(can_convert_v<invoke_result_t<Fn>*, RenderNode*>)
-    void generate_node(String&& name, Fn render_node_fn)
+    void generate_node(StringId name, Fn render_node_fn)
     {
       auto result_node = allocator_->generate(render_node_fn);
       render_node_contexts_.push_back(RenderNodeContext{
         .node = result_node.some_ref().get(),
-        .name = name.clone(),
+        .name = name,
       });
 
-      name_to_node_index_.insert(std::move(name), render_node_contexts_.size() - 1);
+      name_to_node_index_.insert(name, render_node_contexts_.size() - 1);
     }
 
     template <ts_fn<void, const RenderNode&, StringView> Fn>
@@ -107,25 +108,25 @@ namespace renderlab
       }
     }
 
-    void create_constant_texture(String&& name, const ImageData& image_data, b8 srgb);
+    void create_constant_texture(StringId name, const ImageData& image_data, b8 srgb);
 
     void create_constant_texture(
-      String&& name, const gpu::TextureDesc& desc, const gpu::TextureLoadDesc& load_desc);
+      StringId name, const gpu::TextureDesc& desc, const gpu::TextureLoadDesc& load_desc);
 
-    void create_constant_buffer(String&& name, const gpu::BufferDesc& desc, const void* data);
+    void create_constant_buffer(StringId name, const gpu::BufferDesc& desc, const void* data);
 
     void add_texture_edge(
-      StringView src_node, StringView src_channel, StringView dst_node, StringView dst_channel);
+      StringId src_node, StringId src_channel, StringId dst_node, StringId dst_channel);
 
     void add_buffer_edge(
-      StringView src_node, StringView src_channel, StringView dst_node, StringView dst_channel);
+      StringId src_node, StringId src_channel, StringId dst_node, StringId dst_channel);
 
-    void set_output(StringView node_name, StringView channel_name);
+    void set_output(StringId node_name, StringId channel_name);
 
     [[nodiscard]]
     auto get_output() const -> gpu::TextureNodeID;
 
-    auto get_node(StringView name) -> NotNull<RenderNode*>;
+    auto get_node(StringId name) -> NotNull<RenderNode*>;
 
     void submit_passes(NotNull<gpu::RenderGraph*> render_graph);
 
@@ -80,21 +80,25 @@ RuntimeInitializer::RuntimeInitializer(const soul::runtime::Config& config)
 };
 
 App::App(const AppConfig& app_config)
-    : malloc_allocator_("Default Allocator"_str),
+    : page_allocator_("Page allocator"_str),
+#if defined(SOUL_THREAD_CACHING_DEFAULT_ALLOCATOR)
+      default_backing_allocator_("Default Allocator"_str, &page_allocator_),
+#else
+      default_backing_allocator_("Default Allocator"_str),
+#endif
       default_allocator_(
-        &malloc_allocator_,
+        &default_backing_allocator_,
         runtime::DefaultAllocatorProxy::Config(
-          memory::MutexProxy::Config(),
           memory::ProfileProxy::Config(),
+          runtime::FrameAllocationProxy::Config(),
           memory::CounterProxy::Config(),
           memory::ClearValuesProxy::Config{u8{0xFA}, u8{0xFF}},
           memory::BoundGuardProxy::Config())),
-      page_allocator_("Page allocator"_str),
       proxy_page_allocator_(&page_allocator_, memory::ProfileProxy::Config()),
       linear_allocator_(
-        "Main Thread Temporary Allocator"_str, 10 * ONE_MEGABYTE, &proxy_page_allocator_),
+        "Main Thread Temporary Allocator"_str, ONE_GIGABYTE, &proxy_page_allocator_),
       temp_allocator_(&linear_allocator_, runtime::TempProxy::Config()),
-      runtime_initializer_({0, 4096, &temp_allocator_, 20 * ONE_MEGABYTE, &default_allocator_}),
+      runtime_initializer_({0, 4096, &temp_allocator_, ONE_GIGABYTE, &default_allocator_}),
       window_(init_glfw_and_create_window(app_config, &window_data_)),
       wsi_(default_allocator_.create<gpu::GLFWWsi>(window_).unwrap()),
       gpu_system_(default_allocator_.create<gpu::System>(&default_allocator_).unwrap()),
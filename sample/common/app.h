@@ -59,9 +59,9 @@ public:
   static auto get_media_path() -> soul::Path;
 
 private:
-  soul::memory::MallocAllocator malloc_allocator_;
-  soul::runtime::DefaultAllocator default_allocator_;
   soul::memory::PageAllocator page_allocator_;
+  soul::runtime::DefaultBackingAllocator default_backing_allocator_;
+  soul::runtime::DefaultAllocator default_allocator_;
   soul::memory::ProxyAllocator<soul::memory::PageAllocator, soul::memory::ProfileProxy>
     proxy_page_allocator_;
   soul::memory::LinearAllocator linear_allocator_;
@@ -6,22 +6,31 @@ namespace soul::app
 {
 
   AppRuntime::AppRuntime()
-      : malloc_allocator_("Default Allocator"_str),
+      : page_allocator_("Page allocator"_str),
+#if defined(SOUL_THREAD_CACHING_DEFAULT_ALLOCATOR)
+        default_backing_allocator_("Default Allocator"_str, &page_allocator_),
+#else
+        default_backing_allocator_("Default Allocator"_str),
+#endif
         default_allocator_(
-          &malloc_allocator_,
+          &default_backing_allocator_,
           runtime::DefaultAllocatorProxy::Config(
-            memory::MutexProxy::Config(),
             memory::ProfileProxy::Config(),
+            runtime::FrameAllocationProxy::Config(),
             memory::CounterProxy::Config(),
             memory::ClearValuesProxy::Config{u8{0xFA}, u8{0xFF}},
             memory::BoundGuardProxy::Config())),
-        page_allocator_("Page allocator"_str),
         proxy_page_allocator_(&page_allocator_, memory::ProfileProxy::Config()),
         linear_allocator_(
-          "Main Thread Temporary Allocator"_str, 10 * ONE_MEGABYTE, &proxy_page_allocator_),
-        temp_allocator_(&linear_allocator_, runtime::TempProxy::Config())
+          "Main Thread Temporary Allocator"_str, ONE_GIGABYTE, &proxy_page_allocator_),
+        temp_allocator_(&linear_allocator_, runtime::TempProxy::Config()),
+        render_graph_allocator_(
+          "Render Graph Allocator"_str,
+          &page_allocator_,
+          memory::SlabAllocator::Config{
+            .slab_size = 512 * ONE_KILOBYTE, .max_block_size = 64 * ONE_KILOBYTE})
   {
-    runtime::init({0, 4096, &temp_allocator_, 20 * ONE_MEGABYTE, &default_allocator_});
+    runtime::init({0, 4096, &temp_allocator_, ONE_GIGABYTE, &default_allocator_});
   }
 
   AppRuntime::~AppRuntime()
@@ -29,6 +38,11 @@ namespace soul::app
     runtime::shutdown();
   }
 
+  auto AppRuntime::render_graph_allocator_ref() -> memory::SlabAllocator&
+  {
+    return render_graph_allocator_;
+  }
+
   App::App(StringView name)
       : name_(String::From(name)),
         storage_path_(Path::From(""_str)),
@@ -83,7 +97,7 @@ namespace soul::app
     runtime::System::get().begin_frame();
     cpu_timer_.tick();
     gui_->begin_frame();
-    gpu::RenderGraph render_graph;
+    gpu::RenderGraph render_graph(&app_runtime_.render_graph_allocator_ref());
 
     const auto swapchain_texture_node_id =
       render_graph.import_texture("Swapchain Texture"_str, gpu_system_.get_swapchain_texture());
@@ -8,6 +8,7 @@
 #include "memory/allocators/malloc_allocator.h"
 #include "memory/allocators/page_allocator.h"
 #include "memory/allocators/proxy_allocator.h"
+#include "memory/allocators/slab_allocator.h"
 
 #include "runtime/runtime.h"
 
@@ -18,12 +19,13 @@ namespace soul::app
   class AppRuntime
   {
   private:
-    memory::MallocAllocator malloc_allocator_;
-    runtime::DefaultAllocator default_allocator_;
     memory::PageAllocator page_allocator_;
+    runtime::DefaultBackingAllocator default_backing_allocator_;
+    runtime::DefaultAllocator default_allocator_;
     memory::ProxyAllocator<memory::PageAllocator, memory::ProfileProxy> proxy_page_allocator_;
     memory::LinearAllocator linear_allocator_;
     runtime::TempAllocator temp_allocator_;
+    memory::SlabAllocator render_graph_allocator_;
 
   public:
     AppRuntime();
@@ -37,6 +39,16 @@ namespace soul::app
     auto operator=(AppRuntime&&) -> AppRuntime& = delete;
 
     ~AppRuntime();
+
+    /*
+      Hold the pass nodes and the node and resource arrays of the render graph built every frame.
+      The largest size class is 64 KB, so even big arrays are served from the slabs and never map
+      pages per allocation. The graph free everything when it is destroyed at the end of the frame
+      and the slabs are kept, so the steady state footprint is the slabs needed by the biggest
+      frame so far: at least one 512 KB slab per size class in use, at most 13 classes. Only the
+      touched pages of a slab are resident.
+    */
+    auto render_graph_allocator_ref() -> memory::SlabAllocator&;
   };
 
   class App : Window::Callbacks
@@ -339,9 +339,9 @@ namespace soul::app
 
     auto load_image(const Path& path) -> gpu::TextureID
     {
-      if (textures.contains(path))
+      if (const gpu::TextureID* texture_id = textures.find(path); texture_id != nullptr)
       {
-        return textures.ref(path);
+        return *texture_id;
       }
 
       auto image_data = soul::ImageData::FromFile(path);
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "core/architecture.h"
+#include "core/array.h"
+#include "core/config.h"
+#include "core/integer.h"
+#include "core/objops.h"
+#include "core/panic.h"
+#include "core/span.h"
+#include "core/tuple.h"
+#include "core/util.h"
+#include "core/vector.h"
+
+#include "memory/allocator.h"
+
+namespace soul
+{
+  // NOTE(kevinyu): Array of structure of arrays. Elements are stored in fixed size chunks, every
+  // chunk holds one cache line aligned column per structure member. Unlike SoaVector, growing
+  // never relocate existing elements, and chunks can be processed independently (e.g. with
+  // runtime::parallel_for_each()).
+  template <
+    ts_tuple TupleT,
+    usize ChunkSizeV                  = 64,
+    memory::allocator_type AllocatorT = memory::Allocator>
+  class AosoaVector;
+
+  template <usize ChunkSizeV, memory::allocator_type AllocatorT, typename... Ts>
+  class AosoaVector<Tuple<Ts...>, ChunkSizeV, AllocatorT>
+  {
+  public:
+    using structure_type = Tuple<Ts...>;
+
+    template <usize IndexV>
+    using type_at_t = structure_type::template type_at_t<IndexV>;
+
+    static constexpr auto ELEMENT_COUNT = structure_type::ELEMENT_COUNT;
+    static constexpr usize CHUNK_SIZE   = ChunkSizeV;
+
+    static constexpr auto COLUMN_ALIGNMENTS = Array<usize, ELEMENT_COUNT>::TransformIndex(
+      [](usize idx) -> usize
+      {
+        return std::max<usize>(SOUL_CACHELINE_SIZE, structure_type::ELEMENT_ALIGNMENTS[idx]);
+      });
+
+    static constexpr auto COLUMN_OFFSETS = []() -> Array<usize, ELEMENT_COUNT>
+    {
+      auto offsets = Array<usize, ELEMENT_COUNT>::Fill(0);
+      usize offset = 0;
+      for (usize i = 0; i < ELEMENT_COUNT; i++)
+      {
+        offsets[i] = align_up(offset, COLUMN_ALIGNMENTS[i]);
+        offset     = offsets[i] + structure_type::ELEMENT_SIZES[i] * CHUNK_SIZE;
+      }
+      return offsets;
+    }();
+
+    static constexpr usize CHUNK_ALIGNMENT = std::ranges::max(COLUMN_ALIGNMENTS);
+    static constexpr usize CHUNK_BYTE_SIZE =
+      COLUMN_OFFSETS[ELEMENT_COUNT - 1] +
+      structure_type::ELEMENT_SIZES[ELEMENT_COUNT - 1] * CHUNK_SIZE;
+
+    static_assert(CHUNK_SIZE != 0, "Chunk size cannot be zero");
+
+    template <b8 IsConstV>
+    class BasicChunk
+    {
+    public:
+      using byte_type = std::conditional_t<IsConstV, const byte, byte>;
+
+      template <usize IndexV>
+      using element_type = std::conditional_t<IsConstV, const type_at_t<IndexV>, type_at_t<IndexV>>;
+
+      BasicChunk(byte_type* data, usize size) : data_(data), size_(size) {}
+
+      template <usize StructureIndexV>
+      [[nodiscard]]
+      auto span() const -> Span<element_type<StructureIndexV>*>
+      {
+        return {AosoaVector::column<StructureIndexV>(data_), size_};
+      }
+
+      template <usize StructureIndexV>
+      [[nodiscard]]
+      auto ref(usize slot_index) const -> element_type<StructureIndexV>&
+      {
+        SOUL_ASSERT_UPPER_BOUND_CHECK(slot_index, size_);
+        return AosoaVector::column<StructureIndexV>(data_)[slot_index];
+      }
+
+      [[nodiscard]]
+      auto size() const -> usize
+      {
+        return size_;
+      }
+
+    private:
+      byte_type* data_;
+      usize size_;
+    };
+
+    using Chunk      = BasicChunk<false>;
+    using ConstChunk = BasicChunk<true>;
+
+  private:
+    NotNull<AllocatorT*> allocator_;
+    Vector<byte*, AllocatorT> chunks_;
+    usize size_ = 0;
+
+  public:
+    explicit AosoaVector(NotNull<AllocatorT*> allocator = get_default_allocator())
+        : allocator_(allocator), chunks_(allocator.get())
+    {
+    }
+
+    AosoaVector(const AosoaVector& other) = delete;
+
+    AosoaVector(AosoaVector&& other) noexcept
+        : allocator_(other.allocator_), chunks_(other.allocator_.get())
+    {
+      swap(other);
+    }
+
+    auto operator=(const AosoaVector& other) -> AosoaVector& = delete;
+
+    auto operator=(AosoaVector&& other) noexcept -> AosoaVector&
+    {
+      swap(other);
+      other.cleanup();
+      return *this;
+    }
+
+    ~AosoaVector()
+    {
+      cleanup();
+    }
+
+    void swap(AosoaVector& other) noexcept
+    {
+      using std::swap;
+      swap(allocator_, other.allocator_);
+      swap(chunks_, other.chunks_);
+      swap(size_, other.size_);
+    }
+
+    void push_back(OwnRef<Ts>... elements)
+    {
+      if (size_ == capacity())
+      {
+        void* chunk_addr = allocator_->allocate(CHUNK_BYTE_SIZE, CHUNK_ALIGNMENT);
+        chunks_.push_back(soul::cast<byte*>(chunk_addr));
+      }
+      byte* chunk            = chunks_[size_ / CHUNK_SIZE];
+      const usize slot_index = size_ % CHUNK_SIZE;
+      [&]<usize... IndexVs>(std::index_sequence<IndexVs...>)
+      {
+        (construct_at(column<IndexVs>(chunk) + slot_index, std::move(elements)), ...);
+      }(std::make_index_sequence<ELEMENT_COUNT>());
+      ++size_;
+    }
+
+    void pop_back()
+    {
+      SOUL_ASSERT(0, size_ != 0, "Cannot pop back an empty aosoa vector");
+      size_--;
+      destroy_element(size_);
+    }
+
+    void remove(usize index)
+    {
+      SOUL_ASSERT_UPPER_BOUND_CHECK(index, size_);
+      const usize last_index = size_ - 1;
+      if (index != last_index)
+      {
+        for_each_column(
+          [this, index, last_index]<usize IndexV>()
+          {
+            ref<IndexV>(index) = std::move(ref<IndexV>(last_index));
+          });
+      }
+      size_--;
+      destroy_element(size_);
+    }
+
+    void clear()
+    {
+      for (usize chunk_index = 0; chunk_index < chunk_count(); chunk_index++)
+      {
+        const usize chunk_size = get_chunk_size(chunk_index);
+        for_each_column(
+          [chunk = chunks_[chunk_index], chunk_size]<usize IndexV>()
+          {
+            destroy_n(column<IndexV>(chunk), chunk_size);
+          });
+      }
+      size_ = 0;
+    }
+
+    void cleanup()
+    {
+      clear();
+      for (byte* chunk : chunks_)
+      {
+        allocator_->deallocate(chunk);
+      }
+      chunks_.cleanup();
+    }
+
+    template <usize StructureIndexV>
+    [[nodiscard]]
+    auto ref(usize element_index) const -> const type_at_t<StructureIndexV>&
+    {
+      SOUL_ASSERT_UPPER_BOUND_CHECK(element_index, size_);
+      return column<StructureIndexV>(chunks_[element_index / CHUNK_SIZE])
+        [element_index % CHUNK_SIZE];
+    }
+
+    template <usize StructureIndexV>
+    [[nodiscard]]
+    auto ref(usize element_index) -> type_at_t<StructureIndexV>&
+    {
+      SOUL_ASSERT_UPPER_BOUND_CHECK(element_index, size_);
+      return column<StructureIndexV>(chunks_[element_index / CHUNK_SIZE])
+        [element_index % CHUNK_SIZE];
+    }
+
+    [[nodiscard]]
+    auto chunk_ref(usize chunk_index) -> Chunk
+    {
+      SOUL_ASSERT_UPPER_BOUND_CHECK(chunk_index, chunk_count());
+      return Chunk(chunks_[chunk_index], get_chunk_size(chunk_index));
+    }
+
+    [[nodiscard]]
+    auto chunk_ref(usize chunk_index) const -> ConstChunk
+    {
+      SOUL_ASSERT_UPPER_BOUND_CHECK(chunk_index, chunk_count());
+      return ConstChunk(chunks_[chunk_index], get_chunk_size(chunk_index));
+    }
+
+    template <typename Fn>
+    void for_each_chunk(Fn fn)
+    {
+      for (usize chunk_index = 0; chunk_index < chunk_count(); chunk_index++)
+      {
+        fn(chunk_ref(chunk_index));
+      }
+    }
+
+    template <typename Fn>
+    void for_each_chunk(Fn fn) const
+    {
+      for (usize chunk_index = 0; chunk_index < chunk_count(); chunk_index++)
+      {
+        fn(chunk_ref(chunk_index));
+      }
+    }
+
+    [[nodiscard]]
+    auto chunk_count() const -> usize
+    {
+      return (size_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    }
+
+    [[nodiscard]]
+    auto size() const -> usize
+    {
+      return size_;
+    }
+
+    [[nodiscard]]
+    auto capacity() const -> usize
+    {
+      return chunks_.size() * CHUNK_SIZE;
+    }
+
+    [[nodiscard]]
+    auto empty() const -> b8
+    {
+      return size_ == 0;
+    }
+
+  private:
+    template <usize StructureIndexV>
+    [[nodiscard]]
+    static auto column(byte* chunk) -> type_at_t<StructureIndexV>*
+    {
+      return std::assume_aligned<COLUMN_ALIGNMENTS[StructureIndexV]>(
+        reinterpret_cast<type_at_t<StructureIndexV>*>(chunk + COLUMN_OFFSETS[StructureIndexV]));
+    }
+
+    template <usize StructureIndexV>
+    [[nodiscard]]
+    static auto column(const byte* chunk) -> const type_at_t<StructureIndexV>*
+    {
+      return std::assume_aligned<COLUMN_ALIGNMENTS[StructureIndexV]>(
+        reinterpret_cast<const type_at_t<StructureIndexV>*>(
+          chunk + COLUMN_OFFSETS[StructureIndexV]));
+    }
+
+    template <typename Fn>
+    static void for_each_column(Fn fn)
+    {
+      [&fn]<usize... IndexVs>(std::index_sequence<IndexVs...>)
+      {
+        (fn.template operator()<IndexVs>(), ...);
+      }(std::make_index_sequence<ELEMENT_COUNT>());
+    }
+
+    [[nodiscard]]
+    auto get_chunk_size(usize chunk_index) const -> usize
+    {
+      return std::min(CHUNK_SIZE, size_ - chunk_index * CHUNK_SIZE);
+    }
+
+    void destroy_element(usize element_index) noexcept
+    {
+      byte* chunk            = chunks_[element_index / CHUNK_SIZE];
+      const usize slot_index = element_index % CHUNK_SIZE;
+      for_each_column(
+        [chunk, slot_index]<usize IndexV>()
+        {
+          destroy_at(column<IndexV>(chunk) + slot_index);
+        });
+    }
+  };
+
+} // namespace soul
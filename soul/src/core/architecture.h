@@ -14,4 +14,18 @@ namespace soul
     const u64 count = std::thread::hardware_concurrency();
     return count != 0 ? count : SOUL_DEFAULT_HARDWARE_THREAD_COUNT;
   }
+
+  // Hint to the cpu that we are inside a spin-wait loop
+  inline void cpu_pause()
+  {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+  }
 } // namespace soul
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <bit>
 #include <ranges>
 
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#endif
+
 #include "core/bit_ref.h"
 #include "core/config.h"
+#include "core/option.h"
 #include "core/panic.h"
 #include "core/type.h"
+#include "core/type_traits.h"
 
 #include "memory/allocator.h"
 
@@ -114,6 +121,27 @@ namespace soul
 
     void reset();
 
+    [[nodiscard]]
+    auto count() const -> usize;
+
+    [[nodiscard]]
+    auto find_first() const -> Option<usize>;
+
+    [[nodiscard]]
+    auto find_next(usize last_find_index) const -> Option<usize>;
+
+    template <ts_fn<void, usize> Fn>
+    void for_each_set_bit(Fn fn) const;
+
+    // NOTE(kevinyu): Bulk operations work a whole block at a time, both bit vectors must have the
+    // same size.
+    auto operator&=(const this_type& other) -> this_type&;
+
+    auto operator|=(const this_type& other) -> this_type&;
+
+    // NOTE(kevinyu): Reset every bit that is set in other, i.e. *this &= ~other.
+    auto and_not(const this_type& other) -> this_type&;
+
   private:
     NotNull<AllocatorT*> allocator_;
     BlockT* blocks_ = nullptr;
@@ -153,6 +181,20 @@ namespace soul
 
     BitVector(Construct::FillN tag, usize size, b8 val, AllocatorT& allocator);
 
+    enum class BlockOp : u8
+    {
+      AND,
+      OR,
+      AND_NOT,
+      COUNT
+    };
+
+    template <BlockOp BlockOpV>
+    void apply_block_op(const this_type& other);
+
+    [[nodiscard]]
+    auto get_masked_block(usize block_index) const -> BlockT;
+
     auto operator=(const BitVector& other) -> BitVector&;
 
     auto get_bit_ref(usize index) -> reference;
@@ -516,6 +558,160 @@ namespace soul
     std::fill_n(blocks_, get_block_count(size_), BlockT(0));
   }
 
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  auto BitVector<BlockT, AllocatorT>::count() const -> usize
+  {
+    usize bit_count         = 0;
+    const usize block_count = get_block_count(size_);
+    for (usize block_index = 0; block_index < block_count; block_index++)
+    {
+      bit_count += std::popcount(get_masked_block(block_index));
+    }
+    return bit_count;
+  }
+
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  auto BitVector<BlockT, AllocatorT>::find_first() const -> Option<usize>
+  {
+    const usize block_count = get_block_count(size_);
+    for (usize block_index = 0; block_index < block_count; block_index++)
+    {
+      const BlockT block = get_masked_block(block_index);
+      if (block != 0)
+      {
+        return Option<usize>::Some(block_index * BLOCK_BIT_COUNT + std::countr_zero(block));
+      }
+    }
+    return nilopt;
+  }
+
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  auto BitVector<BlockT, AllocatorT>::find_next(const usize last_find_index) const
+    -> Option<usize>
+  {
+    const usize start_find_index = last_find_index + 1;
+    if (start_find_index >= size_)
+    {
+      return nilopt;
+    }
+    const usize block_count = get_block_count(size_);
+    usize block_index       = get_block_index(start_find_index);
+    const auto mask = static_cast<BlockT>(~BlockT(0) << get_block_offset(start_find_index));
+    BlockT block    = get_masked_block(block_index) & mask;
+    while (true)
+    {
+      if (block != 0)
+      {
+        return Option<usize>::Some(block_index * BLOCK_BIT_COUNT + std::countr_zero(block));
+      }
+      block_index += 1;
+      if (block_index >= block_count)
+      {
+        break;
+      }
+      block = get_masked_block(block_index);
+    }
+    return nilopt;
+  }
+
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  template <ts_fn<void, usize> Fn>
+  void BitVector<BlockT, AllocatorT>::for_each_set_bit(Fn fn) const
+  {
+    const usize block_count = get_block_count(size_);
+    for (usize block_index = 0; block_index < block_count; block_index++)
+    {
+      BlockT block                  = get_masked_block(block_index);
+      const usize block_start_index = block_index * BLOCK_BIT_COUNT;
+      while (block != 0)
+      {
+        fn(block_start_index + std::countr_zero(block));
+        // NOTE(kevinyu): Clear the lowest set bit
+        block &= block - 1;
+      }
+    }
+  }
+
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  auto BitVector<BlockT, AllocatorT>::operator&=(const this_type& other) -> this_type&
+  {
+    apply_block_op<BlockOp::AND>(other);
+    return *this;
+  }
+
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  auto BitVector<BlockT, AllocatorT>::operator|=(const this_type& other) -> this_type&
+  {
+    apply_block_op<BlockOp::OR>(other);
+    return *this;
+  }
+
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  auto BitVector<BlockT, AllocatorT>::and_not(const this_type& other) -> this_type&
+  {
+    apply_block_op<BlockOp::AND_NOT>(other);
+    return *this;
+  }
+
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  template <typename BitVector<BlockT, AllocatorT>::BlockOp BlockOpV>
+  void BitVector<BlockT, AllocatorT>::apply_block_op(const this_type& other)
+  {
+    SOUL_ASSERT(0, size_ == other.size_, "Bit vector size mismatch");
+    const usize block_count = get_block_count(size_);
+    usize block_index       = 0;
+
+    // NOTE(kevinyu): The bits after size_ in the last block are garbage either way, so the whole
+    // last block can be processed.
+#if defined(__AVX2__)
+    static constexpr usize SIMD_BLOCK_COUNT = sizeof(__m256i) / sizeof(BlockT);
+    for (; block_index + SIMD_BLOCK_COUNT <= block_count; block_index += SIMD_BLOCK_COUNT)
+    {
+      auto* dst         = reinterpret_cast<__m256i*>(blocks_ + block_index);
+      const auto* src   = reinterpret_cast<const __m256i*>(other.blocks_ + block_index);
+      const __m256i lhs = _mm256_loadu_si256(dst);
+      const __m256i rhs = _mm256_loadu_si256(src);
+      if constexpr (BlockOpV == BlockOp::AND)
+      {
+        _mm256_storeu_si256(dst, _mm256_and_si256(lhs, rhs));
+      } else if constexpr (BlockOpV == BlockOp::OR)
+      {
+        _mm256_storeu_si256(dst, _mm256_or_si256(lhs, rhs));
+      } else
+      {
+        _mm256_storeu_si256(dst, _mm256_andnot_si256(rhs, lhs));
+      }
+    }
+#endif
+
+    for (; block_index < block_count; block_index++)
+    {
+      if constexpr (BlockOpV == BlockOp::AND)
+      {
+        blocks_[block_index] &= other.blocks_[block_index];
+      } else if constexpr (BlockOpV == BlockOp::OR)
+      {
+        blocks_[block_index] |= other.blocks_[block_index];
+      } else
+      {
+        blocks_[block_index] &= ~other.blocks_[block_index];
+      }
+    }
+  }
+
+  template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
+  auto BitVector<BlockT, AllocatorT>::get_masked_block(const usize block_index) const -> BlockT
+  {
+    // NOTE(kevinyu): Bits after size_ are not guaranteed to be zero (e.g. after pop_back() or
+    // set()), mask them out of the last block.
+    const usize last_offset = get_block_offset(size_);
+    if (block_index == get_block_index(size_ - 1) && last_offset != 0)
+    {
+      return blocks_[block_index] & ((BlockT(1) << last_offset) - 1);
+    }
+    return blocks_[block_index];
+  }
+
   template <ts_bit_block BlockT, memory::allocator_type AllocatorT>
   auto BitVector<BlockT, AllocatorT>::get_bit_ref(const usize index) -> reference
   {
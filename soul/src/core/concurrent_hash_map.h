@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "core/architecture.h"
+#include "core/compiler.h"
+#include "core/hash.h"
+#include "core/panic.h"
+#include "core/type.h"
+#include "core/type_traits.h"
+#include "memory/allocator.h"
+
+namespace soul
+{
+
+  /*
+    Hash map that can be shared between threads. It is split into SHARD_COUNT shards by the hash
+    code. Every shard is a linear probing table of node pointers that is only written under the
+    shard mutex, so find() never take a lock and never wait for a writer.
+
+    Removed nodes and replaced tables are not freed right away since a reader might still use them.
+    They are kept until reclaim(), that must be called while no other thread is using the map, e.g.
+    once per frame. Pointer returned by find() and find_or_create() stay valid until then.
+  */
+  template <
+    typename KeyT,
+    typename ValT,
+    typename Hash     = HashOp<KeyT>,
+    typename KeyEqual = std::equal_to<KeyT>>
+  class ConcurrentHashMap
+  {
+  public:
+    static constexpr u32 SHARD_BIT_COUNT = 4;
+    static constexpr u32 SHARD_COUNT     = 1u << SHARD_BIT_COUNT;
+
+    explicit ConcurrentHashMap(memory::Allocator* allocator = get_default_allocator())
+        : allocator_(allocator)
+    {
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+
+    auto operator=(const ConcurrentHashMap&) -> ConcurrentHashMap& = delete;
+
+    ConcurrentHashMap(ConcurrentHashMap&&) = delete;
+
+    auto operator=(ConcurrentHashMap&&) -> ConcurrentHashMap& = delete;
+
+    ~ConcurrentHashMap()
+    {
+      reclaim();
+      for (Shard& shard : shards_)
+      {
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if (table == nullptr)
+        {
+          continue;
+        }
+        for (usize slot_index = 0; slot_index < table->slot_count; slot_index++)
+        {
+          Node* node = table->slots[slot_index].load(std::memory_order_relaxed);
+          if (node != nullptr && node != get_tombstone())
+          {
+            allocator_->destroy(NotNull(node));
+          }
+        }
+        destroy_table(table);
+      }
+    }
+
+    // return nullptr if the key does not exist, never block
+    [[nodiscard]]
+    auto find(const KeyT& key) const -> const ValT*
+    {
+      const u64 hash_code = hash_fn_(key);
+      const Table* table  = get_shard(hash_code).table.load(std::memory_order_acquire);
+      if (table == nullptr)
+      {
+        return nullptr;
+      }
+      const usize slot_mask = table->slot_count - 1;
+      for (usize slot_index = hash_code & slot_mask;; slot_index = (slot_index + 1) & slot_mask)
+      {
+        const Node* node = table->slots[slot_index].load(std::memory_order_acquire);
+        if (node == nullptr)
+        {
+          return nullptr;
+        }
+        if (
+          node != get_tombstone() && node->hash_code == hash_code &&
+          key_equal_fn_(node->key, key))
+        {
+          return &node->value;
+        }
+      }
+    }
+
+    [[nodiscard]]
+    auto contains(const KeyT& key) const -> b8
+    {
+      return find(key) != nullptr;
+    }
+
+    /*
+      Return the value of key, fn is called to create it if the key does not exist. fn is called
+      with the shard lock held, so it is called at most once per key but must not use this map.
+    */
+    template <ts_fn<ValT> Fn>
+    auto find_or_create(const KeyT& key, Fn fn) -> const ValT&
+    {
+      if (const ValT* value = find(key); value != nullptr)
+      {
+        return *value;
+      }
+
+      const u64 hash_code = hash_fn_(key);
+      Shard& shard        = get_shard(hash_code);
+      std::lock_guard guard(shard.mutex);
+      const usize slot_index = find_slot(shard, hash_code, key);
+      Table* table           = shard.table.load(std::memory_order_relaxed);
+      Node* node             = table->slots[slot_index].load(std::memory_order_relaxed);
+      if (node != nullptr && node != get_tombstone())
+      {
+        return node->value;
+      }
+
+      node = allocator_->create<Node>(hash_code, key, fn()).unwrap();
+      if (table->slots[slot_index].load(std::memory_order_relaxed) == nullptr)
+      {
+        shard.used_count++;
+      }
+      table->slots[slot_index].store(node, std::memory_order_release);
+      shard.size.fetch_add(1, std::memory_order_relaxed);
+      return node->value;
+    }
+
+    // return false if the key does not exist
+    auto remove(const KeyT& key) -> b8
+    {
+      const u64 hash_code = hash_fn_(key);
+      Shard& shard        = get_shard(hash_code);
+      std::lock_guard guard(shard.mutex);
+      Table* table = shard.table.load(std::memory_order_relaxed);
+      if (table == nullptr)
+      {
+        return false;
+      }
+      const usize slot_mask = table->slot_count - 1;
+      for (usize slot_index = hash_code & slot_mask;; slot_index = (slot_index + 1) & slot_mask)
+      {
+        Node* node = table->slots[slot_index].load(std::memory_order_relaxed);
+        if (node == nullptr)
+        {
+          return false;
+        }
+        if (
+          node != get_tombstone() && node->hash_code == hash_code &&
+          key_equal_fn_(node->key, key))
+        {
+          table->slots[slot_index].store(get_tombstone(), std::memory_order_release);
+          node->next_retired  = shard.retired_nodes;
+          shard.retired_nodes = node;
+          shard.size.fetch_sub(1, std::memory_order_relaxed);
+          return true;
+        }
+      }
+    }
+
+    // not a consistent snapshot while other threads are inserting or removing
+    [[nodiscard]]
+    auto size() const -> usize
+    {
+      usize size = 0;
+      for (const Shard& shard : shards_)
+      {
+        size += shard.size.load(std::memory_order_relaxed);
+      }
+      return size;
+    }
+
+    [[nodiscard]]
+    auto empty() const -> b8
+    {
+      return size() == 0;
+    }
+
+    // free removed nodes and replaced tables, must not be called while other thread use the map
+    void reclaim()
+    {
+      for (Shard& shard : shards_)
+      {
+        while (shard.retired_nodes != nullptr)
+        {
+          Node* next = shard.retired_nodes->next_retired;
+          allocator_->destroy(NotNull(shard.retired_nodes));
+          shard.retired_nodes = next;
+        }
+        while (shard.retired_tables != nullptr)
+        {
+          Table* next = shard.retired_tables->next_retired;
+          destroy_table(shard.retired_tables);
+          shard.retired_tables = next;
+        }
+      }
+    }
+
+  private:
+    static constexpr usize MIN_SLOT_COUNT = 16;
+
+    struct Node
+    {
+      u64 hash_code;
+      KeyT key;
+      ValT value;
+      Node* next_retired = nullptr;
+
+      Node(u64 hash_code, const KeyT& key, ValT&& value)
+          : hash_code(hash_code), key(key), value(std::move(value))
+      {
+      }
+    };
+
+    struct Table
+    {
+      usize slot_count          = 0;
+      std::atomic<Node*>* slots = nullptr;
+      Table* next_retired       = nullptr;
+    };
+
+    // NOTE(kevinyu): Readers only load table. Every field is only written with the mutex held.
+    struct alignas(SOUL_CACHELINE_SIZE) Shard
+    {
+      std::atomic<Table*> table = nullptr;
+      std::mutex mutex;
+      std::atomic<usize> size = 0;
+      usize used_count        = 0; // node and tombstone
+      Node* retired_nodes     = nullptr;
+      Table* retired_tables   = nullptr;
+    };
+
+    static auto get_tombstone() -> Node*
+    {
+      return reinterpret_cast<Node*>(uptr(1)); // NOLINT(performance-no-int-to-ptr)
+    }
+
+    auto get_shard(u64 hash_code) -> Shard&
+    {
+      return shards_[hash_code >> (64 - SHARD_BIT_COUNT)];
+    }
+
+    auto get_shard(u64 hash_code) const -> const Shard&
+    {
+      return shards_[hash_code >> (64 - SHARD_BIT_COUNT)];
+    }
+
+    auto create_table(usize slot_count) -> Table*
+    {
+      Table* table      = allocator_->create<Table>().unwrap();
+      table->slot_count = slot_count;
+      table->slots      = allocator_->allocate_array<std::atomic<Node*>>(slot_count);
+      std::uninitialized_value_construct_n(table->slots, slot_count);
+      return table;
+    }
+
+    void destroy_table(Table* table)
+    {
+      allocator_->deallocate_array(table->slots, table->slot_count);
+      allocator_->destroy(NotNull(table));
+    }
+
+    // NOTE(kevinyu): Readers that already loaded the old table keep probing it, so the old table is
+    // retired instead of freed. Tombstones are dropped here.
+    void grow(Shard& shard)
+    {
+      Table* old_table       = shard.table.load(std::memory_order_relaxed);
+      const usize size       = shard.size.load(std::memory_order_relaxed);
+      const usize slot_count = std::max(MIN_SLOT_COUNT, std::bit_ceil((size + 1) * 4));
+      Table* table           = create_table(slot_count);
+      const usize slot_mask  = slot_count - 1;
+      if (old_table != nullptr)
+      {
+        for (usize old_index = 0; old_index < old_table->slot_count; old_index++)
+        {
+          Node* node = old_table->slots[old_index].load(std::memory_order_relaxed);
+          if (node == nullptr || node == get_tombstone())
+          {
+            continue;
+          }
+          usize slot_index = node->hash_code & slot_mask;
+          while (table->slots[slot_index].load(std::memory_order_relaxed) != nullptr)
+          {
+            slot_index = (slot_index + 1) & slot_mask;
+          }
+          table->slots[slot_index].store(node, std::memory_order_relaxed);
+        }
+        old_table->next_retired = shard.retired_tables;
+        shard.retired_tables    = old_table;
+      }
+      shard.used_count = size;
+      shard.table.store(table, std::memory_order_release);
+    }
+
+    // return the slot of key, or the slot where key should be inserted. Must hold the shard lock.
+    auto find_slot(Shard& shard, u64 hash_code, const KeyT& key) -> usize
+    {
+      Table* table = shard.table.load(std::memory_order_relaxed);
+      if (table == nullptr || (shard.used_count + 1) * 2 > table->slot_count)
+      {
+        grow(shard);
+        table = shard.table.load(std::memory_order_relaxed);
+      }
+      const usize slot_mask = table->slot_count - 1;
+      usize insert_index    = table->slot_count;
+      for (usize slot_index = hash_code & slot_mask;; slot_index = (slot_index + 1) & slot_mask)
+      {
+        const Node* node = table->slots[slot_index].load(std::memory_order_relaxed);
+        if (node == nullptr)
+        {
+          return insert_index != table->slot_count ? insert_index : slot_index;
+        }
+        if (node == get_tombstone())
+        {
+          if (insert_index == table->slot_count)
+          {
+            insert_index = slot_index;
+          }
+        } else if (node->hash_code == hash_code && key_equal_fn_(node->key, key))
+        {
+          return slot_index;
+        }
+      }
+    }
+
+    memory::Allocator* allocator_;
+    SOUL_NO_UNIQUE_ADDRESS Hash hash_fn_;
+    SOUL_NO_UNIQUE_ADDRESS KeyEqual key_equal_fn_;
+    Shard shards_[SHARD_COUNT];
+  };
+
+} // namespace soul
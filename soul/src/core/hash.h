@@ -287,4 +287,31 @@ namespace soul
     hasher.combine_span(span);
     return hasher.finish();
   }
+
+  /*
+    QueryT can look up a table of KeyT without building a KeyT. Either KeyT can be borrowed as
+    QueryT, or HashT declare is_transparent and hash QueryT to the same value as the equal KeyT.
+  */
+  template <typename QueryT, typename KeyT, typename HashT>
+  concept ts_hash_query =
+    !same_as<std::remove_cvref_t<QueryT>, KeyT> &&
+    (BorrowTrait<KeyT, QueryT>::available ||
+     requires(const HashT& hash_fn, const KeyT& key, const QueryT& query) {
+       typename HashT::is_transparent;
+       { hash_fn(query) } -> same_as<u64>;
+       { key == query } -> std::convertible_to<b8>;
+     });
+
+  template <typename KeyT, typename QueryT>
+  [[nodiscard]]
+  constexpr auto is_hash_query_equal(const KeyT& key, const QueryT& query) -> b8
+  {
+    if constexpr (BorrowTrait<KeyT, QueryT>::available)
+    {
+      return query == borrow<QueryT>(key);
+    } else
+    {
+      return key == query;
+    }
+  }
 } // namespace soul
@@ -4,6 +4,7 @@
 #include "core/hash.h"
 #include "core/own_ref.h"
 #include "core/robin_table.h"
+#include "core/swiss_table.h"
 #include "core/type.h"
 #include "core/type_traits.h"
 #include "core/util.h"
@@ -27,22 +28,41 @@ namespace soul
     };
   };
 
+  // NOTE(kevinyu): ROBIN keep half of the slots empty. SWISS probe sixteen slots at once and fill
+  // up to 7/8 of the slots, it use less memory and is faster to look up in big map.
+  enum class HashTableBackend : u8
+  {
+    ROBIN,
+    SWISS,
+    COUNT
+  };
+
   template <
     typename KeyT,
     typename ValT,
     typename Hash                     = HashOp<KeyT>,
     typename KeyEqual                 = std::equal_to<KeyT>,
-    memory::allocator_type AllocatorT = memory::Allocator>
+    memory::allocator_type AllocatorT = memory::Allocator,
+    HashTableBackend BackendV         = HashTableBackend::ROBIN>
   class HashMap
   {
   private:
-    using HashTableT = RobinTable<
-      KeyT,
-      Entry<KeyT, ValT>,
-      typename Entry<KeyT, ValT>::GetKeyOp,
-      Hash,
-      RobinTableConfig{.load_factor = 0.5f},
-      AllocatorT>;
+    using HashTableT = std::conditional_t<
+      BackendV == HashTableBackend::SWISS,
+      SwissTable<
+        KeyT,
+        Entry<KeyT, ValT>,
+        typename Entry<KeyT, ValT>::GetKeyOp,
+        Hash,
+        SwissTableConfig{.load_factor = 0.875f},
+        AllocatorT>,
+      RobinTable<
+        KeyT,
+        Entry<KeyT, ValT>,
+        typename Entry<KeyT, ValT>::GetKeyOp,
+        Hash,
+        RobinTableConfig{.load_factor = 0.5f},
+        AllocatorT>>;
 
     HashTableT hash_table_;
 
@@ -68,7 +88,7 @@ namespace soul
       return *this = other;
     }
 
-    void swap(HashMap<KeyT, ValT>& other) noexcept
+    void swap(HashMap& other) noexcept
     {
       using std::swap;
       swap(this->hash_table_, other.hash_table_);
@@ -99,8 +119,46 @@ namespace soul
       return hash_table_.insert(EntryT{.key = std::move(key), .value = std::move(value)});
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    // construct the value from args only if key is not in the map, return the value of key
+    template <typename... Args>
+    auto try_emplace(OwnRef<KeyT> key, Args&&... args) -> ValT&
+    {
+      return find_or_insert_with(
+        std::move(key),
+        [&args...]() -> ValT
+        {
+          return ValT(std::forward<Args>(args)...);
+        });
+    }
+
+    // fn is only called to create the value if key is not in the map, return the value of key
+    template <ts_fn<ValT> Fn>
+    auto find_or_insert_with(OwnRef<KeyT> key, Fn fn) -> ValT&
+    {
+      KeyT key_tmp = std::move(key);
+      EntryT& entry = hash_table_.find_or_insert_with(
+        key_tmp,
+        [&key_tmp, &fn]() -> EntryT
+        {
+          return EntryT{.key = std::move(key_tmp), .value = fn()};
+        });
+      return entry.value;
+    }
+
+    // the key is only built from the query by make_key if the query is not in the map
+    template <ts_hash_query<KeyT, Hash> QueryT, ts_fn<KeyT, QueryT> MakeKeyFn, ts_fn<ValT> Fn>
+    auto find_or_insert_with(QueryT key, MakeKeyFn make_key, Fn fn) -> ValT&
+    {
+      EntryT& entry = hash_table_.find_or_insert_with(
+        key,
+        [&key, &make_key, &fn]() -> EntryT
+        {
+          return EntryT{.key = make_key(key), .value = fn()};
+        });
+      return entry.value;
+    }
+
+    template <ts_hash_query<KeyT, Hash> QueryT>
     void remove(QueryT key)
     {
       return hash_table_.remove(key);
@@ -111,8 +169,34 @@ namespace soul
       return hash_table_.remove(key);
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    // return nullptr if the key does not exist
+    template <ts_hash_query<KeyT, Hash> QueryT>
+    [[nodiscard]]
+    auto find(QueryT key) -> ValT*
+    {
+      return find_value(hash_table_, key);
+    }
+
+    [[nodiscard]]
+    auto find(const KeyT& key) -> ValT*
+    {
+      return find_value(hash_table_, key);
+    }
+
+    template <ts_hash_query<KeyT, Hash> QueryT>
+    [[nodiscard]]
+    auto find(QueryT key) const -> const ValT*
+    {
+      return find_value(hash_table_, key);
+    }
+
+    [[nodiscard]]
+    auto find(const KeyT& key) const -> const ValT*
+    {
+      return find_value(hash_table_, key);
+    }
+
+    template <ts_hash_query<KeyT, Hash> QueryT>
     [[nodiscard]]
     auto contains(QueryT key) const -> b8
     {
@@ -125,8 +209,7 @@ namespace soul
       return hash_table_.contains(key);
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, Hash> QueryT>
     [[nodiscard]]
     auto
     operator[](QueryT key) -> ValT&
@@ -141,8 +224,7 @@ namespace soul
       return hash_table_.entry_ref(key).value;
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, Hash> QueryT>
     [[nodiscard]]
     auto
     operator[](QueryT key) const -> const ValT&
@@ -157,8 +239,7 @@ namespace soul
       return hash_table_.entry_ref(key).value;
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, Hash> QueryT>
     [[nodiscard]]
     auto ref(QueryT key) -> ValT&
     {
@@ -171,8 +252,7 @@ namespace soul
       return operator[](key);
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, Hash> QueryT>
     [[nodiscard]]
     auto ref(QueryT key) const -> const ValT&
     {
@@ -204,6 +284,13 @@ namespace soul
     }
 
   private:
+    template <typename HashTableRefT, typename QueryT>
+    static auto find_value(HashTableRefT& hash_table, const QueryT& key)
+    {
+      const auto it = hash_table.find(key);
+      return it == hash_table.end() ? nullptr : &it->value;
+    }
+
     HashMap(const HashMap& other) // NOLINT
         : hash_table_(other.hash_table_)
     {
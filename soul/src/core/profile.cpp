@@ -0,0 +1,666 @@
+#include "core/profile.h"
+
+#if defined(SOUL_MEMPROFILE_CPU_BACKEND_SOUL_PROFILER)
+
+#  include <atomic>
+#  include <bit>
+#  include <cstdio>
+#  include <cstring>
+#  include <mutex>
+
+#  include "core/architecture.h"
+#  include "core/hash_map.h"
+#  include "core/log.h"
+#  include "core/string.h"
+#  include "core/uint64_hash_map.h"
+#  include "core/vector.h"
+#  include "memory/allocators/malloc_allocator.h"
+#  include "misc/json.h"
+
+namespace soul::impl
+{
+  namespace
+  {
+    // NOTE(kevinyu): Bucket i count the allocation with size in [2^(i - 1), 2^i), the last bucket
+    // count everything bigger.
+    constexpr usize SIZE_HISTOGRAM_BUCKET_COUNT = 32;
+
+    auto get_size_histogram_bucket(usize size) -> usize
+    {
+      return std::min<usize>(std::bit_width(size), SIZE_HISTOGRAM_BUCKET_COUNT - 1);
+    }
+
+    constexpr usize ALLOCATOR_CACHE_CAPACITY    = 1024;
+    constexpr usize TAG_CACHE_CAPACITY          = 256;
+    constexpr usize LIVE_ALLOCATION_SHARD_COUNT = 16;
+
+    // NOTE(kevinyu): Every container of the profiler use this allocator, that is not profiled, so
+    // the profiler never call back into itself.
+    auto get_profiler_allocator() -> memory::Allocator*
+    {
+      static memory::MallocAllocator s_allocator("Memory Profiler"_str);
+      return &s_allocator;
+    }
+
+    // a consistent copy of AtomicMemStats, used by the snapshot, json and leak report
+    struct MemStats
+    {
+      u64 live_bytes                                  = 0;
+      u64 peak_bytes                                  = 0;
+      u64 live_count                                  = 0;
+      u64 allocation_count                            = 0;
+      u64 last_frame_allocation_count                 = 0;
+      u64 last_frame_allocation_bytes                 = 0;
+      u64 size_histogram[SIZE_HISTOGRAM_BUCKET_COUNT] = {};
+    };
+
+    /*
+      Updated by every allocation without a lock. The fields are independent relaxed counters, so
+      a load() while other threads are allocating can mix values of different moments.
+    */
+    struct AtomicMemStats
+    {
+      std::atomic<u64> live_bytes                                  = 0;
+      std::atomic<u64> peak_bytes                                  = 0;
+      std::atomic<u64> live_count                                  = 0;
+      std::atomic<u64> allocation_count                            = 0;
+      std::atomic<u64> frame_allocation_count                      = 0;
+      std::atomic<u64> frame_allocation_bytes                      = 0;
+      std::atomic<u64> last_frame_allocation_count                 = 0;
+      std::atomic<u64> last_frame_allocation_bytes                 = 0;
+      std::atomic<u64> size_histogram[SIZE_HISTOGRAM_BUCKET_COUNT] = {};
+
+      void on_allocate(usize size)
+      {
+        const u64 new_live_bytes = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        u64 old_peak_bytes       = peak_bytes.load(std::memory_order_relaxed);
+        while (old_peak_bytes < new_live_bytes &&
+               !peak_bytes.compare_exchange_weak(
+                 old_peak_bytes, new_live_bytes, std::memory_order_relaxed))
+        {
+        }
+        live_count.fetch_add(1, std::memory_order_relaxed);
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        frame_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        frame_allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+        size_histogram[get_size_histogram_bucket(size)].fetch_add(1, std::memory_order_relaxed);
+      }
+
+      void on_deallocate(usize size)
+      {
+        live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        live_count.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      void on_frame()
+      {
+        last_frame_allocation_count.store(
+          frame_allocation_count.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        last_frame_allocation_bytes.store(
+          frame_allocation_bytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+
+      [[nodiscard]]
+      auto load() const -> MemStats
+      {
+        MemStats stats = {
+          .live_bytes       = live_bytes.load(std::memory_order_relaxed),
+          .peak_bytes       = peak_bytes.load(std::memory_order_relaxed),
+          .live_count       = live_count.load(std::memory_order_relaxed),
+          .allocation_count = allocation_count.load(std::memory_order_relaxed),
+        };
+        stats.last_frame_allocation_count =
+          last_frame_allocation_count.load(std::memory_order_relaxed);
+        stats.last_frame_allocation_bytes =
+          last_frame_allocation_bytes.load(std::memory_order_relaxed);
+        for (usize bucket_index = 0; bucket_index < SIZE_HISTOGRAM_BUCKET_COUNT; bucket_index++)
+        {
+          stats.size_histogram[bucket_index] =
+            size_histogram[bucket_index].load(std::memory_order_relaxed);
+        }
+        return stats;
+      }
+    };
+
+    /*
+      Map the address of a name to its tracked object without a lock. Only insert() need the
+      profiler lock. The names are usually compile time strings, so every name is inserted once and
+      all later lookup take the lock free path. When the cache is full the caller stay on the slow
+      path.
+    */
+    template <typename T, usize CapacityV>
+    class PointerCache
+    {
+    public:
+      static_assert(std::has_single_bit(CapacityV));
+
+      [[nodiscard]]
+      auto find(const void* key) const -> T*
+      {
+        const auto key_value = reinterpret_cast<uptr>(key);
+        for (usize probe_index = 0; probe_index < CapacityV; probe_index++)
+        {
+          const Entry& entry   = entries_[get_slot(key_value, probe_index)];
+          const uptr entry_key = entry.key.load(std::memory_order_acquire);
+          if (entry_key == key_value)
+          {
+            return entry.value.load(std::memory_order_relaxed);
+          }
+          if (entry_key == 0)
+          {
+            return nullptr;
+          }
+        }
+        return nullptr;
+      }
+
+      // the caller must hold the profiler lock
+      void insert(const void* key, T* value)
+      {
+        const auto key_value = reinterpret_cast<uptr>(key);
+        for (usize probe_index = 0; probe_index < CapacityV; probe_index++)
+        {
+          Entry& entry         = entries_[get_slot(key_value, probe_index)];
+          const uptr entry_key = entry.key.load(std::memory_order_relaxed);
+          if (entry_key == key_value)
+          {
+            return;
+          }
+          if (entry_key == 0)
+          {
+            // NOTE(kevinyu): Publish the value before the key, find() read them in reverse.
+            entry.value.store(value, std::memory_order_relaxed);
+            entry.key.store(key_value, std::memory_order_release);
+            return;
+          }
+        }
+      }
+
+    private:
+      struct Entry
+      {
+        std::atomic<uptr> key = 0;
+        std::atomic<T*> value = nullptr;
+      };
+
+      static auto get_slot(uptr key, usize probe_index) -> usize
+      {
+        const u64 hash = (u64(key) >> 4) * 0x9E3779B97F4A7C15ull;
+        return (soul::cast<usize>(hash >> 32) + probe_index) & (CapacityV - 1);
+      }
+
+      Entry entries_[CapacityV];
+    };
+
+    struct TagStats
+    {
+      String tag;
+      MemStats stats;
+    };
+
+    struct AllocatorStats
+    {
+      String name;
+      MemStats stats;
+      Vector<TagStats> tags;
+    };
+
+    struct Snapshot
+    {
+      String name;
+      u64 frame = 0;
+      Vector<AllocatorStats> allocators;
+    };
+
+    struct TrackedTag
+    {
+      explicit TrackedTag(String tag) : tag(std::move(tag)) {}
+
+      String tag;
+      AtomicMemStats stats;
+    };
+
+    struct LiveAllocation
+    {
+      usize size      = 0;
+      TrackedTag* tag = nullptr;
+    };
+
+    // NOTE(kevinyu): A block is often freed by another thread than the one that allocated it, so
+    // the live allocations are sharded by address instead of by thread.
+    struct alignas(SOUL_CACHELINE_SIZE) LiveAllocationShard
+    {
+      std::mutex mutex;
+      UInt64HashMap<LiveAllocation> live_allocations{get_profiler_allocator()};
+    };
+
+    struct TrackedAllocator
+    {
+      explicit TrackedAllocator(StringView name)
+          : name(String::From(name, get_profiler_allocator())),
+            tags(get_profiler_allocator()),
+            tag_indexes(get_profiler_allocator())
+      {
+      }
+
+      TrackedAllocator(const TrackedAllocator&)                    = delete;
+      TrackedAllocator(TrackedAllocator&&)                         = delete;
+      auto operator=(const TrackedAllocator&) -> TrackedAllocator& = delete;
+      auto operator=(TrackedAllocator&&) -> TrackedAllocator&      = delete;
+
+      ~TrackedAllocator()
+      {
+        for (TrackedTag* tag : tags)
+        {
+          get_profiler_allocator()->destroy(NotNull(tag));
+        }
+      }
+
+      auto get_live_allocation_shard(const void* addr) -> LiveAllocationShard&
+      {
+        const auto key = reinterpret_cast<uptr>(addr);
+        return live_allocation_shards[(key >> 4) % LIVE_ALLOCATION_SHARD_COUNT];
+      }
+
+      String name;
+      AtomicMemStats stats;
+      PointerCache<TrackedTag, TAG_CACHE_CAPACITY> tag_cache;
+      LiveAllocationShard live_allocation_shards[LIVE_ALLOCATION_SHARD_COUNT];
+
+      // guarded by the profiler lock
+      u32 register_count = 0;
+      Vector<TrackedTag*> tags;
+      HashMap<String, u32> tag_indexes;
+    };
+
+    /*
+      register_allocation() and register_deallocation() only take the lock the first time they see
+      an allocator or tag name, the statistics are atomic and the live allocations are guarded by
+      per address shards. The lock guard the list of allocators and tags, it is held by the
+      snapshot, frame, json and leak report paths. The profiler does not log while holding its
+      lock, because logging may allocate from a profiled allocator.
+    */
+    class MemProfiler
+    {
+    public:
+      MemProfiler()
+          : allocators_(get_profiler_allocator()),
+            allocator_indexes_(get_profiler_allocator()),
+            snapshots_(get_profiler_allocator())
+      {
+      }
+
+      MemProfiler(const MemProfiler&)                    = delete;
+      MemProfiler(MemProfiler&&)                         = delete;
+      auto operator=(const MemProfiler&) -> MemProfiler& = delete;
+      auto operator=(MemProfiler&&) -> MemProfiler&      = delete;
+
+      ~MemProfiler()
+      {
+        for (TrackedAllocator* allocator : allocators_)
+        {
+          get_profiler_allocator()->destroy(NotNull(allocator));
+        }
+      }
+
+      void register_allocator(const char* name)
+      {
+        std::lock_guard guard(mutex_);
+        get_allocator_locked(name)->register_count++;
+      }
+
+      void unregister_allocator(const char* name)
+      {
+        // NOTE(kevinyu): Allocator with the same name share the stats, report the leak when the
+        // last one is gone.
+        Vector<AllocatorStats> leaks(get_profiler_allocator());
+        {
+          std::lock_guard guard(mutex_);
+          TrackedAllocator* allocator = get_allocator_locked(name);
+          SOUL_ASSERT(0, allocator->register_count > 0);
+          allocator->register_count--;
+          if (
+            allocator->register_count == 0 &&
+            allocator->stats.live_count.load(std::memory_order_relaxed) != 0)
+          {
+            leaks.push_back(capture_allocator_stats(*allocator));
+          }
+        }
+        for (const AllocatorStats& leak : leaks)
+        {
+          report_leak(leak);
+        }
+      }
+
+      void register_allocation(const char* name, const char* tag, const void* addr, usize size)
+      {
+        if (addr == nullptr)
+        {
+          return;
+        }
+        TrackedAllocator* allocator = get_allocator(name);
+        TrackedTag* tracked_tag     = get_tag(allocator, tag);
+        allocator->stats.on_allocate(size);
+        tracked_tag->stats.on_allocate(size);
+        LiveAllocationShard& shard = allocator->get_live_allocation_shard(addr);
+        std::lock_guard guard(shard.mutex);
+        shard.live_allocations.add(
+          reinterpret_cast<uptr>(addr), LiveAllocation{.size = size, .tag = tracked_tag});
+      }
+
+      void register_deallocation(const char* name, const void* addr)
+      {
+        if (addr == nullptr)
+        {
+          return;
+        }
+        TrackedAllocator* allocator = get_allocator(name);
+        const auto key              = reinterpret_cast<uptr>(addr);
+        LiveAllocation live_allocation;
+        {
+          LiveAllocationShard& shard = allocator->get_live_allocation_shard(addr);
+          std::lock_guard guard(shard.mutex);
+          // NOTE(kevinyu): Memory allocated before the allocator is registered is not tracked.
+          if (!shard.live_allocations.is_exist(key))
+          {
+            return;
+          }
+          live_allocation = shard.live_allocations[key];
+          shard.live_allocations.remove(key);
+        }
+        allocator->stats.on_deallocate(live_allocation.size);
+        live_allocation.tag->stats.on_deallocate(live_allocation.size);
+      }
+
+      void snapshot(const char* name)
+      {
+        std::lock_guard guard(mutex_);
+        snapshots_.push_back(capture(name));
+      }
+
+      void frame()
+      {
+        std::lock_guard guard(mutex_);
+        frame_++;
+        for (TrackedAllocator* allocator : allocators_)
+        {
+          allocator->stats.on_frame();
+          for (TrackedTag* tag : allocator->tags)
+          {
+            tag->stats.on_frame();
+          }
+        }
+      }
+
+      void report_leaks()
+      {
+        Vector<AllocatorStats> leaks(get_profiler_allocator());
+        {
+          std::lock_guard guard(mutex_);
+          for (const TrackedAllocator* allocator : allocators_)
+          {
+            if (allocator->stats.live_count.load(std::memory_order_relaxed) != 0)
+            {
+              leaks.push_back(capture_allocator_stats(*allocator));
+            }
+          }
+        }
+        for (const AllocatorStats& leak : leaks)
+        {
+          report_leak(leak);
+        }
+      }
+
+      void dump_json(const char* path)
+      {
+        JsonDoc doc;
+        JsonObjectRef root         = doc.create_root_empty_object();
+        JsonArrayRef snapshots_ref = doc.create_empty_array();
+        {
+          std::lock_guard guard(mutex_);
+          for (const Snapshot& snapshot : snapshots_)
+          {
+            snapshots_ref.append(build_json(&doc, snapshot));
+          }
+          root.add("frame"_str, u64(frame_));
+          root.add("current"_str, build_json(&doc, capture("current")));
+        }
+        root.add("snapshots"_str, snapshots_ref);
+
+        const String json = doc.dump(get_profiler_allocator());
+        FILE* file        = std::fopen(path, "w");
+        if (file == nullptr)
+        {
+          SOUL_LOG_WARN("Fail to open {} to dump memory profile", path);
+          return;
+        }
+        std::fputs(json.c_str(), file);
+        std::fclose(file);
+      }
+
+    private:
+      auto get_allocator(const char* name) -> TrackedAllocator*
+      {
+        TrackedAllocator* allocator = allocator_cache_.find(name);
+        if (allocator != nullptr)
+        {
+          return allocator;
+        }
+        std::lock_guard guard(mutex_);
+        return get_allocator_locked(name);
+      }
+
+      auto get_allocator_locked(const char* name) -> TrackedAllocator*
+      {
+        // NOTE(kevinyu): Allocator name is a compile time string, cache the index by its address
+        // and only compare the content the first time an address is seen.
+        const auto name_key = reinterpret_cast<uptr>(name);
+        if (allocator_indexes_.is_exist(name_key))
+        {
+          return allocators_[allocator_indexes_[name_key]];
+        }
+        const StringView name_view = {name, std::strlen(name)};
+        u32 allocator_index        = 0;
+        while (allocator_index < allocators_.size() &&
+               allocators_[allocator_index]->name.cview() != name_view)
+        {
+          allocator_index++;
+        }
+        if (allocator_index == allocators_.size())
+        {
+          allocators_.push_back(
+            get_profiler_allocator()->create<TrackedAllocator>(name_view).unwrap());
+        }
+        allocator_indexes_.add(name_key, allocator_index);
+        allocator_cache_.insert(name, allocators_[allocator_index]);
+        return allocators_[allocator_index];
+      }
+
+      auto get_tag(TrackedAllocator* allocator, const char* tag) -> TrackedTag*
+      {
+        TrackedTag* tracked_tag = allocator->tag_cache.find(tag);
+        if (tracked_tag != nullptr)
+        {
+          return tracked_tag;
+        }
+        std::lock_guard guard(mutex_);
+        StringView tag_view = "untagged"_str;
+        if (tag != nullptr && tag[0] != '\0')
+        {
+          tag_view = StringView{tag, std::strlen(tag)};
+        }
+        const u32 tag_index = allocator->tag_indexes.find_or_insert_with(
+          tag_view,
+          [](StringView view) -> String
+          {
+            return String::From(view, get_profiler_allocator());
+          },
+          [allocator, tag_view]() -> u32
+          {
+            const auto tag_index = soul::cast<u32>(allocator->tags.size());
+            allocator->tags.push_back(get_profiler_allocator()
+                                        ->create<TrackedTag>(
+                                          String::From(tag_view, get_profiler_allocator()))
+                                        .unwrap());
+            return tag_index;
+          });
+        tracked_tag = allocator->tags[tag_index];
+        if (tag != nullptr)
+        {
+          allocator->tag_cache.insert(tag, tracked_tag);
+        }
+        return tracked_tag;
+      }
+
+      static auto capture_allocator_stats(const TrackedAllocator& allocator) -> AllocatorStats
+      {
+        AllocatorStats stats = {
+          .name  = String::From(allocator.name.cview(), get_profiler_allocator()),
+          .stats = allocator.stats.load(),
+          .tags  = Vector<TagStats>(get_profiler_allocator()),
+        };
+        for (const TrackedTag* tag : allocator.tags)
+        {
+          stats.tags.push_back(TagStats{
+            .tag   = String::From(tag->tag.cview(), get_profiler_allocator()),
+            .stats = tag->stats.load(),
+          });
+        }
+        return stats;
+      }
+
+      auto capture(const char* name) -> Snapshot
+      {
+        Snapshot snapshot = {
+          .name       = String::From(name, get_profiler_allocator()),
+          .frame      = frame_,
+          .allocators = Vector<AllocatorStats>(get_profiler_allocator()),
+        };
+        for (const TrackedAllocator* allocator : allocators_)
+        {
+          snapshot.allocators.push_back(capture_allocator_stats(*allocator));
+        }
+        return snapshot;
+      }
+
+      static void report_leak(const AllocatorStats& leak)
+      {
+        SOUL_LOG_WARN(
+          "Memory leak in allocator {} : {} allocation(s), {} bytes",
+          leak.name.c_str(),
+          leak.stats.live_count,
+          leak.stats.live_bytes);
+        for (const TagStats& tag_stats : leak.tags)
+        {
+          if (tag_stats.stats.live_count != 0)
+          {
+            SOUL_LOG_WARN(
+              "  tag {} : {} allocation(s), {} bytes",
+              tag_stats.tag.c_str(),
+              tag_stats.stats.live_count,
+              tag_stats.stats.live_bytes);
+          }
+        }
+      }
+
+      static void add_json_stats(JsonDoc* doc, JsonObjectRef object_ref, const MemStats& stats)
+      {
+        object_ref.add("live_bytes"_str, u64(stats.live_bytes));
+        object_ref.add("peak_bytes"_str, u64(stats.peak_bytes));
+        object_ref.add("live_count"_str, u64(stats.live_count));
+        object_ref.add("allocation_count"_str, u64(stats.allocation_count));
+        object_ref.add("last_frame_allocation_count"_str, u64(stats.last_frame_allocation_count));
+        object_ref.add("last_frame_allocation_bytes"_str, u64(stats.last_frame_allocation_bytes));
+        JsonArrayRef histogram_ref = doc->create_empty_array();
+        for (const u64 count : stats.size_histogram)
+        {
+          histogram_ref.append(doc->create_u64(count));
+        }
+        object_ref.add("size_histogram_log2"_str, histogram_ref);
+      }
+
+      static auto build_json(JsonDoc* doc, const Snapshot& snapshot) -> JsonObjectRef
+      {
+        JsonObjectRef snapshot_ref = doc->create_empty_object();
+        snapshot_ref.add("name"_str, snapshot.name.cview());
+        snapshot_ref.add("frame"_str, u64(snapshot.frame));
+        JsonArrayRef allocators_ref = doc->create_empty_array();
+        for (const AllocatorStats& allocator : snapshot.allocators)
+        {
+          JsonObjectRef allocator_ref = doc->create_empty_object();
+          allocator_ref.add("name"_str, allocator.name.cview());
+          add_json_stats(doc, allocator_ref, allocator.stats);
+          JsonArrayRef tags_ref = doc->create_empty_array();
+          for (const TagStats& tag_stats : allocator.tags)
+          {
+            JsonObjectRef tag_ref = doc->create_empty_object();
+            tag_ref.add("name"_str, tag_stats.tag.cview());
+            add_json_stats(doc, tag_ref, tag_stats.stats);
+            tags_ref.append(tag_ref);
+          }
+          allocator_ref.add("tags"_str, tags_ref);
+          allocators_ref.append(allocator_ref);
+        }
+        snapshot_ref.add("allocators"_str, allocators_ref);
+        return snapshot_ref;
+      }
+
+      std::mutex mutex_;
+      Vector<TrackedAllocator*> allocators_;
+      UInt64HashMap<u32> allocator_indexes_;
+      PointerCache<TrackedAllocator, ALLOCATOR_CACHE_CAPACITY> allocator_cache_;
+      Vector<Snapshot> snapshots_;
+      u64 frame_ = 0;
+    };
+
+    auto get_mem_profiler() -> MemProfiler&
+    {
+      static MemProfiler mem_profiler;
+      return mem_profiler;
+    }
+  } // namespace
+} // namespace soul::impl
+
+MemProfile::Scope::Scope()
+{
+  soul::impl::get_mem_profiler().frame();
+}
+
+MemProfile::Scope::~Scope() = default;
+
+void MemProfile::RegisterAllocator(const char* name)
+{
+  soul::impl::get_mem_profiler().register_allocator(name);
+}
+
+void MemProfile::UnregisterAllocator(const char* name)
+{
+  soul::impl::get_mem_profiler().unregister_allocator(name);
+}
+
+void MemProfile::RegisterAllocation(const char* name, const char* tag, const void* addr, usize size)
+{
+  soul::impl::get_mem_profiler().register_allocation(name, tag, addr, size);
+}
+
+void MemProfile::RegisterDeallocation(const char* name, const void* addr, usize /* size */)
+{
+  soul::impl::get_mem_profiler().register_deallocation(name, addr);
+}
+
+void MemProfile::Snapshot(const char* name)
+{
+  soul::impl::get_mem_profiler().snapshot(name);
+}
+
+void MemProfile::ReportLeaks()
+{
+  soul::impl::get_mem_profiler().report_leaks();
+}
+
+void MemProfile::DumpJson(const char* path)
+{
+  soul::impl::get_mem_profiler().dump_json(path);
+}
+
+#endif // SOUL_MEMPROFILE_CPU_BACKEND_SOUL_PROFILER
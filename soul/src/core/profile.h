@@ -89,9 +89,13 @@ struct MemProfile
 
   static void RegisterAllocator(const char* name);
   static void UnregisterAllocator(const char* name);
-  static void RegisterAllocation(const char* name, const char* tag, const void* addr, u32 size);
-  static void RegisterDeallocation(const char* name, const void* addr, u32 size);
+  static void RegisterAllocation(const char* name, const char* tag, const void* addr, usize size);
+  static void RegisterDeallocation(const char* name, const void* addr, usize size);
+  // capture the current statistics, the snapshot is written by the next DumpJson()
   static void Snapshot(const char* name);
+  // log the live allocations of every allocator, grouped by tag
+  static void ReportLeaks();
+  static void DumpJson(const char* path);
 };
 
 #  define SOUL_MEMPROFILE_REGISTER_ALLOCATOR(x)                                                    \
@@ -124,6 +128,18 @@ struct MemProfile
       MemProfile::Snapshot(x);                                                                     \
     }                                                                                              \
     while (0)
+#  define SOUL_MEMPROFILE_REPORT_LEAKS()                                                           \
+    do                                                                                             \
+    {                                                                                              \
+      MemProfile::ReportLeaks();                                                                   \
+    }                                                                                              \
+    while (0)
+#  define SOUL_MEMPROFILE_DUMP_JSON(path)                                                          \
+    do                                                                                             \
+    {                                                                                              \
+      MemProfile::DumpJson(path);                                                                  \
+    }                                                                                              \
+    while (0)
 #  define SOUL_MEMPROFILE_FRAME() MemProfile::Scope()
 #elif defined(SOUL_MEMPROFILE_CPU_BACKEND_TRACY)
 
@@ -148,8 +164,10 @@ static_assert(false, "Please enable tracy cpu profiler to use the memory profile
       TracyFreeNS(addr, SOUL_TRACY_STACKTRACE_DEPTH, allocatorName);                               \
     }                                                                                              \
     while (0)
-#  define SOUL_MEMPROFILE_SNAPSHOT(x) SOUL_NOOP
-#  define SOUL_MEMPROFILE_FRAME()     SOUL_NOOP
+#  define SOUL_MEMPROFILE_SNAPSHOT(x)     SOUL_NOOP
+#  define SOUL_MEMPROFILE_REPORT_LEAKS()  SOUL_NOOP
+#  define SOUL_MEMPROFILE_DUMP_JSON(path) SOUL_NOOP
+#  define SOUL_MEMPROFILE_FRAME()         SOUL_NOOP
 
 #else
 
@@ -158,6 +176,8 @@ static_assert(false, "Please enable tracy cpu profiler to use the memory profile
 #  define SOUL_MEMPROFILE_REGISTER_ALLOCATION(allocatorName, tag, addr, size) SOUL_NOOP
 #  define SOUL_MEMPROFILE_REGISTER_DEALLOCATION(allocatorName, addr, size)    SOUL_NOOP
 #  define SOUL_MEMPROFILE_SNAPSHOT(x)                                         SOUL_NOOP
+#  define SOUL_MEMPROFILE_REPORT_LEAKS()                                      SOUL_NOOP
+#  define SOUL_MEMPROFILE_DUMP_JSON(path)                                     SOUL_NOOP
 #  define SOUL_MEMPROFILE_FRAME()                                             SOUL_NOOP
 
 #endif // SOUL_MEMPROFILE_CPU_BACKEND
@@ -0,0 +1,444 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+#include "core/architecture.h"
+#include "core/objops.h"
+#include "core/option.h"
+#include "core/own_ref.h"
+#include "core/panic.h"
+#include "core/span.h"
+#include "core/type.h"
+#include "core/uninitialized.h"
+#include "memory/allocator.h"
+
+namespace soul
+{
+  struct RingQueueConfig
+  {
+    // NOTE(kevinyu): Producers wake the consumers that block in pop_wait(). It cost an atomic
+    // notify on every push, so queues that are only polled leave it off.
+    b8 blocking_pop = false;
+  };
+
+  /*
+    Bounded lock free queue for exactly one producer thread and one consumer thread. Capacity is
+    rounded up to a power of two and never grow, try_push() fail when the queue is full.
+
+    Head and tail live on their own cache line. Each side keep a cached copy of the other side
+    index, so it only read the other cache line when the queue look full or empty.
+  */
+  template <typename T, RingQueueConfig ConfigV = RingQueueConfig()>
+  class SpscQueue
+  {
+  public:
+    explicit SpscQueue(usize capacity, memory::Allocator* allocator = get_default_allocator())
+        : allocator_(allocator),
+          capacity_(std::bit_ceil(capacity)),
+          slots_(allocator->allocate_array<T>(capacity_))
+    {
+      SOUL_ASSERT(0, capacity > 0);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+
+    auto operator=(const SpscQueue&) -> SpscQueue& = delete;
+
+    SpscQueue(SpscQueue&&) = delete;
+
+    auto operator=(SpscQueue&&) -> SpscQueue& = delete;
+
+    ~SpscQueue()
+    {
+      const usize tail = tail_.load(std::memory_order_acquire);
+      for (usize index = head_.load(std::memory_order_relaxed); index != tail; index++)
+      {
+        destroy_at(get_slot(index));
+      }
+      allocator_->deallocate_array(slots_, capacity_);
+    }
+
+    // producer only, return false and leave value untouched if the queue is full
+    auto try_push(OwnRef<T> value) -> b8
+    {
+      const usize tail = tail_.load(std::memory_order_relaxed);
+      if (get_free_count(tail, 1) == 0)
+      {
+        return false;
+      }
+      construct_at(get_slot(tail), std::move(value));
+      publish_tail(tail + 1);
+      return true;
+    }
+
+    // producer only, move as many values as fit from the front of values, return the moved count
+    auto push_batch(Span<T*, usize> values) -> usize
+    {
+      const usize tail  = tail_.load(std::memory_order_relaxed);
+      const usize count = std::min(values.size(), get_free_count(tail, values.size()));
+      for (usize value_index = 0; value_index < count; value_index++)
+      {
+        construct_at(get_slot(tail + value_index), std::move(values[value_index]));
+      }
+      if (count != 0)
+      {
+        publish_tail(tail + count);
+      }
+      return count;
+    }
+
+    // consumer only
+    [[nodiscard]]
+    auto try_pop() -> Option<T>
+    {
+      const usize head = head_.load(std::memory_order_relaxed);
+      if (get_ready_count(head, 1) == 0)
+      {
+        return nilopt;
+      }
+      T* slot    = get_slot(head);
+      auto value = Option<T>::Some(std::move(*slot));
+      destroy_at(slot);
+      head_.store(head + 1, std::memory_order_release);
+      return value;
+    }
+
+    // consumer only, move up to dst.size() values into dst, return the moved count
+    auto pop_batch(Span<T*, usize> dst) -> usize
+    {
+      const usize head  = head_.load(std::memory_order_relaxed);
+      const usize count = std::min(dst.size(), get_ready_count(head, dst.size()));
+      for (usize value_index = 0; value_index < count; value_index++)
+      {
+        T* slot          = get_slot(head + value_index);
+        dst[value_index] = std::move(*slot);
+        destroy_at(slot);
+      }
+      if (count != 0)
+      {
+        head_.store(head + count, std::memory_order_release);
+      }
+      return count;
+    }
+
+    // consumer only, block the calling thread until a value is pushed
+    [[nodiscard]]
+    auto pop_wait() -> T
+      requires(ConfigV.blocking_pop)
+    {
+      const usize head = head_.load(std::memory_order_relaxed);
+      usize tail       = tail_.load(std::memory_order_acquire);
+      while (tail == head)
+      {
+        tail_.wait(tail, std::memory_order_acquire);
+        tail = tail_.load(std::memory_order_acquire);
+      }
+      return try_pop().unwrap();
+    }
+
+    // exact only when called from the producer or consumer thread while the other side is idle
+    [[nodiscard]]
+    auto size() const -> usize
+    {
+      const usize head = head_.load(std::memory_order_acquire);
+      return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    [[nodiscard]]
+    auto empty() const -> b8
+    {
+      return size() == 0;
+    }
+
+    [[nodiscard]]
+    auto capacity() const -> usize
+    {
+      return capacity_;
+    }
+
+  private:
+    auto get_slot(usize index) const -> T*
+    {
+      return slots_ + (index & (capacity_ - 1));
+    }
+
+    // NOTE(kevinyu): Only reload head when the cached head cannot satisfy the request.
+    auto get_free_count(usize tail, usize request_count) -> usize
+    {
+      if (capacity_ - (tail - cached_head_) < request_count)
+      {
+        cached_head_ = head_.load(std::memory_order_acquire);
+      }
+      return capacity_ - (tail - cached_head_);
+    }
+
+    auto get_ready_count(usize head, usize request_count) -> usize
+    {
+      if (cached_tail_ - head < request_count)
+      {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+      }
+      return cached_tail_ - head;
+    }
+
+    void publish_tail(usize tail)
+    {
+      tail_.store(tail, std::memory_order_release);
+      if constexpr (ConfigV.blocking_pop)
+      {
+        tail_.notify_one();
+      }
+    }
+
+    memory::Allocator* allocator_;
+    usize capacity_;
+    T* slots_;
+
+    // written by the producer
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<usize> tail_ = 0;
+    usize cached_head_                                     = 0;
+
+    // written by the consumer
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<usize> head_ = 0;
+    usize cached_tail_                                     = 0;
+  };
+
+  /*
+    Bounded lock free queue for any number of producer and consumer threads. Capacity is rounded
+    up to a power of two and never grow, try_push() fail when the queue is full.
+
+    Every cell carry a sequence number that tell whether it is ready to be written or read for the
+    current lap, so producers and consumers only contend on the tail and head index respectively.
+    Head and tail live on their own cache line.
+  */
+  template <typename T, RingQueueConfig ConfigV = RingQueueConfig()>
+  class MpmcQueue
+  {
+  public:
+    explicit MpmcQueue(usize capacity, memory::Allocator* allocator = get_default_allocator())
+        : allocator_(allocator),
+          capacity_(std::bit_ceil(std::max<usize>(capacity, 2))),
+          cells_(allocator->allocate_array<Cell>(capacity_))
+    {
+      SOUL_ASSERT(0, capacity > 0);
+      for (usize cell_index = 0; cell_index < capacity_; cell_index++)
+      {
+        construct_at(cells_ + cell_index, cell_index);
+      }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+
+    auto operator=(const MpmcQueue&) -> MpmcQueue& = delete;
+
+    MpmcQueue(MpmcQueue&&) = delete;
+
+    auto operator=(MpmcQueue&&) -> MpmcQueue& = delete;
+
+    ~MpmcQueue()
+    {
+      const usize tail = tail_.load(std::memory_order_acquire);
+      for (usize index = head_.load(std::memory_order_relaxed); index != tail; index++)
+      {
+        destroy_at(&get_cell(index).value);
+      }
+      for (usize cell_index = 0; cell_index < capacity_; cell_index++)
+      {
+        destroy_at(cells_ + cell_index);
+      }
+      allocator_->deallocate_array(cells_, capacity_);
+    }
+
+    // return false and leave value untouched if the queue is full
+    auto try_push(OwnRef<T> value) -> b8
+    {
+      const Claim claimed = claim(tail_, 0, 1);
+      if (claimed.count == 0)
+      {
+        return false;
+      }
+      Cell& cell = get_cell(claimed.index);
+      construct_at(&cell.value, std::move(value));
+      publish_cell(cell, claimed.index + 1);
+      return true;
+    }
+
+    // move as many values as fit from the front of values, return the moved count
+    auto push_batch(Span<T*, usize> values) -> usize
+    {
+      const Claim claimed = claim(tail_, 0, values.size());
+      for (usize value_index = 0; value_index < claimed.count; value_index++)
+      {
+        Cell& cell = get_cell(claimed.index + value_index);
+        construct_at(&cell.value, std::move(values[value_index]));
+        publish_cell(cell, claimed.index + value_index + 1);
+      }
+      return claimed.count;
+    }
+
+    [[nodiscard]]
+    auto try_pop() -> Option<T>
+    {
+      const Claim claimed = claim(head_, 1, 1);
+      if (claimed.count == 0)
+      {
+        return nilopt;
+      }
+      Cell& cell = get_cell(claimed.index);
+      auto value = Option<T>::Some(std::move(cell.value));
+      destroy_at(&cell.value);
+      cell.sequence.store(claimed.index + capacity_, std::memory_order_release);
+      return value;
+    }
+
+    // move up to dst.size() values into dst, return the moved count
+    auto pop_batch(Span<T*, usize> dst) -> usize
+    {
+      const Claim claimed = claim(head_, 1, dst.size());
+      for (usize value_index = 0; value_index < claimed.count; value_index++)
+      {
+        const usize index = claimed.index + value_index;
+        Cell& cell        = get_cell(index);
+        dst[value_index]  = std::move(cell.value);
+        destroy_at(&cell.value);
+        cell.sequence.store(index + capacity_, std::memory_order_release);
+      }
+      return claimed.count;
+    }
+
+    // block the calling thread until it pop a value
+    [[nodiscard]]
+    auto pop_wait() -> T
+      requires(ConfigV.blocking_pop)
+    {
+      while (true)
+      {
+        if (Option<T> value = try_pop(); value.is_some())
+        {
+          return std::move(value).unwrap();
+        }
+        // NOTE(kevinyu): Wait on the cell the next pop read. If another consumer take it first its
+        // sequence change as well, so the wait return and the pop is retried.
+        const usize head     = head_.load(std::memory_order_relaxed);
+        const Cell& cell     = get_cell(head);
+        const usize sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence == head)
+        {
+          cell.sequence.wait(sequence, std::memory_order_acquire);
+        }
+      }
+    }
+
+    // not a consistent snapshot while other threads are pushing or popping
+    [[nodiscard]]
+    auto size() const -> usize
+    {
+      const usize head = head_.load(std::memory_order_acquire);
+      const usize tail = tail_.load(std::memory_order_acquire);
+      return tail > head ? tail - head : 0;
+    }
+
+    [[nodiscard]]
+    auto empty() const -> b8
+    {
+      return size() == 0;
+    }
+
+    [[nodiscard]]
+    auto capacity() const -> usize
+    {
+      return capacity_;
+    }
+
+  private:
+    struct Cell
+    {
+      std::atomic<usize> sequence;
+
+      union
+      {
+        UninitializedDummy dummy;
+        T value;
+      };
+
+      explicit Cell(usize sequence) : sequence(sequence), dummy() {}
+
+      Cell(const Cell&) = delete;
+
+      auto operator=(const Cell&) -> Cell& = delete;
+
+      Cell(Cell&&) = delete;
+
+      auto operator=(Cell&&) -> Cell& = delete;
+
+      ~Cell() {} // NOLINT(hicpp-use-equals-default, modernize-use-equals-default)
+    };
+
+    auto get_cell(usize index) const -> Cell&
+    {
+      return cells_[index & (capacity_ - 1)];
+    }
+
+    struct Claim
+    {
+      usize index;
+      usize count;
+    };
+
+    // NOTE(kevinyu): Cell at index is ready for the caller when its sequence is index + lap_offset,
+    // 0 for producers and 1 for consumers. A smaller sequence mean the queue is full for producers
+    // or empty for consumers, a bigger one mean another caller already claimed the cell.
+    auto get_sequence_diff(usize index, usize lap_offset) const -> i64
+    {
+      const usize sequence = get_cell(index).sequence.load(std::memory_order_acquire);
+      return static_cast<i64>(sequence - (index + lap_offset));
+    }
+
+    // NOTE(kevinyu): Claim the longest run of ready cells up to max_count. Cells are released out
+    // of order by concurrent callers, so the run stop at the first cell that is not ready yet.
+    auto claim(std::atomic<usize>& position, usize lap_offset, usize max_count) -> Claim
+    {
+      usize index = position.load(std::memory_order_relaxed);
+      while (true)
+      {
+        usize count = 0;
+        i64 diff    = 0;
+        while (count < max_count && (diff = get_sequence_diff(index + count, lap_offset)) == 0)
+        {
+          count++;
+        }
+        if (count == 0)
+        {
+          if (diff < 0)
+          {
+            return {.index = index, .count = 0};
+          }
+          index = position.load(std::memory_order_relaxed);
+        } else if (position.compare_exchange_weak(
+                     index, index + count, std::memory_order_relaxed))
+        {
+          return {.index = index, .count = count};
+        }
+      }
+    }
+
+    void publish_cell(Cell& cell, usize sequence)
+    {
+      cell.sequence.store(sequence, std::memory_order_release);
+      if constexpr (ConfigV.blocking_pop)
+      {
+        cell.sequence.notify_all();
+      }
+    }
+
+    memory::Allocator* allocator_;
+    usize capacity_;
+    Cell* cells_;
+
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<usize> tail_ = 0;
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<usize> head_ = 0;
+  };
+
+} // namespace soul
@@ -147,7 +147,7 @@ namespace soul
     private:
       Metadata* metadata_iter_ = nullptr;
 
-      using IterEntryT        = std::conditional_t<IsConstV, EntryT, const EntryT>;
+      using IterEntryT        = std::conditional_t<IsConstV, const EntryT, EntryT>;
       IterEntryT* entry_iter_ = nullptr;
 
       explicit Iterator(Metadata* metadatas, IterEntryT* entries)
@@ -428,15 +428,71 @@ namespace soul
       size_++;
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
-    auto do_find_index(QueryT key) const -> usize
+    // NOTE(kevinyu): Key of the entry must not be in the table, so no key is compared. Return the
+    // slot the entry land on, it is not the last slot when a richer entry get displaced.
+    auto do_insert_unique(u64 hash_code, OwnRef<EntryT> entry_ref) -> usize
     {
-      if (SOUL_UNLIKELY(empty()))
+      EntryT entry_tmp  = std::move(entry_ref);
+      auto bucket_index = home_index_from_hash(hash_code);
+      auto metadata     = Metadata::FromHash(hash_code);
+      auto entry_index  = slot_count();
+      while (!metadatas_[bucket_index].is_empty())
       {
-        return slot_count();
+        if (metadatas_[bucket_index] < metadata)
+        {
+          if (entry_index == slot_count())
+          {
+            entry_index = bucket_index;
+          }
+          using std::swap;
+          auto& current_entry = entries_[bucket_index];
+          EntryT tmp          = std::move(current_entry);
+          current_entry       = std::move(entry_tmp);
+          entry_tmp           = std::move(tmp);
+          swap(metadata, metadatas_[bucket_index]);
+        }
+        metadata.increment_psl();
+        bucket_index++;
+        if (metadata.is_psl_overflow())
+        {
+          SOUL_PANIC("RobinTable: PSL overflow");
+        }
       }
-      const auto hash_code  = hash_fn_(key);
+      construct_at(&entries_[bucket_index], std::move(entry_tmp));
+      metadatas_[bucket_index] = metadata;
+      size_++;
+      return entry_index == slot_count() ? bucket_index : entry_index;
+    }
+
+    void grow_for_insert()
+    {
+      const auto old_slot_count = slot_count_;
+      Metadata* old_metadatas   = metadatas_;
+      EntryT* old_entries       = entries_;
+
+      shifts_--;
+      allocate_slots_from_shift();
+
+      if (old_slot_count != 0)
+      {
+        size_ = 0;
+        for (usize bucket_index = 0; bucket_index < old_slot_count; bucket_index++)
+        {
+          if (!old_metadatas[bucket_index].is_empty())
+          {
+            do_insert(std::move(old_entries[bucket_index]));
+            destroy_at(&old_entries[bucket_index]);
+          }
+        }
+        allocator_->deallocate_array(old_metadatas, old_slot_count + 1);
+        allocator_->deallocate_array(old_entries, old_slot_count);
+      }
+    }
+
+    template <typename KeyEqualFn>
+    [[nodiscard]]
+    auto do_find_index_by_hash(u64 hash_code, KeyEqualFn is_key_equal) const -> usize
+    {
       const auto home_index = home_index_from_hash(hash_code);
       auto slot_index       = home_index;
       auto metadata         = Metadata::FromHash(hash_code);
@@ -444,8 +500,7 @@ namespace soul
       {
         if (metadata == metadatas_[slot_index])
         {
-          const auto& stored_key = get_key_fn_(entries_[slot_index]);
-          if (key == borrow<QueryT>(stored_key))
+          if (is_key_equal(get_key_fn_(entries_[slot_index])))
           {
             return slot_index;
           }
@@ -456,29 +511,52 @@ namespace soul
       return slot_count();
     }
 
+    template <ts_hash_query<KeyT, HashFn> QueryT>
+    auto do_find_index(QueryT key) const -> usize
+    {
+      if (SOUL_UNLIKELY(empty()))
+      {
+        return slot_count();
+      }
+      return do_find_index_by_hash(
+        hash_fn_(key),
+        [&key](const KeyT& stored_key) -> b8
+        {
+          return is_hash_query_equal(stored_key, key);
+        });
+    }
+
     auto do_find_index(const KeyT& key) const -> usize
     {
       if (SOUL_UNLIKELY(empty()))
       {
         return slot_count();
       }
-      const auto hash_code  = hash_fn_(key);
-      const auto home_index = home_index_from_hash(hash_code);
-      auto slot_index       = home_index;
-      auto metadata         = Metadata::FromHash(hash_code);
-      while (!metadatas_[slot_index].is_empty())
+      return do_find_index_by_hash(
+        hash_fn_(key),
+        [&key](const KeyT& stored_key) -> b8
+        {
+          return key == stored_key;
+        });
+    }
+
+    template <typename KeyEqualFn, ts_fn<EntryT> Fn>
+    auto do_find_or_insert_with(u64 hash_code, KeyEqualFn is_key_equal, Fn fn) -> EntryT&
+    {
+      if (!empty())
       {
-        if (metadata == metadatas_[slot_index])
+        const auto index = do_find_index_by_hash(hash_code, is_key_equal);
+        if (index != slot_count())
         {
-          if (key == get_key_fn_(entries_[slot_index]))
-          {
-            return slot_index;
-          }
+          return entries_[index];
         }
-        metadata.increment_psl();
-        slot_index++;
       }
-      return slot_count();
+      if (size_ + 1 > capacity_)
+      {
+        grow_for_insert();
+      }
+      const auto slot_index = do_insert_unique(hash_code, fn());
+      return entries_[slot_index];
     }
 
     void do_remove_index(usize prev_bucket_index)
@@ -635,8 +713,7 @@ namespace soul
       }
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, HashFn> QueryT>
     [[nodiscard]]
     auto contains(QueryT key) const -> b8
     {
@@ -715,40 +792,40 @@ namespace soul
     {
       if (size_ + 1 > capacity_)
       {
-        const auto old_capacity   = capacity_;
-        const auto old_slot_count = slot_count_;
-        Metadata* old_metadatas   = metadatas_;
-        EntryT* old_entries       = entries_;
-
-        shifts_--;
-        allocate_slots_from_shift();
+        grow_for_insert();
+      }
+      do_insert(std::move(entry));
+    }
 
-        if (old_slot_count == 0)
+    /*
+      Return the entry of key, fn is only called to create the entry when key is not in the table.
+      The key is hashed once, and the entry returned by fn must have a key equal to key.
+    */
+    template <ts_hash_query<KeyT, HashFn> QueryT, ts_fn<EntryT> Fn>
+    auto find_or_insert_with(QueryT key, Fn fn) -> EntryT&
+    {
+      return do_find_or_insert_with(
+        hash_fn_(key),
+        [&key](const KeyT& stored_key) -> b8
         {
-          do_insert(std::move(entry));
-        } else
+          return is_hash_query_equal(stored_key, key);
+        },
+        std::move(fn));
+    }
+
+    template <ts_fn<EntryT> Fn>
+    auto find_or_insert_with(const KeyT& key, Fn fn) -> EntryT&
+    {
+      return do_find_or_insert_with(
+        hash_fn_(key),
+        [&key](const KeyT& stored_key) -> b8
         {
-          size_ = 0;
-          for (usize bucket_index = 0; bucket_index < old_slot_count; bucket_index++)
-          {
-            if (!old_metadatas[bucket_index].is_empty())
-            {
-              do_insert(std::move(old_entries[bucket_index]));
-              destroy_at(&old_entries[bucket_index]);
-            }
-          }
-          do_insert(std::move(entry));
-          allocator_->deallocate_array(old_metadatas, slot_count_ + 1);
-          allocator_->deallocate_array(old_entries, old_slot_count);
-        }
-      } else
-      {
-        do_insert(std::move(entry));
-      }
+          return key == stored_key;
+        },
+        std::move(fn));
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, HashFn> QueryT>
     auto find(QueryT key) -> iterator
     {
       if (slot_count_ == 0)
@@ -759,8 +836,7 @@ namespace soul
       return iterator(metadatas_ + index, entries_ + index);
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, HashFn> QueryT>
     auto find(QueryT key) const -> const_iterator
     {
       if (slot_count_ == 0)
@@ -791,8 +867,7 @@ namespace soul
       return const_iterator(metadatas_ + index, entries_ + index);
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, HashFn> QueryT>
     [[nodiscard]]
     auto entry_ref(QueryT key) -> EntryT&
     {
@@ -801,8 +876,7 @@ namespace soul
       return entries_[index];
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, HashFn> QueryT>
     [[nodiscard]]
     auto entry_ref(QueryT key) const -> const EntryT&
     {
@@ -827,8 +901,7 @@ namespace soul
       return entries_[index];
     }
 
-    template <typename QueryT>
-      requires(BorrowTrait<KeyT, QueryT>::available)
+    template <ts_hash_query<KeyT, HashFn> QueryT>
     void remove(QueryT key)
     {
       if (slot_count() == 0)
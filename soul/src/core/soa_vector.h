@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <utility>
 
@@ -13,11 +15,21 @@
 
 namespace soul
 {
-  template <ts_tuple TupleT, memory::allocator_type AllocatorT = memory::Allocator>
+  struct SoaVectorConfig
+  {
+    // NOTE(kevinyu): Minimum alignment of every column, in bytes. Set it to the cache line size
+    // to keep columns from sharing a cache line and to allow aligned SIMD loads on the columns.
+    usize column_alignment = 0;
+  };
+
+  template <
+    ts_tuple TupleT,
+    memory::allocator_type AllocatorT = memory::Allocator,
+    SoaVectorConfig ConfigV           = SoaVectorConfig()>
   class SoaVector;
 
-  template <memory::allocator_type AllocatorT, typename... Ts>
-  class SoaVector<Tuple<Ts...>, AllocatorT>
+  template <memory::allocator_type AllocatorT, SoaVectorConfig ConfigV, typename... Ts>
+  class SoaVector<Tuple<Ts...>, AllocatorT, ConfigV>
   {
   public:
     using structure_type        = Tuple<Ts...>;
@@ -29,6 +41,18 @@ namespace soul
     static constexpr auto ELEMENT_COUNT = structure_type::ELEMENT_COUNT;
     static constexpr auto GROWTH_FACTOR = 2;
 
+    // we align each array to at least the same alignment guaranteed by malloc
+    static constexpr auto COLUMN_ALIGNMENTS = Array<usize, ELEMENT_COUNT>::TransformIndex(
+      [](usize idx) -> usize
+      {
+        const auto element_alignment = structure_type::ELEMENT_ALIGNMENTS[idx];
+        return std::max({alignof(std::max_align_t), element_alignment, ConfigV.column_alignment});
+      });
+
+    static_assert(
+      std::has_single_bit(std::max<usize>(ConfigV.column_alignment, 1)),
+      "Column alignment must be a power of two");
+
   private:
     using offset_array_type = Array<usize, ELEMENT_COUNT>;
 
@@ -78,10 +102,9 @@ namespace soul
     {
       if (size_ == capacity_)
       {
-        const auto new_capacity = GetNewCapacity(capacity_);
-        constexpr usize alignment =
-          std::max(alignof(std::max_align_t), std::ranges::max(structure_type::ELEMENT_ALIGNMENTS));
-        const usize size_needed = GetNeededSize(new_capacity);
+        const auto new_capacity   = GetNewCapacity(capacity_);
+        constexpr usize alignment = std::ranges::max(COLUMN_ALIGNMENTS);
+        const usize size_needed   = GetNeededSize(new_capacity);
 
         void* new_raw_buffer      = allocator_->allocate(size_needed, alignment);
         auto const old_raw_buffer = structure_buffers_.template ref<0>();
@@ -239,13 +262,7 @@ namespace soul
           return element_size * capacity;
         });
 
-      // we align each array to at least the same alignment guaranteed by malloc
-      constexpr auto alignments = Array<usize, ELEMENT_COUNT>::TransformIndex(
-        [](usize idx) -> usize
-        {
-          const auto element_alignment = structure_type::ELEMENT_ALIGNMENTS[idx];
-          return std::max(alignof(std::max_align_t), element_alignment);
-        });
+      constexpr auto& alignments = COLUMN_ALIGNMENTS;
 
       Array<usize, ELEMENT_COUNT> offsets;
       offsets[0] = 0;
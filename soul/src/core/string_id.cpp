@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "core/concurrent_hash_map.h"
+#include "core/hash.h"
+#include "core/mutex.h"
+#include "core/string_id.h"
+#include "memory/allocators/malloc_allocator.h"
+
+namespace soul
+{
+  namespace
+  {
+    // NOTE(kevinyu): Entries and their characters are bump allocated from blocks that are only
+    // freed when the table is destroyed, so StringId never dangle while the program run.
+    class StringIdTable
+    {
+    public:
+      StringIdTable() : allocator_("String id allocator"_str), map_(&allocator_) {}
+
+      StringIdTable(const StringIdTable&) = delete;
+
+      auto operator=(const StringIdTable&) -> StringIdTable& = delete;
+
+      StringIdTable(StringIdTable&&) = delete;
+
+      auto operator=(StringIdTable&&) -> StringIdTable& = delete;
+
+      ~StringIdTable()
+      {
+        while (block_ != nullptr)
+        {
+          Block* next = block_->next;
+          allocator_.deallocate(block_);
+          block_ = next;
+        }
+      }
+
+      auto find(StringView str) const -> const impl::StringIdEntry*
+      {
+        const impl::StringIdEntry* const* entry = map_.find(str);
+        return entry != nullptr ? *entry : nullptr;
+      }
+
+      auto intern(StringView str) -> const impl::StringIdEntry*
+      {
+        std::lock_guard guard(mutex_);
+        if (const impl::StringIdEntry* entry = find(str); entry != nullptr)
+        {
+          return entry;
+        }
+
+        // NOTE(kevinyu): The characters are stored right after the entry.
+        void* addr = bump(sizeof(impl::StringIdEntry) + str.size() + 1);
+        char* data = soul::cast<char*>(soul::cast<byte*>(addr) + sizeof(impl::StringIdEntry));
+        std::copy_n(str.data(), str.size(), data);
+        data[str.size()] = '\0';
+        const auto* entry =
+          new (addr) impl::StringIdEntry{.hash_code = hash(str), .data = data, .size = str.size()};
+
+        // NOTE(kevinyu): The key must point to the interned characters, not to the caller string.
+        return map_.find_or_create(StringView(data, str.size()), [entry]() { return entry; });
+      }
+
+    private:
+      struct Block
+      {
+        Block* next;
+        usize size;
+      };
+
+      static constexpr usize BLOCK_SIZE = 16 * ONE_KILOBYTE;
+
+      auto bump(usize size) -> void*
+      {
+        static constexpr usize ALIGNMENT = alignof(impl::StringIdEntry);
+        offset_                          = (offset_ + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        if (block_ == nullptr || offset_ + size > block_->size)
+        {
+          const usize block_size = std::max(BLOCK_SIZE, sizeof(Block) + size);
+          void* block_addr       = allocator_.allocate(block_size, alignof(Block));
+          block_                 = new (block_addr) Block{.next = block_, .size = block_size};
+          offset_                = sizeof(Block);
+        }
+        void* addr  = soul::cast<byte*>(block_) + offset_;
+        offset_    += size;
+        return addr;
+      }
+
+      memory::MallocAllocator allocator_;
+      ConcurrentHashMap<StringView, const impl::StringIdEntry*> map_;
+      Mutex mutex_;
+      Block* block_ = nullptr;
+      usize offset_ = 0;
+    };
+
+    auto get_string_id_table() -> StringIdTable&
+    {
+      static StringIdTable table;
+      return table;
+    }
+  } // namespace
+
+  auto StringId::From(StringView str) -> StringId
+  {
+    if (str.empty())
+    {
+      return StringId();
+    }
+    StringIdTable& table = get_string_id_table();
+    if (const impl::StringIdEntry* entry = table.find(str); entry != nullptr)
+    {
+      return StringId(entry);
+    }
+    return StringId(table.intern(str));
+  }
+
+} // namespace soul
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <format>
+
+#include "core/comp_str.h"
+#include "core/string_view.h"
+#include "core/type.h"
+
+namespace soul
+{
+  namespace impl
+  {
+    struct StringIdEntry
+    {
+      u64 hash_code;
+      const char* data;
+      usize size;
+    };
+
+    inline constexpr StringIdEntry EMPTY_STRING_ID_ENTRY = {0, "", 0};
+  } // namespace impl
+
+  /*
+    Interned string. Every StringId with the same content point to the same entry of a global
+    table, so comparison is a pointer comparison and the hash is computed once when the string is
+    interned. Interning is thread safe, entries live until the program exit.
+
+    Use "name"_sid for literal, it is interned the first time the expression is evaluated and only
+    cost a static load after that.
+  */
+  class StringId
+  {
+  public:
+    constexpr StringId() = default;
+
+    [[nodiscard]]
+    static auto From(StringView str) -> StringId;
+
+    [[nodiscard]]
+    constexpr auto cview() const -> StringView
+    {
+      return StringView(entry_->data, entry_->size);
+    }
+
+    [[nodiscard]]
+    constexpr auto c_str() const -> const char*
+    {
+      return entry_->data;
+    }
+
+    [[nodiscard]]
+    constexpr auto size() const -> usize
+    {
+      return entry_->size;
+    }
+
+    [[nodiscard]]
+    constexpr auto empty() const -> b8
+    {
+      return entry_->size == 0;
+    }
+
+    [[nodiscard]]
+    constexpr auto hash_code() const -> u64
+    {
+      return entry_->hash_code;
+    }
+
+    friend constexpr auto operator==(StringId lhs, StringId rhs) -> b8
+    {
+      return lhs.entry_ == rhs.entry_;
+    }
+
+    friend constexpr void soul_op_hash_combine(auto& hasher, StringId id)
+    {
+      hasher.combine_u64(id.hash_code());
+    }
+
+  private:
+    explicit constexpr StringId(const impl::StringIdEntry* entry) : entry_(entry) {}
+
+    const impl::StringIdEntry* entry_ = &impl::EMPTY_STRING_ID_ENTRY;
+  };
+
+  namespace impl
+  {
+    template <usize SizeV>
+    struct StringIdLiteral
+    {
+      char data[SizeV];
+
+      consteval StringIdLiteral(const char (&literal)[SizeV]) // NOLINT(hicpp-explicit-conversions)
+      {
+        std::copy_n(literal, SizeV, data);
+      }
+    };
+  } // namespace impl
+
+  inline namespace literals
+  {
+    template <impl::StringIdLiteral LiteralV>
+    [[nodiscard]]
+    auto operator""_sid() -> StringId
+    {
+      static const StringId id =
+        StringId::From(StringView(LiteralV.data, sizeof(LiteralV.data) - 1));
+      return id;
+    }
+  } // namespace literals
+
+} // namespace soul
+
+template <>
+struct std::formatter<soul::StringId> : std::formatter<std::string_view>
+{
+  auto format(soul::StringId id, std::format_context& ctx) const
+  {
+    return std::formatter<std::string_view>::format(std::string_view(id.c_str(), id.size()), ctx);
+  }
+};
@@ -0,0 +1,931 @@
+#pragma once
+
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define SOUL_SWISS_TABLE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define SOUL_SWISS_TABLE_NEON
+#endif
+
+#include "core/builtins.h"
+#include "core/compiler.h"
+#include "core/config.h"
+#include "core/hash.h"
+#include "core/meta.h"
+#include "core/objops.h"
+#include "core/panic.h"
+#include "core/span.h"
+#include "memory/allocator.h"
+
+namespace soul
+{
+  namespace impl
+  {
+    // NOTE(kevinyu): Full slot store the low 7 bits of its hash code, so every special value is
+    // negative. Empty and deleted are the only values smaller than sentinel.
+    using SwissTableControl = i8;
+
+    static constexpr SwissTableControl SWISS_TABLE_CONTROL_EMPTY    = -128;
+    static constexpr SwissTableControl SWISS_TABLE_CONTROL_DELETED  = -2;
+    static constexpr SwissTableControl SWISS_TABLE_CONTROL_SENTINEL = -1;
+
+    // NOTE(kevinyu): Sixteen control bytes that are matched at once. Bit i of a mask is set when
+    // the i-th control byte of the group match.
+    class SwissTableGroup
+    {
+    public:
+      using Mask = u32;
+
+      static constexpr usize WIDTH = 16;
+
+      explicit SwissTableGroup(const SwissTableControl* controls)
+      {
+#if defined(SOUL_SWISS_TABLE_SSE2)
+        controls_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(controls));
+#elif defined(SOUL_SWISS_TABLE_NEON)
+        controls_ = vld1q_s8(controls);
+#else
+        memcpy(controls_, controls, WIDTH);
+#endif
+      }
+
+      [[nodiscard]]
+      auto match(SwissTableControl control) const -> Mask
+      {
+#if defined(SOUL_SWISS_TABLE_SSE2)
+        return soul::cast<Mask>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(control), controls_)));
+#elif defined(SOUL_SWISS_TABLE_NEON)
+        return to_mask(vceqq_s8(vdupq_n_s8(control), controls_));
+#else
+        Mask mask = 0;
+        for (usize index = 0; index < WIDTH; index++)
+        {
+          mask |= Mask(controls_[index] == control) << index;
+        }
+        return mask;
+#endif
+      }
+
+      [[nodiscard]]
+      auto match_empty() const -> Mask
+      {
+        return match(SWISS_TABLE_CONTROL_EMPTY);
+      }
+
+      [[nodiscard]]
+      auto match_empty_or_deleted() const -> Mask
+      {
+#if defined(SOUL_SWISS_TABLE_SSE2)
+        return soul::cast<Mask>(_mm_movemask_epi8(
+          _mm_cmpgt_epi8(_mm_set1_epi8(SWISS_TABLE_CONTROL_SENTINEL), controls_)));
+#elif defined(SOUL_SWISS_TABLE_NEON)
+        return to_mask(vcltq_s8(controls_, vdupq_n_s8(SWISS_TABLE_CONTROL_SENTINEL)));
+#else
+        Mask mask = 0;
+        for (usize index = 0; index < WIDTH; index++)
+        {
+          mask |= Mask(controls_[index] < SWISS_TABLE_CONTROL_SENTINEL) << index;
+        }
+        return mask;
+#endif
+      }
+
+    private:
+#if defined(SOUL_SWISS_TABLE_SSE2)
+      __m128i controls_;
+#elif defined(SOUL_SWISS_TABLE_NEON)
+      int8x16_t controls_;
+
+      // NOTE(kevinyu): NEON has no movemask, keep one bit per lane and add each half horizontally.
+      static auto to_mask(uint8x16_t lanes) -> Mask
+      {
+        static constexpr u8 LANE_BITS[WIDTH] = {
+          1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+        const uint8x16_t bits = vandq_u8(lanes, vld1q_u8(LANE_BITS));
+        return Mask(vaddv_u8(vget_low_u8(bits))) | (Mask(vaddv_u8(vget_high_u8(bits))) << 8);
+      }
+#else
+      SwissTableControl controls_[WIDTH];
+#endif
+    };
+
+    // use for default no allocation state hash table
+    static auto SWISS_TABLE_CONTROL_DUMMY_SENTINEL = SWISS_TABLE_CONTROL_SENTINEL; // NOLINT
+
+  } // namespace impl
+
+  struct SwissTableConfig
+  {
+    f32 load_factor = 0.875f;
+  };
+
+  /*
+    Open addressing hash table that probe a group of sixteen control bytes at once with SSE2 or
+    NEON, like Abseil's Swiss table. The control byte of a full slot store seven bits of the hash
+    code, so most of the non matching slots are rejected without touching the entries. It has the
+    same interface as RobinTable and can be used as the backend of HashMap.
+
+    The slot count is always a power of two minus one. The controls are followed by a sentinel and
+    a copy of the first WIDTH - 1 controls, so a group can be loaded at any slot without wrapping.
+    Removed slots become tombstones unless no probe could have passed through them, tombstones are
+    dropped when the table is rehashed.
+  */
+  template <
+    typename KeyT,
+    typename EntryT,
+    typename GetKeyFn,
+    typename HashFn                   = soul::HashOp<KeyT>,
+    SwissTableConfig ConfigV          = SwissTableConfig(),
+    memory::allocator_type AllocatorT = memory::Allocator>
+  class SwissTable
+  {
+    using Control = impl::SwissTableControl;
+    using Group   = impl::SwissTableGroup;
+
+    static_assert(
+      ConfigV.load_factor > 0.0f && ConfigV.load_factor < 1.0f,
+      "Load factor must leave at least one empty slot");
+
+  public:
+    template <b8 IsConstV>
+    class Iterator
+    {
+    private:
+      const Control* control_iter_ = nullptr;
+
+      using IterEntryT        = std::conditional_t<IsConstV, const EntryT, EntryT>;
+      IterEntryT* entry_iter_ = nullptr;
+
+      explicit Iterator(const Control* controls, IterEntryT* entries)
+          : control_iter_(controls), entry_iter_(entries)
+      {
+        while (*control_iter_ < impl::SWISS_TABLE_CONTROL_SENTINEL)
+        {
+          control_iter_++;
+          entry_iter_++;
+        }
+        if (*control_iter_ == impl::SWISS_TABLE_CONTROL_SENTINEL)
+        {
+          *this = Iterator();
+        }
+      }
+
+      friend class SwissTable;
+
+      template <b8 IsOtherConstV>
+      friend class Iterator;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = IterEntryT;
+      using reference         = IterEntryT&;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = IterEntryT*;
+
+      explicit Iterator() = default;
+
+      template <b8 IsOtherConstV>
+        requires(IsConstV && !IsOtherConstV)
+      explicit Iterator(const Iterator<IsOtherConstV>& other) noexcept
+          : control_iter_(other.control_iter_), entry_iter_(other.entry_iter_)
+      {
+      }
+
+      auto operator++() noexcept -> Iterator&
+      {
+        do
+        {
+          ++control_iter_;
+          ++entry_iter_;
+        }
+        while (*control_iter_ < impl::SWISS_TABLE_CONTROL_SENTINEL);
+        if (*control_iter_ == impl::SWISS_TABLE_CONTROL_SENTINEL)
+        {
+          *this = Iterator();
+        }
+        return *this;
+      }
+
+      auto operator++(int) noexcept -> Iterator
+      {
+        Iterator iter_copy = *this;
+        ++*this;
+        return iter_copy;
+      }
+
+      auto operator*() const noexcept -> reference
+      {
+        return *entry_iter_;
+      }
+
+      auto operator->() const noexcept -> pointer
+      {
+        return entry_iter_;
+      }
+
+      template <b8 IsOtherConstV>
+      auto operator==(Iterator<IsOtherConstV> const& other) const noexcept -> b8
+      {
+        return entry_iter_ == other.entry_iter_;
+      }
+    };
+
+    using value_type      = EntryT;
+    using key_type        = KeyT;
+    using reference       = EntryT&;
+    using const_reference = const EntryT&;
+    using pointer         = EntryT*;
+    using const_pointer   = const EntryT*;
+    using iterator        = Iterator<false>;
+    using const_iterator  = Iterator<true>;
+    using sentinel        = iterator;
+    using const_sentinel  = const_iterator;
+
+  private:
+    static constexpr usize CLONED_CONTROL_COUNT = Group::WIDTH - 1;
+    static constexpr usize MIN_SLOT_COUNT       = Group::WIDTH - 1;
+    static constexpr u64 HASH_TAG_BIT_COUNT     = 7;
+    static constexpr u64 HASH_TAG_MASK          = (u64(1) << HASH_TAG_BIT_COUNT) - 1;
+
+    NotNull<AllocatorT*> allocator_ = nullptr;
+    usize slot_count_               = 0;
+    usize capacity_                 = 0;
+    usize size_                     = 0;
+    usize growth_left_              = 0;
+
+    Control* controls_ = &impl::SWISS_TABLE_CONTROL_DUMMY_SENTINEL;
+    EntryT* entries_   = nullptr;
+
+    SOUL_NO_UNIQUE_ADDRESS HashFn hash_fn_;
+    SOUL_NO_UNIQUE_ADDRESS GetKeyFn get_key_fn_;
+
+    SwissTable(const SwissTable& other)
+        : allocator_(other.allocator_),
+          slot_count_(other.slot_count_),
+          capacity_(other.capacity_),
+          size_(other.size_),
+          growth_left_(other.growth_left_)
+    {
+      if (slot_count_ != 0)
+      {
+        controls_ = allocator_->template allocate_array<Control>(control_count());
+        entries_  = allocator_->template allocate_array<EntryT>(slot_count_);
+        memcpy(controls_, other.controls_, sizeof(Control) * control_count());
+        duplicate_entries(other);
+      }
+    }
+
+    auto operator=(const SwissTable& other) -> SwissTable&
+    {
+      SwissTable tmp(other);
+      swap(tmp, *this);
+      return *this;
+    }
+
+    struct Construct
+    {
+      struct WithCapacity
+      {
+      };
+
+      struct From
+      {
+      };
+
+      static constexpr auto with_capacity = WithCapacity{};
+      static constexpr auto from          = From{};
+    };
+
+    SwissTable(Construct::WithCapacity /* tag */, usize min_capacity, AllocatorT& allocator)
+        : allocator_(&allocator)
+    {
+      allocate_slots(ComputeSlotCountForCapacity(min_capacity));
+    }
+
+    template <std::ranges::input_range RangeT>
+    SwissTable(Construct::From /* tag */, RangeT&& range, AllocatorT& allocator)
+        : allocator_(&allocator)
+    {
+      if constexpr (std::ranges::sized_range<RangeT> || std::ranges::forward_range<RangeT>)
+      {
+        const auto size = usize(std::ranges::distance(range));
+        reserve(size);
+      }
+      const auto last = std::ranges::end(range);
+      for (auto it = std::ranges::begin(range); it != last; it++)
+      {
+        insert(*it);
+      }
+    }
+
+    [[nodiscard]]
+    auto slot_count() const -> usize
+    {
+      return slot_count_;
+    }
+
+    [[nodiscard]]
+    auto control_count() const -> usize
+    {
+      return slot_count_ + 1 + CLONED_CONTROL_COUNT;
+    }
+
+    [[nodiscard]]
+    static constexpr auto GetHashTag(u64 hash_code) -> Control
+    {
+      return Control(hash_code & HASH_TAG_MASK);
+    }
+
+    [[nodiscard]]
+    auto get_probe_start(u64 hash_code) const -> usize
+    {
+      return (hash_code >> HASH_TAG_BIT_COUNT) & slot_count_;
+    }
+
+    [[nodiscard]]
+    static constexpr auto ComputeCapacity(usize slot_count) -> usize
+    {
+      return static_cast<usize>(static_cast<f32>(slot_count) * ConfigV.load_factor);
+    }
+
+    [[nodiscard]]
+    static constexpr auto ComputeSlotCountForCapacity(usize min_capacity) -> usize
+    {
+      usize slot_count = MIN_SLOT_COUNT;
+      while (ComputeCapacity(slot_count) < min_capacity)
+      {
+        slot_count = slot_count * 2 + 1;
+      }
+      return slot_count;
+    }
+
+    void allocate_slots(usize slot_count)
+    {
+      slot_count_  = slot_count;
+      capacity_    = ComputeCapacity(slot_count);
+      growth_left_ = capacity_;
+
+      controls_ = allocator_->template allocate_array<Control>(control_count());
+      init_controls();
+      entries_ = allocator_->template allocate_array<EntryT>(slot_count_);
+    }
+
+    void init_controls()
+    {
+      memset(controls_, impl::SWISS_TABLE_CONTROL_EMPTY, sizeof(Control) * control_count());
+      controls_[slot_count_] = impl::SWISS_TABLE_CONTROL_SENTINEL;
+    }
+
+    // NOTE(kevinyu): Write the cloned control after the sentinel too when index is one of the
+    // first CLONED_CONTROL_COUNT slots, otherwise both writes go to the same control.
+    void set_control(usize index, Control control)
+    {
+      controls_[index] = control;
+      controls_[((index - CLONED_CONTROL_COUNT) & slot_count_) + CLONED_CONTROL_COUNT] = control;
+    }
+
+    void rehash(usize new_slot_count)
+    {
+      const auto old_slot_count    = slot_count_;
+      const auto old_control_count = control_count();
+      Control* old_controls        = controls_;
+      EntryT* old_entries          = entries_;
+
+      allocate_slots(new_slot_count);
+      for (usize slot_index = 0; slot_index < old_slot_count; slot_index++)
+      {
+        if (old_controls[slot_index] >= 0)
+        {
+          const auto hash_code = hash_fn_(get_key_fn_(old_entries[slot_index]));
+          const auto new_index = find_first_non_full(hash_code);
+          construct_at(&entries_[new_index], std::move(old_entries[slot_index]));
+          destroy_at(&old_entries[slot_index]);
+          set_control(new_index, GetHashTag(hash_code));
+        }
+      }
+      growth_left_ -= size_;
+
+      if (old_slot_count != 0)
+      {
+        allocator_->deallocate_array(old_controls, old_control_count);
+        allocator_->deallocate_array(old_entries, old_slot_count);
+      }
+    }
+
+    // NOTE(kevinyu): Table that is filled mostly by tombstones is rehashed at the same size.
+    void grow_for_insert()
+    {
+      if (slot_count_ == 0)
+      {
+        rehash(MIN_SLOT_COUNT);
+      } else if (size_ < capacity_ / 2)
+      {
+        rehash(slot_count_);
+      } else
+      {
+        rehash(slot_count_ * 2 + 1);
+      }
+    }
+
+    [[nodiscard]]
+    auto find_first_non_full(u64 hash_code) const -> usize
+    {
+      usize position = get_probe_start(hash_code);
+      usize stride   = 0;
+      while (true)
+      {
+        const Group::Mask mask = Group(controls_ + position).match_empty_or_deleted();
+        if (mask != 0)
+        {
+          return (position + std::countr_zero(mask)) & slot_count_;
+        }
+        stride   += Group::WIDTH;
+        position  = (position + stride) & slot_count_;
+      }
+    }
+
+    template <typename KeyEqualFn>
+    [[nodiscard]]
+    auto do_find_index_by_hash(u64 hash_code, KeyEqualFn is_key_equal) const -> usize
+    {
+      const Control hash_tag = GetHashTag(hash_code);
+      usize position         = get_probe_start(hash_code);
+      usize stride           = 0;
+      while (true)
+      {
+        const Group group(controls_ + position);
+        Group::Mask mask = group.match(hash_tag);
+        while (mask != 0)
+        {
+          const usize slot_index = (position + std::countr_zero(mask)) & slot_count_;
+          if (SOUL_LIKELY(is_key_equal(get_key_fn_(entries_[slot_index]))))
+          {
+            return slot_index;
+          }
+          mask &= mask - 1;
+        }
+        if (group.match_empty() != 0)
+        {
+          return slot_count();
+        }
+        stride   += Group::WIDTH;
+        position  = (position + stride) & slot_count_;
+      }
+    }
+
+    template <ts_hash_query<KeyT, HashFn> QueryT>
+    auto do_find_index(QueryT key) const -> usize
+    {
+      if (SOUL_UNLIKELY(empty()))
+      {
+        return slot_count();
+      }
+      return do_find_index_by_hash(
+        hash_fn_(key),
+        [&key](const KeyT& stored_key) -> b8
+        {
+          return is_hash_query_equal(stored_key, key);
+        });
+    }
+
+    auto do_find_index(const KeyT& key) const -> usize
+    {
+      if (SOUL_UNLIKELY(empty()))
+      {
+        return slot_count();
+      }
+      return do_find_index_by_hash(
+        hash_fn_(key),
+        [&key](const KeyT& stored_key) -> b8
+        {
+          return key == stored_key;
+        });
+    }
+
+    void do_insert(OwnRef<EntryT> entry_ref)
+    {
+      EntryT entry_tmp     = std::move(entry_ref);
+      const auto hash_code = hash_fn_(get_key_fn_(entry_tmp));
+      if (!empty())
+      {
+        const auto index = do_find_index_by_hash(
+          hash_code,
+          [this, &entry_tmp](const KeyT& stored_key) -> b8
+          {
+            return get_key_fn_(entry_tmp) == stored_key;
+          });
+        if (index != slot_count())
+        {
+          entries_[index] = std::move(entry_tmp);
+          return;
+        }
+      }
+
+      do_insert_unique(hash_code, std::move(entry_tmp));
+    }
+
+    // NOTE(kevinyu): Key of the entry must not be in the table. Return the slot of the entry.
+    auto do_insert_unique(u64 hash_code, EntryT&& entry) -> usize
+    {
+      if (growth_left_ == 0)
+      {
+        grow_for_insert();
+      }
+      const auto slot_index = find_first_non_full(hash_code);
+      if (controls_[slot_index] == impl::SWISS_TABLE_CONTROL_EMPTY)
+      {
+        growth_left_--;
+      }
+      construct_at(&entries_[slot_index], std::move(entry));
+      set_control(slot_index, GetHashTag(hash_code));
+      size_++;
+      return slot_index;
+    }
+
+    template <typename KeyEqualFn, ts_fn<EntryT> Fn>
+    auto do_find_or_insert_with(u64 hash_code, KeyEqualFn is_key_equal, Fn fn) -> EntryT&
+    {
+      if (!empty())
+      {
+        const auto index = do_find_index_by_hash(hash_code, is_key_equal);
+        if (index != slot_count())
+        {
+          return entries_[index];
+        }
+      }
+      // NOTE(kevinyu): do_insert_unique can grow the table, entries_ must be read after it.
+      const auto slot_index = do_insert_unique(hash_code, fn());
+      return entries_[slot_index];
+    }
+
+    void do_remove_index(usize slot_index)
+    {
+      if (slot_index == slot_count())
+      {
+        return;
+      }
+      destroy_at(&entries_[slot_index]);
+      size_--;
+
+      // NOTE(kevinyu): If there is no window of WIDTH full slots around the removed slot, no probe
+      // has passed through it, so it can be marked empty instead of deleted.
+      const usize index_before       = (slot_index - Group::WIDTH) & slot_count_;
+      const Group::Mask empty_before = Group(controls_ + index_before).match_empty();
+      const Group::Mask empty_after  = Group(controls_ + slot_index).match_empty();
+      const b8 was_never_full =
+        empty_before != 0 && empty_after != 0 &&
+        usize(std::countr_zero(empty_after) + std::countl_zero(u16(empty_before))) < Group::WIDTH;
+      if (was_never_full)
+      {
+        set_control(slot_index, impl::SWISS_TABLE_CONTROL_EMPTY);
+        growth_left_++;
+      } else
+      {
+        set_control(slot_index, impl::SWISS_TABLE_CONTROL_DELETED);
+      }
+    }
+
+    void duplicate_entries(const SwissTable& other)
+    {
+      if constexpr (ts_copy<EntryT>)
+      {
+        memcpy(entries_, other.entries_, sizeof(EntryT) * other.slot_count_);
+      } else if constexpr (ts_clone<EntryT>)
+      {
+        for (usize slot_index = 0; slot_index < other.slot_count(); ++slot_index)
+        {
+          if (controls_[slot_index] >= 0)
+          {
+            clone_at(entries_ + slot_index, other.entries_[slot_index]);
+          }
+        }
+      } else
+      {
+        for (usize slot_index = 0; slot_index < other.slot_count(); ++slot_index)
+        {
+          if (controls_[slot_index] >= 0)
+          {
+            construct_at(entries_ + slot_index, other.entries_[slot_index]);
+          }
+        }
+      }
+    }
+
+    void destruct_entries()
+    {
+      if constexpr (can_nontrivial_destruct_v<EntryT>)
+      {
+        for (usize slot_index = 0; slot_index < slot_count(); ++slot_index)
+        {
+          if (controls_[slot_index] >= 0)
+          {
+            destroy_at(&entries_[slot_index]);
+          }
+        }
+      }
+    }
+
+  public:
+    explicit SwissTable(AllocatorT& allocator = *get_default_allocator()) : allocator_(&allocator)
+    {
+    }
+
+    SwissTable(SwissTable&& other) noexcept
+        : allocator_(other.allocator_),
+          slot_count_(std::exchange(other.slot_count_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)),
+          size_(std::exchange(other.size_, 0)),
+          growth_left_(std::exchange(other.growth_left_, 0)),
+          controls_(std::exchange(other.controls_, &impl::SWISS_TABLE_CONTROL_DUMMY_SENTINEL)),
+          entries_(std::exchange(other.entries_, nullptr))
+    {
+    }
+
+    auto operator=(SwissTable&& other) noexcept -> SwissTable&
+    {
+      auto tmp = SwissTable(std::move(other));
+      swap(tmp, *this);
+      return *this;
+    }
+
+    ~SwissTable()
+    {
+      if (slot_count_ != 0)
+      {
+        destruct_entries();
+        allocator_->deallocate_array(controls_, control_count());
+        allocator_->deallocate_array(entries_, slot_count_);
+      }
+    }
+
+    static auto WithCapacity(usize min_capacity, AllocatorT& allocator = *get_default_allocator())
+      -> SwissTable
+    {
+      return SwissTable(Construct::with_capacity, min_capacity, allocator);
+    }
+
+    template <std::ranges::input_range RangeT>
+    static auto From(RangeT&& range, AllocatorT& allocator = *get_default_allocator()) -> SwissTable
+    {
+      return SwissTable(Construct::from, std::forward<RangeT>(range), allocator);
+    }
+
+    [[nodiscard]]
+    auto clone() const -> SwissTable
+    {
+      return SwissTable(*this);
+    }
+
+    void clone_from(const SwissTable& other)
+    {
+      *this = other;
+    }
+
+    friend void swap(SwissTable& lhs, SwissTable& rhs)
+    {
+      using std::swap;
+      swap(lhs.allocator_, rhs.allocator_);
+      swap(lhs.slot_count_, rhs.slot_count_);
+      swap(lhs.capacity_, rhs.capacity_);
+      swap(lhs.size_, rhs.size_);
+      swap(lhs.growth_left_, rhs.growth_left_);
+      swap(lhs.controls_, rhs.controls_);
+      swap(lhs.entries_, rhs.entries_);
+    }
+
+    void clear()
+    {
+      if (slot_count_ != 0)
+      {
+        destruct_entries();
+        init_controls();
+        size_        = 0;
+        growth_left_ = capacity_;
+      }
+    }
+
+    void cleanup()
+    {
+      if (slot_count_ != 0)
+      {
+        destruct_entries();
+        allocator_->deallocate_array(controls_, control_count());
+        allocator_->deallocate_array(entries_, slot_count_);
+
+        slot_count_  = 0;
+        capacity_    = 0;
+        size_        = 0;
+        growth_left_ = 0;
+        controls_    = &impl::SWISS_TABLE_CONTROL_DUMMY_SENTINEL;
+        entries_     = nullptr;
+      }
+    }
+
+    template <ts_hash_query<KeyT, HashFn> QueryT>
+    [[nodiscard]]
+    auto contains(QueryT key) const -> b8
+    {
+      return do_find_index(key) != slot_count();
+    }
+
+    [[nodiscard]]
+    auto contains(const KeyT& key) const -> b8
+    {
+      return do_find_index(key) != slot_count();
+    }
+
+    [[nodiscard]]
+    auto size() const -> usize
+    {
+      return size_;
+    }
+
+    [[nodiscard]]
+    auto empty() const -> b8
+    {
+      return size_ == 0;
+    }
+
+    [[nodiscard]]
+    auto capacity() const -> usize
+    {
+      return capacity_;
+    }
+
+    [[nodiscard]]
+    auto begin() -> iterator
+    {
+      return iterator(controls_, entries_);
+    }
+
+    [[nodiscard]]
+    auto begin() const -> const_iterator
+    {
+      return const_iterator(controls_, entries_);
+    }
+
+    [[nodiscard]]
+    auto cbegin() const -> const_iterator
+    {
+      return begin();
+    }
+
+    [[nodiscard]]
+    auto end() -> sentinel
+    {
+      return sentinel();
+    }
+
+    [[nodiscard]]
+    auto end() const -> const_sentinel
+    {
+      return const_sentinel();
+    }
+
+    [[nodiscard]]
+    auto cend() const -> const_sentinel
+    {
+      return const_sentinel();
+    }
+
+    void reserve(usize capacity)
+    {
+      if (capacity > capacity_)
+      {
+        rehash(ComputeSlotCountForCapacity(capacity));
+      }
+    }
+
+    void insert(OwnRef<EntryT> entry)
+    {
+      do_insert(std::move(entry));
+    }
+
+    /*
+      Return the entry of key, fn is only called to create the entry when key is not in the table.
+      The key is hashed once, and the entry returned by fn must have a key equal to key.
+    */
+    template <ts_hash_query<KeyT, HashFn> QueryT, ts_fn<EntryT> Fn>
+    auto find_or_insert_with(QueryT key, Fn fn) -> EntryT&
+    {
+      return do_find_or_insert_with(
+        hash_fn_(key),
+        [&key](const KeyT& stored_key) -> b8
+        {
+          return is_hash_query_equal(stored_key, key);
+        },
+        std::move(fn));
+    }
+
+    template <ts_fn<EntryT> Fn>
+    auto find_or_insert_with(const KeyT& key, Fn fn) -> EntryT&
+    {
+      return do_find_or_insert_with(
+        hash_fn_(key),
+        [&key](const KeyT& stored_key) -> b8
+        {
+          return key == stored_key;
+        },
+        std::move(fn));
+    }
+
+    template <ts_hash_query<KeyT, HashFn> QueryT>
+    auto find(QueryT key) -> iterator
+    {
+      if (slot_count_ == 0)
+      {
+        return end();
+      }
+      const auto index = do_find_index(key);
+      return iterator(controls_ + index, entries_ + index);
+    }
+
+    template <ts_hash_query<KeyT, HashFn> QueryT>
+    auto find(QueryT key) const -> const_iterator
+    {
+      if (slot_count_ == 0)
+      {
+        return end();
+      }
+      const auto index = do_find_index(key);
+      return const_iterator(controls_ + index, entries_ + index);
+    }
+
+    auto find(const KeyT& key) -> iterator
+    {
+      if (slot_count_ == 0)
+      {
+        return end();
+      }
+      const auto index = do_find_index(key);
+      return iterator(controls_ + index, entries_ + index);
+    }
+
+    auto find(const KeyT& key) const -> const_iterator
+    {
+      if (slot_count_ == 0)
+      {
+        return end();
+      }
+      const auto index = do_find_index(key);
+      return const_iterator(controls_ + index, entries_ + index);
+    }
+
+    template <ts_hash_query<KeyT, HashFn> QueryT>
+    [[nodiscard]]
+    auto entry_ref(QueryT key) -> EntryT&
+    {
+      SOUL_ASSERT(0, slot_count_ > 0);
+      const auto index = do_find_index(key);
+      return entries_[index];
+    }
+
+    template <ts_hash_query<KeyT, HashFn> QueryT>
+    [[nodiscard]]
+    auto entry_ref(QueryT key) const -> const EntryT&
+    {
+      SOUL_ASSERT(0, slot_count_ > 0);
+      const auto index = do_find_index(key);
+      return entries_[index];
+    }
+
+    [[nodiscard]]
+    auto entry_ref(const KeyT& key) -> EntryT&
+    {
+      SOUL_ASSERT(0, slot_count_ > 0);
+      const auto index = do_find_index(key);
+      return entries_[index];
+    }
+
+    [[nodiscard]]
+    auto entry_ref(const KeyT& key) const -> const EntryT&
+    {
+      SOUL_ASSERT(0, slot_count_ > 0);
+      const auto index = do_find_index(key);
+      return entries_[index];
+    }
+
+    template <ts_hash_query<KeyT, HashFn> QueryT>
+    void remove(QueryT key)
+    {
+      if (slot_count() == 0)
+      {
+        return;
+      }
+      do_remove_index(do_find_index(key));
+    }
+
+    void remove(const KeyT& key)
+    {
+      if (slot_count() == 0)
+      {
+        return;
+      }
+      do_remove_index(do_find_index(key));
+    }
+  };
+} // namespace soul
@@ -3,6 +3,7 @@
 // NOLINTBEGIN(readability-implicit-bool-conversion)
 
 #include <cstddef>
+#include <cstring>
 #include <limits>
 #include <numeric>
 #include <random>
@@ -307,12 +308,20 @@ namespace soul::gpu
       VkSystemAllocationScope /* scope */) -> void*
     {
       auto* const allocator = static_cast<memory::Allocator*>(user_data);
+      if (size == 0)
+      {
+        allocator->deallocate(addr);
+        return nullptr;
+      }
 
-      if (addr != nullptr)
+      // NOTE(kevinyu): On failure the original allocation must stay valid, the caller still own it.
+      void* new_addr = allocator->allocate(size, alignment);
+      if (addr != nullptr && new_addr != nullptr)
       {
+        memcpy(new_addr, addr, std::min<usize>(size, allocator->get_allocation_size(addr)));
         allocator->deallocate(addr);
       }
-      return allocator->allocate(size, alignment);
+      return new_addr;
     }
 
     auto vma_free_callback(void* user_data, void* addr) -> void
@@ -1166,6 +1175,13 @@ namespace soul::gpu
   {
     SOUL_ASSERT_MAIN_THREAD();
     _db.frame_contexts.reserve(config.max_frame_in_flight);
+    _db.frame_ring_allocator = _db.cpu_allocator
+                                 .create<memory::FrameRingAllocator>(
+                                   "GPU Frame Ring Allocator"_str,
+                                   config.max_frame_in_flight,
+                                   config.frame_ring_allocator_size,
+                                   &_db.frame_ring_page_allocator)
+                                 .unwrap();
     for (auto i = 0; i < _db.frame_contexts.capacity(); i++)
     {
       _db.frame_contexts.emplace_back(&_db.cpu_allocator);
@@ -1196,6 +1212,8 @@ namespace soul::gpu
     {
       frame_context.command_pools.shutdown();
     }
+    _db.cpu_allocator.destroy(NotNull(_db.frame_ring_allocator));
+    _db.frame_ring_allocator = nullptr;
 
     vkDestroyInstance(_db.instance, nullptr);
     vkDestroyDevice(_db.device, nullptr);
@@ -1901,6 +1919,12 @@ namespace soul::gpu
     return _db.frame_contexts[_db.current_frame % _db.frame_contexts.size()];
   }
 
+  auto System::get_frame_ring_allocator() -> memory::FrameRingAllocator&
+  {
+    SOUL_ASSERT(0, _db.frame_ring_allocator != nullptr);
+    return *_db.frame_ring_allocator;
+  }
+
   auto System::request_pipeline_state(
     const GraphicPipelineStateDesc& desc,
     VkRenderPass render_pass,
@@ -2592,10 +2616,9 @@ namespace soul::gpu
   auto System::request_render_pass(const RenderPassKey& key) -> VkRenderPass
   {
     SOUL_PROFILE_ZONE();
-    SOUL_ASSERT_MAIN_THREAD();
-    if (_db.render_pass_maps.contains(key))
+    if (const VkRenderPass* render_pass = _db.render_pass_maps.find(key); render_pass != nullptr)
     {
-      return _db.render_pass_maps[key];
+      return *render_pass;
     }
 
     auto attachment_flag_to_load_op = [](const AttachmentFlags flags) -> VkAttachmentLoadOp
@@ -2758,9 +2781,16 @@ namespace soul::gpu
       vkCreateRenderPass(_db.device, &render_pass_info, nullptr, &render_pass),
       "Fail to create render pass");
 
-    _db.render_pass_maps.insert(key, render_pass);
+    // NOTE(kevinyu): Another thread might have created the same render pass in the meantime, keep
+    // the one that was cached first.
+    const VkRenderPass cached_render_pass =
+      _db.render_pass_maps.find_or_create(key, [render_pass]() { return render_pass; });
+    if (cached_render_pass != render_pass)
+    {
+      vkDestroyRenderPass(_db.device, render_pass, nullptr);
+    }
 
-    return render_pass;
+    return cached_render_pass;
   }
 
   auto System::create_framebuffer(const VkFramebufferCreateInfo& info) -> VkFramebuffer
@@ -3208,6 +3238,10 @@ namespace soul::gpu
       }
     }
 
+    // NOTE(kevinyu): The ring has one segment per frame context and advance together with
+    // current_frame, so the released segment is the one of the frame that just retired.
+    _db.frame_ring_allocator->begin_frame();
+
     {
       SOUL_PROFILE_ZONE_WITH_NAME("Reset command pools");
       frame_context.command_pools.reset();
@@ -3332,6 +3366,7 @@ namespace soul::gpu
     garbages.semaphores.resize(0);
 
     _db.pipeline_state_cache.on_new_frame();
+    _db.render_pass_maps.reclaim();
 
     const auto result = acquire_swapchain();
     SOUL_ASSERT(0, result == VK_SUCCESS);
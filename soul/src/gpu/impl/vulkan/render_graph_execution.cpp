@@ -721,16 +721,12 @@ namespace soul::gpu::impl
 
   void RenderGraphExecution::compute_pass_order()
   {
-    const auto& pass_nodes = render_graph_->get_pass_nodes();
-
-    pass_order_.reserve(pass_nodes.size());
-    for (auto pass_index = 0u; pass_index < pass_nodes.size(); pass_index++)
-    {
-      if (active_passes_[pass_index])
+    pass_order_.reserve(active_passes_.count());
+    active_passes_.for_each_set_bit(
+      [this](usize pass_index)
       {
         pass_order_.push_back(PassNodeID(pass_index));
-      }
-    }
+      });
 
     const auto pass_compare_func = [this](const PassNodeID node1, const PassNodeID node2) -> b8
     {
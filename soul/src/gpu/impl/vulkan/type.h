@@ -1,9 +1,13 @@
 #pragma once
 
+#include "core/concurrent_hash_map.h"
 #include "core/sbo_vector.h"
 
 #include "gpu/type.h"
 
+#include "memory/allocators/frame_ring_allocator.h"
+#include "memory/allocators/page_allocator.h"
+
 #include "gpu/impl/vulkan/bindless_descriptor_allocator.h"
 
 namespace soul::gpu::impl
@@ -733,11 +737,14 @@ namespace soul::gpu::impl
     CPUAllocator cpu_allocator;
 
     memory::MallocAllocator vulkan_cpu_backing_allocator{"Vulkan CPU Backing Allocator"_str};
-    using VulkanCPUAllocatorProxy = memory::MultiProxy<memory::MutexProxy, memory::ProfileProxy>;
+    using VulkanCPUAllocatorProxy = memory::ProfileProxy;
     using VulkanCPUAllocator =
       memory::ProxyAllocator<memory::MallocAllocator, VulkanCPUAllocatorProxy>;
     VulkanCPUAllocator vulkan_cpu_allocator;
 
+    memory::PageAllocator frame_ring_page_allocator{"GPU Frame Ring Page Allocator"_str};
+    memory::FrameRingAllocator* frame_ring_allocator = nullptr;
+
     runtime::AllocatorInitializer allocator_initializer;
 
     VkInstance instance                      = VK_NULL_HANDLE;
@@ -785,7 +792,7 @@ namespace soul::gpu::impl
     ProgramPool program_pool;
     ShaderTablePool shader_table_pool;
 
-    HashMap<RenderPassKey, VkRenderPass, HashOp<RenderPassKey>> render_pass_maps;
+    ConcurrentHashMap<RenderPassKey, VkRenderPass, HashOp<RenderPassKey>> render_pass_maps;
 
     UInt64HashMap<SamplerID> sampler_map;
     BindlessDescriptorAllocator descriptor_allocator;
@@ -799,8 +806,7 @@ namespace soul::gpu::impl
           vulkan_cpu_allocator(
             "Vulkan allocator"_str,
             &vulkan_cpu_backing_allocator,
-            VulkanCPUAllocatorProxy::Config{
-              memory::MutexProxy::Config(), memory::ProfileProxy::Config()}),
+            VulkanCPUAllocatorProxy::Config()),
           allocator_initializer(&cpu_allocator)
     {
       allocator_initializer.end();
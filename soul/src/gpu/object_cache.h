@@ -1,9 +1,8 @@
 #pragma once
 
 #include "core/chunked_sparse_pool.h"
+#include "core/concurrent_hash_map.h"
 #include "core/hash.h"
-#include "core/hash_map.h"
-#include "core/intrusive_list.h"
 #include "core/mutex.h"
 
 namespace soul::gpu
@@ -13,17 +12,14 @@ namespace soul::gpu
     typename KeyT,
     typename ValT,
     typename RidT,
-    is_shared_lockable_v MutexT = RWSpinMutex,
-    typename Hash               = HashOp<KeyT>,
-    typename KeyEqual           = std::equal_to<KeyT>>
+    is_lockable_v MutexT = Mutex,
+    typename Hash        = HashOp<KeyT>,
+    typename KeyEqual    = std::equal_to<KeyT>>
   class ConcurrentObjectCache
   {
   public:
     explicit ConcurrentObjectCache(memory::Allocator* allocator = get_default_allocator())
-        : read_only_map_(allocator),
-          fallback_map_(allocator),
-          fallback_keys_(allocator),
-          object_pool_(allocator)
+        : map_(allocator), object_pool_(allocator)
     {
     }
 
@@ -35,40 +31,28 @@ namespace soul::gpu
 
     auto find(const KeyT& key) -> RidT
     {
-      if (read_only_map_.contains(key))
-      {
-        return read_only_map_[key];
-      }
-      std::shared_lock lock(mutex_);
-      if (fallback_map_.contains(key))
-      {
-        return fallback_map_[key];
-      }
-      return RidT::Null();
+      const RidT* id = map_.find(key);
+      return id != nullptr ? *id : RidT::Null();
     }
 
     template <typename... Args, ts_fn<ValT, Args&&...> Fn>
     auto create(const KeyT& key, Fn func, Args&&... args) -> RidT
     {
-      std::unique_lock lock(mutex_);
-      if (fallback_map_.contains(key))
-      {
-        return fallback_map_[key];
-      }
-      fallback_keys_.push_back(key);
-      auto id = object_pool_.create(func(std::forward<Args>(args)...));
-      fallback_map_.insert(key, id);
-      return id;
+      return map_.find_or_create(
+        key,
+        [&]() -> RidT
+        {
+          // NOTE(kevinyu): func run under the shard lock of key only, so different keys can be
+          // created in parallel. Only the pool insertion is serialized.
+          ValT value = func(std::forward<Args>(args)...);
+          std::lock_guard lock(mutex_);
+          return object_pool_.create(std::move(value));
+        });
     }
 
     auto on_new_frame() -> void
     {
-      for (const KeyT& key : fallback_keys_)
-      {
-        read_only_map_.insert(key, fallback_map_[key]);
-      }
-      fallback_keys_.clear();
-      fallback_map_.clear();
+      map_.reclaim();
     }
 
     auto ref(RidT id) const -> ValT&
@@ -82,9 +66,7 @@ namespace soul::gpu
     }
 
   private:
-    HashMap<KeyT, RidT> read_only_map_;
-    HashMap<KeyT, RidT> fallback_map_;
-    Vector<KeyT> fallback_keys_;
+    ConcurrentHashMap<KeyT, RidT, Hash, KeyEqual> map_;
     ChunkedSparsePool<ValT, RidT, NullMutex> object_pool_;
     MutexT mutex_;
   };
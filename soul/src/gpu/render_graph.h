@@ -835,8 +835,17 @@ namespace soul::gpu
   class RenderGraph
   {
   public:
+    // allocator hold the pass nodes and the node and resource arrays of the graph
     explicit RenderGraph(memory::Allocator* allocator = get_default_allocator())
-        : allocator_(allocator)
+        : pass_nodes_(allocator),
+          resource_nodes_(allocator),
+          internal_buffers_(allocator),
+          internal_textures_(allocator),
+          external_buffers_(allocator),
+          external_textures_(allocator),
+          external_tlas_list_(allocator),
+          external_blas_group_list_(allocator),
+          allocator_(allocator)
     {
     }
 
@@ -29,6 +29,8 @@ namespace soul::gpu
       u16 max_frame_in_flight   = 0;
       u16 thread_count          = 0;
       usize transient_pool_size = 50 * ONE_MEGABYTE;
+      // reserved address space of every frame in the frame ring allocator
+      usize frame_ring_allocator_size = 64 * ONE_MEGABYTE;
     };
 
     void init(const Config& config);
@@ -135,6 +137,12 @@ namespace soul::gpu
 
     auto get_frame_context() -> impl::FrameContext&;
 
+    /*
+      CPU memory that stay valid until the GPU finish the current frame. Released wholesale in
+      begin_frame() after the fence of the frame is waited. Thread safe.
+    */
+    auto get_frame_ring_allocator() -> memory::FrameRingAllocator&;
+
     auto request_render_pass(const impl::RenderPassKey& key) -> VkRenderPass;
 
     auto create_framebuffer(const VkFramebufferCreateInfo& info) -> VkFramebuffer;
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "core/architecture.h"
+#include "memory/allocator.h"
+#include "memory/allocators/page_allocator.h"
+
+namespace soul::memory
+{
+
+  /*
+    Linear allocator for data that must stay alive until the frames in flight that use it retire,
+    e.g. CPU side upload data that is read by the GPU a few frames later.
+
+    The allocator own frame_count segments of reserve_size_per_frame address space, committed on
+    demand. Allocation are bumped from the segment of the current frame and can be made from any
+    thread. begin_frame() move to the next segment and release it wholesale, so an allocation stay
+    valid for frame_count - 1 following begin_frame(). The caller must wait until the frame that
+    used the segment is retired (e.g. its fence is signaled) before calling begin_frame().
+
+    deallocate() is a no-op.
+  */
+  class FrameRingAllocator final : public Allocator
+  {
+  public:
+    static constexpr usize MAX_FRAME_COUNT = 8;
+
+    FrameRingAllocator() = delete;
+
+    FrameRingAllocator(
+      CompStr name, usize frame_count, usize reserve_size_per_frame, PageAllocator* page_allocator);
+
+    FrameRingAllocator(const FrameRingAllocator& other) = delete;
+
+    auto operator=(const FrameRingAllocator& other) -> FrameRingAllocator& = delete;
+
+    FrameRingAllocator(FrameRingAllocator&& other) = delete;
+
+    auto operator=(FrameRingAllocator&& other) -> FrameRingAllocator& = delete;
+
+    ~FrameRingAllocator() override;
+
+    // must not be called while other thread is allocating
+    void begin_frame();
+
+    // release every frame at once, must not be called while other thread is allocating
+    void reset() override;
+
+    auto try_allocate(usize size, usize alignment, StringView tag) -> Allocation override;
+
+    auto get_allocation_size(void* addr) const -> usize override;
+
+    void deallocate(void* addr) override;
+
+    [[nodiscard]]
+    auto get_frame_count() const -> usize;
+
+    [[nodiscard]]
+    auto get_committed_size() const -> usize;
+
+  private:
+    struct alignas(SOUL_CACHELINE_SIZE) Segment
+    {
+      byte* base_addr = nullptr;
+      std::atomic<usize> offset;
+      std::atomic<usize> committed_size;
+    };
+
+    void release_segment(Segment& segment);
+
+    // return false and leave the segment untouched when the page allocator fail to commit
+    auto commit(Segment& segment, usize end_offset) -> b8;
+
+    static constexpr usize COMMIT_BLOCK_SIZE = 64 * ONE_KILOBYTE;
+
+    PageAllocator* page_allocator_;
+    void* base_addr_     = nullptr;
+    usize frame_count_   = 0;
+    usize segment_size_  = 0;
+    usize current_index_ = 0;
+    Segment segments_[MAX_FRAME_COUNT];
+    std::mutex commit_mutex_;
+  };
+
+} // namespace soul::memory
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "memory/allocator.h"
+#include "memory/allocators/page_allocator.h"
+#include "memory/allocators/proxy_allocator.h"
 
 namespace soul::memory
 {
@@ -12,6 +14,19 @@ namespace soul::memory
 
     LinearAllocator(CompStr name, usize size, Allocator* backing_allocator);
 
+    /*
+      Reserve reserve_size of address space and commit it on demand, so the allocator only run out
+      of memory when the whole reservation is used. reset() decommit the memory above the high
+      water mark since the previous reset().
+    */
+    LinearAllocator(CompStr name, usize reserve_size, PageAllocator* page_allocator);
+
+    // same as above, the reservation is reported to the memory profiler
+    LinearAllocator(
+      CompStr name,
+      usize reserve_size,
+      ProxyAllocator<PageAllocator, ProfileProxy>* profile_page_allocator);
+
     LinearAllocator(const LinearAllocator& other) = delete;
 
     auto operator=(const LinearAllocator& other) -> LinearAllocator& = delete;
@@ -35,11 +50,23 @@ namespace soul::memory
 
     void rewind(void* addr);
 
+    [[nodiscard]]
+    auto get_committed_size() const -> usize;
+
   private:
-    Allocator* backing_allocator_;
-    void* base_addr_    = nullptr;
-    void* current_addr_ = nullptr;
-    u64 size_           = 0;
+    // return false and leave committed_addr_ untouched when the page allocator fail to commit
+    auto commit(void* end_addr) -> b8;
+
+    static constexpr usize COMMIT_BLOCK_SIZE = 64 * ONE_KILOBYTE;
+
+    Allocator* backing_allocator_                                        = nullptr;
+    PageAllocator* page_allocator_                                       = nullptr;
+    ProxyAllocator<PageAllocator, ProfileProxy>* profile_page_allocator_ = nullptr;
+    void* base_addr_                                                     = nullptr;
+    void* current_addr_                                                  = nullptr;
+    void* committed_addr_                                                = nullptr;
+    void* high_water_addr_                                               = nullptr;
+    u64 size_                                                            = 0;
   };
 
 } // namespace soul::memory
@@ -5,12 +5,22 @@
 namespace soul::memory
 {
 
+  enum class HugePageMode : u8
+  {
+    NONE,
+    TRANSPARENT, // hint the OS to back the region with huge page (madvise(MADV_HUGEPAGE) on Linux)
+    // reserve from the OS huge page pool and take the pages in commit(), fall back to TRANSPARENT
+    // when huge page cannot be reserved
+    EXPLICIT,
+    COUNT
+  };
+
   class PageAllocator final : public Allocator
   {
   public:
     PageAllocator() = delete;
 
-    explicit PageAllocator(CompStr name);
+    explicit PageAllocator(CompStr name, HugePageMode huge_page_mode = HugePageMode::NONE);
 
     PageAllocator(const PageAllocator& other) = delete;
 
@@ -24,15 +34,39 @@ namespace soul::memory
 
     void reset() override;
 
+    // reserve and commit the whole region
     auto try_allocate(usize size, usize alignment, StringView tag) -> Allocation override;
 
+    // return the reserved size rounded up to the page size
     [[nodiscard]]
     auto get_allocation_size(void* addr) const -> usize override;
 
     void deallocate(void* addr) override;
 
+    /*
+      Reserve address space without backing it with memory. Memory inside the region must be
+      committed before it is accessed. Release it with deallocate().
+    */
+    [[nodiscard]]
+    auto reserve(usize size, usize alignment) -> Allocation;
+
+    // addr and size are rounded outward to the page boundary. Return false when the OS is out of
+    // memory (or out of huge page in HugePageMode::EXPLICIT)
+    auto commit(void* addr, usize size) -> b8;
+
+    // give the memory back to the OS but keep the address space reserved
+    void decommit(void* addr, usize size);
+
+    [[nodiscard]]
+    auto get_page_size() const -> usize;
+
   private:
-    usize page_size_ = 0;
+    [[nodiscard]]
+    auto get_commit_granularity() const -> usize;
+
+    usize page_size_             = 0;
+    usize huge_page_size_        = 0;
+    HugePageMode huge_page_mode_ = HugePageMode::NONE;
   };
 
 } // namespace soul::memory
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <mutex>
 
+#include "core/architecture.h"
 #include "memory/allocator.h"
+#include "memory/impl/thread_cache_slot.h"
 #include "memory/util.h"
 
 namespace soul::memory
@@ -21,6 +26,12 @@ namespace soul::memory
     usize size = 0;
   };
 
+  /*
+    Hooks that run around every call of ProxyAllocator. A proxy must not keep state between its
+    pre and post hook, on_post_allocate() get the parameter back instead, so a proxy stack is
+    thread safe as long as every proxy in it is. Use MutexProxy only to guard a backing allocator
+    that is not thread safe.
+  */
   class Proxy
   {
   public:
@@ -41,19 +52,29 @@ namespace soul::memory
       return addr;
     }
 
+    // addr is the address this proxy returned, size is the allocation size of the next layer
     [[nodiscard]]
-    virtual auto get_base_size(const usize size) const -> usize
+    virtual auto get_base_size(void* /* addr */, const usize size) const -> usize
     {
       return size;
     }
 
+    // parameter that the proxy pass to the next layer, must not have side effect
+    [[nodiscard]]
+    virtual auto get_backing_param(const AllocateParam& alloc_param) const -> AllocateParam
+    {
+      return alloc_param;
+    }
+
     virtual void on_pre_init(StringView name) = 0;
 
     virtual void on_post_init() = 0;
 
-    virtual auto on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam = 0;
+    virtual void on_pre_allocate(const AllocateParam& alloc_param) = 0;
 
-    virtual auto on_post_allocate(Allocation allocation) -> Allocation = 0;
+    // alloc_param is the parameter that this proxy get in on_pre_allocate()
+    virtual auto on_post_allocate(const AllocateParam& alloc_param, Allocation allocation)
+      -> Allocation = 0;
 
     virtual auto on_pre_deallocate(const DeallocateParam& dealloc_param) -> DeallocateParam = 0;
 
@@ -62,6 +83,16 @@ namespace soul::memory
     virtual void on_pre_cleanup() = 0;
 
     virtual void on_post_cleanup() = 0;
+
+    // ProxyAllocator::reserve() only hand out address space that is not committed yet, a proxy
+    // that touch the memory must leave these hooks as no-op
+    virtual auto on_reserve(const AllocateParam& /* alloc_param */, const Allocation allocation)
+      -> Allocation
+    {
+      return allocation;
+    }
+
+    virtual void on_release(const DeallocateParam& /* dealloc_param */) {}
   };
 
   class NoOpProxy final : public Proxy
@@ -77,12 +108,10 @@ namespace soul::memory
 
     void on_post_init() override {}
 
-    auto on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam override
-    {
-      return alloc_param;
-    }
+    void on_pre_allocate(const AllocateParam& alloc_param) override {}
 
-    auto on_post_allocate(const Allocation allocation) -> Allocation override
+    auto on_post_allocate(const AllocateParam& /* alloc_param */, const Allocation allocation)
+      -> Allocation override
     {
       return allocation;
     }
@@ -154,16 +183,33 @@ namespace soul::memory
     }
 
     [[nodiscard]]
-    auto get_base_size(const usize size) const -> usize override
-    {
-      usize base_size = proxy1_.get_base_size(size);
-      base_size       = proxy2_.get_base_size(base_size);
-      base_size       = proxy3_.get_base_size(base_size);
-      base_size       = proxy4_.get_base_size(base_size);
-      base_size       = proxy5_.get_base_size(base_size);
+    auto get_base_size(void* addr, const usize size) const -> usize override
+    {
+      // NOTE(kevinyu): size come from the innermost layer, so unwrap it from proxy5 outward, each
+      // proxy with the address it returned.
+      void* addr2     = proxy1_.get_base_addr(addr);
+      void* addr3     = proxy2_.get_base_addr(addr2);
+      void* addr4     = proxy3_.get_base_addr(addr3);
+      void* addr5     = proxy4_.get_base_addr(addr4);
+      usize base_size = proxy5_.get_base_size(addr5, size);
+      base_size       = proxy4_.get_base_size(addr4, base_size);
+      base_size       = proxy3_.get_base_size(addr3, base_size);
+      base_size       = proxy2_.get_base_size(addr2, base_size);
+      base_size       = proxy1_.get_base_size(addr, base_size);
       return base_size;
     }
 
+    [[nodiscard]]
+    auto get_backing_param(const AllocateParam& alloc_param) const -> AllocateParam override
+    {
+      AllocateParam param = proxy1_.get_backing_param(alloc_param);
+      param               = proxy2_.get_backing_param(param);
+      param               = proxy3_.get_backing_param(param);
+      param               = proxy4_.get_backing_param(param);
+      param               = proxy5_.get_backing_param(param);
+      return param;
+    }
+
     void on_pre_init(StringView name) override
     {
       proxy1_.on_pre_init(name);
@@ -182,24 +228,33 @@ namespace soul::memory
       proxy1_.on_post_init();
     }
 
-    auto on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam override
+    void on_pre_allocate(const AllocateParam& alloc_param) override
     {
-      AllocateParam param = alloc_param;
-      param               = proxy1_.on_pre_allocate(param);
-      param               = proxy2_.on_pre_allocate(param);
-      param               = proxy3_.on_pre_allocate(param);
-      param               = proxy4_.on_pre_allocate(param);
-      param               = proxy5_.on_pre_allocate(param);
-      return param;
+      const AllocateParam param2 = proxy1_.get_backing_param(alloc_param);
+      const AllocateParam param3 = proxy2_.get_backing_param(param2);
+      const AllocateParam param4 = proxy3_.get_backing_param(param3);
+      const AllocateParam param5 = proxy4_.get_backing_param(param4);
+      proxy1_.on_pre_allocate(alloc_param);
+      proxy2_.on_pre_allocate(param2);
+      proxy3_.on_pre_allocate(param3);
+      proxy4_.on_pre_allocate(param4);
+      proxy5_.on_pre_allocate(param5);
     }
 
-    auto on_post_allocate(Allocation allocation) -> Allocation override
+    auto on_post_allocate(const AllocateParam& alloc_param, Allocation allocation)
+      -> Allocation override
     {
-      allocation = proxy5_.on_post_allocate(allocation);
-      allocation = proxy4_.on_post_allocate(allocation);
-      allocation = proxy3_.on_post_allocate(allocation);
-      allocation = proxy2_.on_post_allocate(allocation);
-      allocation = proxy1_.on_post_allocate(allocation);
+      // NOTE(kevinyu): Rebuild the parameter of every proxy instead of storing it in
+      // on_pre_allocate(), so concurrent allocations do not share any state.
+      const AllocateParam param2 = proxy1_.get_backing_param(alloc_param);
+      const AllocateParam param3 = proxy2_.get_backing_param(param2);
+      const AllocateParam param4 = proxy3_.get_backing_param(param3);
+      const AllocateParam param5 = proxy4_.get_backing_param(param4);
+      allocation                 = proxy5_.on_post_allocate(param5, allocation);
+      allocation                 = proxy4_.on_post_allocate(param4, allocation);
+      allocation                 = proxy3_.on_post_allocate(param3, allocation);
+      allocation                 = proxy2_.on_post_allocate(param2, allocation);
+      allocation                 = proxy1_.on_post_allocate(alloc_param, allocation);
       return allocation;
     }
 
@@ -240,8 +295,32 @@ namespace soul::memory
       proxy2_.on_post_cleanup();
       proxy1_.on_post_cleanup();
     }
+
+    auto on_reserve(const AllocateParam& alloc_param, Allocation allocation) -> Allocation override
+    {
+      allocation = proxy5_.on_reserve(alloc_param, allocation);
+      allocation = proxy4_.on_reserve(alloc_param, allocation);
+      allocation = proxy3_.on_reserve(alloc_param, allocation);
+      allocation = proxy2_.on_reserve(alloc_param, allocation);
+      allocation = proxy1_.on_reserve(alloc_param, allocation);
+      return allocation;
+    }
+
+    void on_release(const DeallocateParam& dealloc_param) override
+    {
+      proxy1_.on_release(dealloc_param);
+      proxy2_.on_release(dealloc_param);
+      proxy3_.on_release(dealloc_param);
+      proxy4_.on_release(dealloc_param);
+      proxy5_.on_release(dealloc_param);
+    }
   };
 
+  /*
+    Count the live allocations. The counter is split into per-thread shards, so threads do not
+    fight over one cache line. An allocation freed by another thread make the shards go negative,
+    only their sum is meaningful.
+  */
   class CounterProxy final : public Proxy
   {
   public:
@@ -255,25 +334,29 @@ namespace soul::memory
 
     void on_pre_init(StringView /* name */) override
     {
-      _counter = 0;
+      for (Shard& shard : shards_)
+      {
+        shard.live_count.store(0, std::memory_order_relaxed);
+      }
     }
 
     void on_post_init() override {}
 
-    auto on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam override
-    {
-      _counter++;
-      return alloc_param;
-    }
+    void on_pre_allocate(const AllocateParam& alloc_param) override {}
 
-    auto on_post_allocate(const Allocation allocation) -> Allocation override
+    auto on_post_allocate(const AllocateParam& /* alloc_param */, const Allocation allocation)
+      -> Allocation override
     {
+      if (allocation.addr != nullptr)
+      {
+        get_shard().live_count.fetch_add(1, std::memory_order_relaxed);
+      }
       return allocation;
     }
 
     auto on_pre_deallocate(const DeallocateParam& dealloc_param) -> DeallocateParam override
     {
-      _counter--;
+      get_shard().live_count.fetch_sub(1, std::memory_order_relaxed);
       return dealloc_param;
     }
 
@@ -281,13 +364,38 @@ namespace soul::memory
 
     void on_pre_cleanup() override
     {
-      SOUL_ASSERT(0, _counter == 0);
+      SOUL_ASSERT(0, get_live_count() == 0);
     }
 
     void on_post_cleanup() override {}
 
+    // not a consistent snapshot while other threads are allocating
+    [[nodiscard]]
+    auto get_live_count() const -> i64
+    {
+      i64 live_count = 0;
+      for (const Shard& shard : shards_)
+      {
+        live_count += shard.live_count.load(std::memory_order_relaxed);
+      }
+      return live_count;
+    }
+
   private:
-    usize _counter = 0;
+    static constexpr u32 SHARD_COUNT = 16;
+
+    struct alignas(SOUL_CACHELINE_SIZE) Shard
+    {
+      std::atomic<i64> live_count = 0;
+    };
+
+    auto get_shard() -> Shard&
+    {
+      // NOTE(kevinyu): INVALID_THREAD_CACHE_SLOT also map to a valid shard.
+      return shards_[impl::get_thread_cache_slot() % SHARD_COUNT];
+    }
+
+    Shard shards_[SHARD_COUNT];
   };
 
   class ClearValuesProxy final : public Proxy
@@ -309,16 +417,16 @@ namespace soul::memory
 
     void on_post_init() override {}
 
-    auto on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam override
-    {
-      current_alloc_size_ = alloc_param.size;
-      return alloc_param;
-    }
+    void on_pre_allocate(const AllocateParam& alloc_param) override {}
 
-    auto on_post_allocate(const Allocation allocation) -> Allocation override
+    auto on_post_allocate(const AllocateParam& alloc_param, const Allocation allocation)
+      -> Allocation override
     {
-      SOUL_ASSERT(0, allocation.size == current_alloc_size_);
-      memset(allocation.addr, on_alloc_clear_value_, current_alloc_size_);
+      if (allocation.addr != nullptr)
+      {
+        SOUL_ASSERT(0, allocation.size == alloc_param.size);
+        memset(allocation.addr, on_alloc_clear_value_, alloc_param.size);
+      }
       return allocation;
     }
 
@@ -341,10 +449,13 @@ namespace soul::memory
   private:
     u8 on_alloc_clear_value_;
     u8 on_dealloc_clear_value_;
-
-    usize current_alloc_size_ = 0;
   };
 
+  /*
+    Surround every allocation with guard bytes and check them on deallocate. The front guard is
+    max(GUARD_SIZE, alignment) bytes so the returned address keep the requested alignment, its
+    size is stored in the GUARD_SIZE bytes right before the returned address.
+  */
   class BoundGuardProxy final : public Proxy
   {
   public:
@@ -356,34 +467,42 @@ namespace soul::memory
 
     auto get_base_addr(void* addr) const -> void* override
     {
-      return util::pointer_sub(addr, GUARD_SIZE);
+      return util::pointer_sub(addr, get_front_size(addr));
+    }
+
+    [[nodiscard]]
+    auto get_base_size(void* addr, const usize size) const -> usize override
+    {
+      return size - get_front_size(addr) - GUARD_SIZE;
     }
 
     [[nodiscard]]
-    auto get_base_size(const usize size) const -> usize override
+    auto get_backing_param(const AllocateParam& alloc_param) const -> AllocateParam override
     {
-      return size - 2ull * GUARD_SIZE;
+      const usize front_size = std::max<usize>(GUARD_SIZE, alloc_param.alignment);
+      return {alloc_param.size + front_size + GUARD_SIZE, front_size, alloc_param.tag};
     }
 
     void on_pre_init(StringView name) override {}
 
     void on_post_init() override {}
 
-    auto on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam override
-    {
-      current_alloc_size_ = alloc_param.size;
-      return {alloc_param.size + 2ull * GUARD_SIZE, GUARD_SIZE, alloc_param.tag};
-    }
+    void on_pre_allocate(const AllocateParam& alloc_param) override {}
 
-    auto on_post_allocate(const Allocation allocation) -> Allocation override
+    auto on_post_allocate(const AllocateParam& alloc_param, const Allocation allocation)
+      -> Allocation override
     {
-      memset(allocation.addr, GUARD_FLAG, GUARD_SIZE);
-      memset(
-        util::pointer_add(allocation.addr, GUARD_SIZE + current_alloc_size_),
-        GUARD_FLAG,
-        GUARD_SIZE);
-      SOUL_ASSERT(0, allocation.size > 2ull * GUARD_SIZE);
-      return {util::pointer_add(allocation.addr, GUARD_SIZE), allocation.size - 2ull * GUARD_SIZE};
+      if (allocation.addr == nullptr)
+      {
+        return allocation;
+      }
+      const usize front_size = std::max<usize>(GUARD_SIZE, alloc_param.alignment);
+      SOUL_ASSERT(0, allocation.size > front_size + GUARD_SIZE);
+      void* addr = util::pointer_add(allocation.addr, front_size);
+      memset(allocation.addr, GUARD_FLAG, front_size);
+      memset(util::pointer_add(addr, alloc_param.size), GUARD_FLAG, GUARD_SIZE);
+      memcpy(util::pointer_sub(addr, GUARD_SIZE), &front_size, sizeof(front_size));
+      return {addr, allocation.size - front_size - GUARD_SIZE};
     }
 
     auto on_pre_deallocate(const DeallocateParam& dealloc_param) -> DeallocateParam override
@@ -391,16 +510,22 @@ namespace soul::memory
       if (dealloc_param.addr != nullptr)
       {
         SOUL_ASSERT(0, dealloc_param.size != 0, "This proxy need size in its deallocate call");
-        auto* base_front = cast<byte*>(util::pointer_sub(dealloc_param.addr, GUARD_SIZE));
+        const usize front_size = get_front_size(dealloc_param.addr);
+        auto* base_front       = cast<byte*>(util::pointer_sub(dealloc_param.addr, front_size));
         auto* base_back  = cast<byte*>(util::pointer_add(dealloc_param.addr, dealloc_param.size));
-        for (usize i = 0; i < GUARD_SIZE; i++)
+        for (usize i = 0; i < front_size - GUARD_SIZE; i++)
         {
           SOUL_ASSERT(0, base_front[i] == GUARD_FLAG);
+        }
+        for (usize i = sizeof(usize); i < GUARD_SIZE; i++)
+        {
+          SOUL_ASSERT(0, base_front[front_size - GUARD_SIZE + i] == GUARD_FLAG);
+        }
+        for (usize i = 0; i < GUARD_SIZE; i++)
+        {
           SOUL_ASSERT(0, base_back[i] == GUARD_FLAG);
         }
-        return {
-          util::pointer_sub(dealloc_param.addr, GUARD_SIZE),
-          dealloc_param.size + 2ull * GUARD_SIZE};
+        return {base_front, dealloc_param.size + front_size + GUARD_SIZE};
       }
       return dealloc_param;
     }
@@ -414,7 +539,19 @@ namespace soul::memory
   private:
     static constexpr u32 GUARD_SIZE  = alignof(std::max_align_t);
     static constexpr byte GUARD_FLAG = 0xAA;
-    usize current_alloc_size_        = 0;
+
+    static_assert(GUARD_SIZE > sizeof(usize));
+
+    static auto get_front_size(void* addr) -> usize
+    {
+      usize front_size = 0;
+      memcpy(&front_size, util::pointer_sub(addr, GUARD_SIZE), sizeof(front_size));
+      SOUL_ASSERT(
+        0,
+        front_size >= GUARD_SIZE && (front_size & (front_size - 1)) == 0,
+        "Front guard is corrupted");
+      return front_size;
+    }
   };
 
   class ProfileProxy final : public Proxy
@@ -430,9 +567,10 @@ namespace soul::memory
 
     void on_post_init() override {}
 
-    auto on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam override;
+    void on_pre_allocate(const AllocateParam& alloc_param) override {}
 
-    auto on_post_allocate(Allocation allocation) -> Allocation override;
+    auto on_post_allocate(const AllocateParam& alloc_param, Allocation allocation)
+      -> Allocation override;
 
     auto on_pre_deallocate(const DeallocateParam& dealloc_param) -> DeallocateParam override;
 
@@ -442,9 +580,20 @@ namespace soul::memory
 
     void on_post_cleanup() override {}
 
+    // the reservation is reported as an allocation, so the profiler show the reserved size
+    auto on_reserve(const AllocateParam& alloc_param, Allocation allocation)
+      -> Allocation override
+    {
+      return on_post_allocate(alloc_param, allocation);
+    }
+
+    void on_release(const DeallocateParam& dealloc_param) override
+    {
+      on_pre_deallocate(dealloc_param);
+    }
+
   private:
     StringView name_ = {nullptr, 0};
-    AllocateParam current_alloc_;
   };
 
   class MutexProxy final : public Proxy
@@ -460,13 +609,13 @@ namespace soul::memory
 
     void on_post_init() override {}
 
-    auto on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam override
+    void on_pre_allocate(const AllocateParam& alloc_param) override
     {
       mutex_.lock();
-      return alloc_param;
     }
 
-    auto on_post_allocate(const Allocation allocation) -> Allocation override
+    auto on_post_allocate(const AllocateParam& /* alloc_param */, const Allocation allocation)
+      -> Allocation override
     {
       mutex_.unlock();
       return allocation;
@@ -538,17 +687,19 @@ namespace soul::memory
       {
         return {nullptr, 0};
       }
-      AllocateParam param   = {size, alignment, tag};
-      param                 = proxy_.on_pre_allocate(param);
-      Allocation allocation = allocator->try_allocate(param.size, param.alignment, name());
-      return proxy_.on_post_allocate(allocation);
+      const AllocateParam param         = {size, alignment, tag};
+      const AllocateParam backing_param = proxy_.get_backing_param(param);
+      proxy_.on_pre_allocate(param);
+      const Allocation allocation =
+        allocator->try_allocate(backing_param.size, backing_param.alignment, name());
+      return proxy_.on_post_allocate(param, allocation);
     }
 
     [[nodiscard]]
     auto get_allocation_size(void* addr) const -> usize override
     {
       void* base_addr = proxy_.get_base_addr(addr);
-      return proxy_.get_base_size(allocator->get_allocation_size(base_addr));
+      return proxy_.get_base_size(addr, allocator->get_allocation_size(base_addr));
     }
 
     void deallocate(void* addr) override
@@ -574,6 +725,26 @@ namespace soul::memory
       allocator->rewind(addr);
     }
 
+    /*
+      Reserve address space from the backing allocator, that must be a PageAllocator. Only the
+      on_reserve() hook of the proxy run, the memory is not committed. Release it with release().
+    */
+    [[nodiscard]]
+    auto reserve(const usize size, const usize alignment, StringView tag) -> Allocation
+    {
+      return proxy_.on_reserve({size, alignment, tag}, allocator->reserve(size, alignment));
+    }
+
+    void release(void* addr)
+    {
+      if (addr == nullptr)
+      {
+        return;
+      }
+      proxy_.on_release({addr, allocator->get_allocation_size(addr)});
+      allocator->deallocate(addr);
+    }
+
   private:
     Proxy proxy_;
   };
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <mutex>
+
+#include "memory/allocator.h"
+
+namespace soul::memory
+{
+
+  /*
+    Allocator for small fixed size objects. Allocation are rounded up to a power of two size class
+    and served from a free list of the class. Blocks are carved from slabs of slab_size, that are
+    aligned to slab_size and start with a header, so deallocate() and get_allocation_size() are
+    O(1). Every block is aligned to its size class. Allocation bigger than max_block_size go to the
+    backing allocator.
+
+    Without thread_magazine, the allocator is not thread safe, put it behind a MutexProxy to share
+    it. With thread_magazine, every thread keep a small magazine of blocks per size class and only
+    take the lock when its magazine is empty or full.
+
+    reset() return every block to the allocator at once, including the ones that are not
+    deallocated. The slabs are kept for reuse and only given back in the destructor.
+  */
+  class SlabAllocator final : public Allocator
+  {
+  public:
+    static constexpr usize MIN_BLOCK_SIZE         = 16;
+    static constexpr u32 MAX_SIZE_CLASS_COUNT     = 16;
+    static constexpr usize DEFAULT_SLAB_SIZE      = 64 * ONE_KILOBYTE;
+    static constexpr usize DEFAULT_MAX_BLOCK_SIZE = ONE_KILOBYTE;
+
+    struct Config
+    {
+      usize slab_size      = DEFAULT_SLAB_SIZE;      // power of two
+      usize max_block_size = DEFAULT_MAX_BLOCK_SIZE; // power of two, at most slab_size / 8
+      b8 thread_magazine   = false;
+    };
+
+    SlabAllocator() = delete;
+
+    SlabAllocator(CompStr name, Allocator* backing_allocator, const Config& config);
+
+    SlabAllocator(const SlabAllocator& other) = delete;
+
+    auto operator=(const SlabAllocator& other) -> SlabAllocator& = delete;
+
+    SlabAllocator(SlabAllocator&& other) = delete;
+
+    auto operator=(SlabAllocator&& other) -> SlabAllocator& = delete;
+
+    ~SlabAllocator() override;
+
+    // must not be called while other thread is using the allocator
+    void reset() override;
+
+    auto try_allocate(usize size, usize alignment, StringView tag) -> Allocation override;
+
+    // return the block size of the size class
+    [[nodiscard]]
+    auto get_allocation_size(void* addr) const -> usize override;
+
+    void deallocate(void* addr) override;
+
+  private:
+    struct SlabHeader;
+
+    struct FreeBlock
+    {
+      FreeBlock* next;
+    };
+
+    struct Magazine
+    {
+      FreeBlock* head = nullptr;
+      u32 count       = 0;
+    };
+
+    [[nodiscard]]
+    auto lock() -> std::unique_lock<std::mutex>;
+
+    auto allocate_block(u32 size_class) -> void*;
+
+    void deallocate_block(void* block, u32 size_class);
+
+    auto allocate_large(usize size, usize alignment) -> Allocation;
+
+    // carve a new slab into the free list of the size class, must be called with the lock held
+    auto refill_free_list(u32 size_class) -> b8;
+
+    [[nodiscard]]
+    auto get_block_size(u32 size_class) const -> usize;
+
+    [[nodiscard]]
+    auto get_magazine_capacity(u32 size_class) const -> u32;
+
+    Allocator* backing_allocator_;
+    Config config_;
+    u32 size_class_count_ = 0;
+    Magazine* magazines_  = nullptr;
+
+    std::mutex mutex_;
+    FreeBlock* free_lists_[MAX_SIZE_CLASS_COUNT] = {};
+    SlabHeader* used_slabs_                      = nullptr;
+    SlabHeader* free_slabs_                      = nullptr;
+    SlabHeader* large_allocations_               = nullptr;
+  };
+
+} // namespace soul::memory
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <mutex>
+
+#include "core/architecture.h"
+#include "memory/allocator.h"
+#include "memory/impl/thread_cache_slot.h"
+
+namespace soul::memory
+{
+
+  /*
+    General purpose allocator that can be shared by many threads without a global lock.
+
+    Small allocation are rounded up to a size class and served from a per-thread free list, so the
+    common path never take a lock. A thread cache exchange blocks with the central free list of the
+    size class in batches. Allocation bigger than MAX_SMALL_SIZE go to the backing allocator with
+    CHUNK_SIZE alignment. Freed large blocks are kept in a small cache, up to MAX_LARGE_CACHE_SIZE
+    bytes, so they do not pay a page mapping on every call when the backing allocator is a
+    PageAllocator.
+
+    Small blocks are carved from chunks of CHUNK_SIZE that are aligned to CHUNK_SIZE. Every chunk
+    start with a header, so the size class of an address is found in O(1). The backing allocator
+    must honor alignment up to CHUNK_SIZE (PageAllocator and MallocAllocator do). Chunks are only
+    given back to the backing allocator when this allocator is destroyed.
+
+    reset() return every block to the allocator at once, including the ones that are not
+    deallocated. Spans are kept for reuse, live large blocks are given back to the backing
+    allocator. No other thread may use the allocator during reset().
+  */
+  class ThreadCachingAllocator final : public Allocator
+  {
+  public:
+    static constexpr usize CHUNK_SIZE     = 64 * ONE_KILOBYTE;
+    static constexpr usize MAX_SMALL_SIZE = 8 * ONE_KILOBYTE;
+    static constexpr usize MIN_ALIGNMENT  = 16;
+    // NOTE(kevinyu): Every small block keep its requested size in its last SIZE_TAG_SIZE bytes.
+    static constexpr usize SIZE_TAG_SIZE  = sizeof(u32);
+    static constexpr u32 SIZE_CLASS_COUNT = 32;
+    // NOTE(kevinyu): Upper bound of the freed large blocks that are kept instead of given back.
+    static constexpr usize MAX_LARGE_CACHE_SIZE = 4 * ONE_MEGABYTE;
+    // NOTE(kevinyu): Threads beyond this limit go straight to the central free list.
+    static constexpr u32 MAX_THREAD_CACHE_COUNT = impl::MAX_THREAD_CACHE_SLOT_COUNT;
+
+    ThreadCachingAllocator() = delete;
+
+    ThreadCachingAllocator(CompStr name, Allocator* backing_allocator);
+
+    ThreadCachingAllocator(const ThreadCachingAllocator& other) = delete;
+
+    auto operator=(const ThreadCachingAllocator& other) -> ThreadCachingAllocator& = delete;
+
+    ThreadCachingAllocator(ThreadCachingAllocator&& other) = delete;
+
+    auto operator=(ThreadCachingAllocator&& other) -> ThreadCachingAllocator& = delete;
+
+    ~ThreadCachingAllocator() override;
+
+    void reset() override;
+
+    auto try_allocate(usize size, usize alignment, StringView tag) -> Allocation override;
+
+    // return the size that was requested for addr, not the size of its size class
+    [[nodiscard]]
+    auto get_allocation_size(void* addr) const -> usize override;
+
+    void deallocate(void* addr) override;
+
+  private:
+    struct FreeBlock
+    {
+      FreeBlock* next;
+    };
+
+    struct ThreadCacheBin
+    {
+      FreeBlock* head = nullptr;
+      u32 count       = 0;
+    };
+
+    struct alignas(SOUL_CACHELINE_SIZE) ThreadCache
+    {
+      ThreadCacheBin bins[SIZE_CLASS_COUNT];
+    };
+
+    struct alignas(SOUL_CACHELINE_SIZE) CentralBin
+    {
+      std::mutex mutex;
+      FreeBlock* head = nullptr;
+      u32 count       = 0;
+    };
+
+    auto allocate_small(u32 size_class) -> void*;
+
+    void deallocate_small(void* block, u32 size_class);
+
+    auto allocate_large(usize size, usize alignment) -> Allocation;
+
+    void deallocate_large(void* chunk_addr);
+
+    // move up to count blocks from the central free list to the bin, return the moved count
+    auto fetch_from_central(u32 size_class, ThreadCacheBin* bin, u32 count) -> u32;
+
+    // move count blocks from the head of the bin to the central free list
+    void release_to_central(u32 size_class, ThreadCacheBin* bin, u32 count);
+
+    auto allocate_chunk() -> void*;
+
+    Allocator* backing_allocator_;
+    ThreadCache* thread_caches_ = nullptr;
+    CentralBin central_bins_[SIZE_CLASS_COUNT];
+
+    std::mutex chunk_mutex_;
+    void* span_list_      = nullptr;
+    void* free_span_list_ = nullptr; // spans given back by reset()
+    byte* span_cursor_    = nullptr;
+    byte* span_end_       = nullptr;
+
+    std::mutex large_mutex_;
+    void* large_allocations_ = nullptr;
+    void* large_cache_       = nullptr;
+    usize large_cache_size_  = 0;
+  };
+
+} // namespace soul::memory
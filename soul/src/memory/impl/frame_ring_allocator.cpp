@@ -0,0 +1,156 @@
+#include <algorithm>
+
+#include "memory/allocators/frame_ring_allocator.h"
+#include "memory/util.h"
+
+namespace soul::memory
+{
+  namespace
+  {
+    auto align_up(usize value, usize alignment) -> usize
+    {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+  } // namespace
+
+  FrameRingAllocator::FrameRingAllocator(
+    CompStr name,
+    const usize frame_count,
+    const usize reserve_size_per_frame,
+    PageAllocator* page_allocator)
+      : Allocator(name),
+        page_allocator_(page_allocator),
+        frame_count_(frame_count),
+        segment_size_(align_up(reserve_size_per_frame, COMMIT_BLOCK_SIZE))
+  {
+    SOUL_ASSERT(0, page_allocator_ != nullptr);
+    SOUL_ASSERT(0, frame_count_ > 0 && frame_count_ <= MAX_FRAME_COUNT);
+    SOUL_ASSERT(0, segment_size_ > 0);
+    const Allocation allocation = page_allocator_->reserve(segment_size_ * frame_count_, 0);
+    SOUL_ASSERT(0, allocation.addr != nullptr);
+    base_addr_ = allocation.addr;
+    for (usize segment_index = 0; segment_index < frame_count_; segment_index++)
+    {
+      Segment& segment  = segments_[segment_index];
+      segment.base_addr = soul::cast<byte*>(base_addr_) + segment_index * segment_size_;
+      segment.offset.store(0, std::memory_order_relaxed);
+      segment.committed_size.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  FrameRingAllocator::~FrameRingAllocator()
+  {
+    page_allocator_->deallocate(base_addr_);
+  }
+
+  void FrameRingAllocator::begin_frame()
+  {
+    current_index_ = (current_index_ + 1) % frame_count_;
+    release_segment(segments_[current_index_]);
+  }
+
+  void FrameRingAllocator::reset()
+  {
+    for (usize segment_index = 0; segment_index < frame_count_; segment_index++)
+    {
+      release_segment(segments_[segment_index]);
+    }
+    current_index_ = 0;
+  }
+
+  auto FrameRingAllocator::try_allocate(
+    const usize size, const usize alignment, StringView /* tag */) -> Allocation
+  {
+    Segment& segment = segments_[current_index_];
+
+    // NOTE(kevinyu): The allocation size is stored right before the returned address.
+    const auto base_addr       = reinterpret_cast<uptr>(segment.base_addr);
+    const usize addr_alignment = std::max(alignment, alignof(usize));
+    usize offset               = segment.offset.load(std::memory_order_relaxed);
+    usize addr_offset;
+    usize end_offset;
+    do
+    {
+      addr_offset = align_up(base_addr + offset + sizeof(usize), addr_alignment) - base_addr;
+      end_offset  = addr_offset + size;
+      if (end_offset > segment_size_)
+      {
+        return {nullptr, 0};
+      }
+    } while (!segment.offset.compare_exchange_weak(offset, end_offset, std::memory_order_relaxed));
+
+    if (
+      segment.committed_size.load(std::memory_order_acquire) < end_offset &&
+      !commit(segment, end_offset))
+    {
+      // NOTE(kevinyu): Give the range back if no other thread has bumped past it meanwhile.
+      segment.offset.compare_exchange_strong(end_offset, offset, std::memory_order_relaxed);
+      return {nullptr, 0};
+    }
+
+    void* addr                                                  = segment.base_addr + addr_offset;
+    *soul::cast<usize*>(util::pointer_sub(addr, sizeof(usize))) = size;
+    return {addr, size};
+  }
+
+  auto FrameRingAllocator::get_allocation_size(void* addr) const -> usize
+  {
+    if (addr == nullptr)
+    {
+      return 0;
+    }
+    return *soul::cast<usize*>(util::pointer_sub(addr, sizeof(usize)));
+  }
+
+  void FrameRingAllocator::deallocate(void* addr) {}
+
+  auto FrameRingAllocator::get_frame_count() const -> usize
+  {
+    return frame_count_;
+  }
+
+  auto FrameRingAllocator::get_committed_size() const -> usize
+  {
+    usize committed_size = 0;
+    for (usize segment_index = 0; segment_index < frame_count_; segment_index++)
+    {
+      committed_size += segments_[segment_index].committed_size.load(std::memory_order_relaxed);
+    }
+    return committed_size;
+  }
+
+  void FrameRingAllocator::release_segment(Segment& segment)
+  {
+    // NOTE(kevinyu): Keep what the segment needed the last time it was used, so a steady workload
+    // does not commit and decommit every frame.
+    const usize offset         = segment.offset.load(std::memory_order_relaxed);
+    const usize keep_size      = std::min(align_up(offset, COMMIT_BLOCK_SIZE), segment_size_);
+    const usize committed_size = segment.committed_size.load(std::memory_order_relaxed);
+    if (keep_size < committed_size)
+    {
+      page_allocator_->decommit(segment.base_addr + keep_size, committed_size - keep_size);
+      segment.committed_size.store(keep_size, std::memory_order_relaxed);
+    }
+    segment.offset.store(0, std::memory_order_relaxed);
+  }
+
+  auto FrameRingAllocator::commit(Segment& segment, const usize end_offset) -> b8
+  {
+    std::lock_guard guard(commit_mutex_);
+    const usize committed_size = segment.committed_size.load(std::memory_order_relaxed);
+    if (end_offset <= committed_size)
+    {
+      return true;
+    }
+    const usize new_committed_size =
+      std::min(align_up(end_offset, COMMIT_BLOCK_SIZE), segment_size_);
+    if (!page_allocator_->commit(
+          segment.base_addr + committed_size, new_committed_size - committed_size))
+    {
+      return false;
+    }
+    segment.committed_size.store(new_committed_size, std::memory_order_release);
+    return true;
+  }
+
+} // namespace soul::memory
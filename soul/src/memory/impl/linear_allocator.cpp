@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "memory/allocators/linear_allocator.h"
 #include "memory/util.h"
 
@@ -11,31 +13,93 @@ namespace soul::memory
     const Allocation allocation = backing_allocator_->try_allocate(size, 0, name);
     base_addr_                  = allocation.addr;
     current_addr_               = base_addr_;
+    committed_addr_             = util::pointer_add(base_addr_, allocation.size);
+    high_water_addr_            = base_addr_;
+    size_                       = allocation.size;
+  }
+
+  LinearAllocator::LinearAllocator(
+    CompStr name, const usize reserve_size, PageAllocator* page_allocator)
+      : Allocator(name), page_allocator_(page_allocator)
+  {
+    SOUL_ASSERT(0, page_allocator_ != nullptr);
+    const Allocation allocation = page_allocator_->reserve(reserve_size, 0);
+    base_addr_                  = allocation.addr;
+    current_addr_               = base_addr_;
+    committed_addr_             = base_addr_;
+    high_water_addr_            = base_addr_;
+    size_                       = allocation.size;
+  }
+
+  LinearAllocator::LinearAllocator(
+    CompStr name,
+    const usize reserve_size,
+    ProxyAllocator<PageAllocator, ProfileProxy>* profile_page_allocator)
+      : Allocator(name),
+        page_allocator_(profile_page_allocator->allocator),
+        profile_page_allocator_(profile_page_allocator)
+  {
+    SOUL_ASSERT(0, page_allocator_ != nullptr);
+    const Allocation allocation = profile_page_allocator_->reserve(reserve_size, 0, name);
+    base_addr_                  = allocation.addr;
+    current_addr_               = base_addr_;
+    committed_addr_             = base_addr_;
+    high_water_addr_            = base_addr_;
     size_                       = allocation.size;
   }
 
   LinearAllocator::~LinearAllocator()
   {
-    backing_allocator_->deallocate(base_addr_);
+    if (profile_page_allocator_ != nullptr)
+    {
+      profile_page_allocator_->release(base_addr_);
+    } else if (page_allocator_ != nullptr)
+    {
+      page_allocator_->deallocate(base_addr_);
+    } else
+    {
+      backing_allocator_->deallocate(base_addr_);
+    }
   }
 
   void LinearAllocator::reset()
   {
-    current_addr_ = base_addr_;
+    high_water_addr_ = std::max(high_water_addr_, current_addr_);
+    current_addr_    = base_addr_;
+    if (page_allocator_ != nullptr)
+    {
+      // NOTE(kevinyu): Keep what the last period needed committed, so a steady workload does not
+      // commit and decommit every frame while an idle thread give its memory back.
+      void* keep_addr = util::pointer_align_forward(high_water_addr_, COMMIT_BLOCK_SIZE);
+      if (keep_addr < committed_addr_)
+      {
+        page_allocator_->decommit(
+          keep_addr,
+          soul::cast<usize>(soul::cast<byte*>(committed_addr_) - soul::cast<byte*>(keep_addr)));
+        committed_addr_ = keep_addr;
+      }
+    }
+    high_water_addr_ = base_addr_;
   }
 
   auto LinearAllocator::try_allocate(const usize size, const usize alignment, StringView /* tag */)
     -> Allocation
   {
-    auto* const size_addr =
-      soul::cast<usize*>(util::pointer_align_forward(current_addr_, alignof(usize)));
-    void* const addr = util::pointer_align_forward(util::pointer_add(size_addr, size), alignment);
-    if (util::pointer_add(base_addr_, size_) < util::pointer_add(addr, size))
+    // NOTE(kevinyu): The allocation size is stored right before the returned address.
+    void* const addr = util::pointer_align_forward(
+      util::pointer_add(current_addr_, sizeof(usize)), std::max(alignment, alignof(usize)));
+    void* const end_addr = util::pointer_add(addr, size);
+    if (util::pointer_add(base_addr_, size_) < end_addr)
+    {
+      return {nullptr, 0};
+    }
+    if (committed_addr_ < end_addr && !commit(end_addr))
     {
       return {nullptr, 0};
     }
-    current_addr_ = util::pointer_add(addr, size);
-    *size_addr    = size;
+    *soul::cast<usize*>(util::pointer_sub(addr, sizeof(usize))) = size;
+
+    current_addr_ = end_addr;
     return {addr, size};
   }
 
@@ -45,9 +109,7 @@ namespace soul::memory
     {
       return 0;
     }
-    void* size_addr =
-      util::pointer_align_backward(util::pointer_sub(addr, sizeof(usize)), alignof(usize));
-    return *soul::cast<usize*>(size_addr);
+    return *soul::cast<usize*>(util::pointer_sub(addr, sizeof(usize)));
   }
 
   void LinearAllocator::deallocate(void* addr) {}
@@ -60,7 +122,33 @@ namespace soul::memory
   void LinearAllocator::rewind(void* addr)
   {
     SOUL_ASSERT(0, addr >= base_addr_ && addr <= current_addr_);
-    current_addr_ = addr;
+    high_water_addr_ = std::max(high_water_addr_, current_addr_);
+    current_addr_    = addr;
+  }
+
+  auto LinearAllocator::get_committed_size() const -> usize
+  {
+    return soul::cast<usize>(soul::cast<byte*>(committed_addr_) - soul::cast<byte*>(base_addr_));
+  }
+
+  auto LinearAllocator::commit(void* end_addr) -> b8
+  {
+    if (page_allocator_ == nullptr)
+    {
+      return false;
+    }
+    void* const reserve_end_addr = util::pointer_add(base_addr_, size_);
+    void* const new_committed_addr =
+      std::min(util::pointer_align_forward(end_addr, COMMIT_BLOCK_SIZE), reserve_end_addr);
+    if (!page_allocator_->commit(
+          committed_addr_,
+          soul::cast<usize>(
+            soul::cast<byte*>(new_committed_addr) - soul::cast<byte*>(committed_addr_))))
+    {
+      return false;
+    }
+    committed_addr_ = new_committed_addr;
+    return true;
   }
 
 } // namespace soul::memory
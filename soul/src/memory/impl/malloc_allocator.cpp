@@ -1,7 +1,26 @@
+#include <algorithm>
+#include <cstdlib>
+
 #include "memory/allocators/malloc_allocator.h"
+#include "memory/util.h"
 
 namespace soul::memory
 {
+  namespace
+  {
+    // NOTE(kevinyu): Stored right before the address returned to the user. _msize and
+    // malloc_usable_size are not portable and do not know about the alignment padding.
+    struct AllocationHeader
+    {
+      void* base_addr;
+      usize size;
+    };
+
+    auto get_header(void* addr) -> AllocationHeader*
+    {
+      return soul::cast<AllocationHeader*>(util::pointer_sub(addr, sizeof(AllocationHeader)));
+    }
+  } // namespace
 
   MallocAllocator::MallocAllocator(CompStr name) : Allocator(name) {}
 
@@ -10,10 +29,20 @@ namespace soul::memory
     SOUL_NOT_IMPLEMENTED();
   }
 
-  auto MallocAllocator::try_allocate(usize size, usize /* alignment */, StringView /* tag */)
+  auto MallocAllocator::try_allocate(usize size, usize alignment, StringView /* tag */)
     -> Allocation
   {
-    void* addr = malloc(size); // NOLINT
+    alignment       = std::max(alignment, alignof(AllocationHeader));
+    void* base_addr = malloc(size + sizeof(AllocationHeader) + alignment - 1); // NOLINT
+    if (base_addr == nullptr)
+    {
+      return {nullptr, 0};
+    }
+    const uptr addr_value =
+      (reinterpret_cast<uptr>(base_addr) + sizeof(AllocationHeader) + alignment - 1) &
+      ~(alignment - 1);
+    void* addr        = reinterpret_cast<void*>(addr_value); // NOLINT(performance-no-int-to-ptr)
+    *get_header(addr) = {base_addr, size};
     return {addr, size};
   }
 
@@ -23,12 +52,16 @@ namespace soul::memory
     {
       return 0;
     }
-    return _msize(addr);
+    return get_header(addr)->size;
   }
 
   void MallocAllocator::deallocate(void* addr)
   {
-    free(addr); // NOLINT
+    if (addr == nullptr)
+    {
+      return;
+    }
+    free(get_header(addr)->base_addr); // NOLINT
   }
 
 } // namespace soul::memory
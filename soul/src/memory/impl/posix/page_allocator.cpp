@@ -0,0 +1,311 @@
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "memory/allocators/page_allocator.h"
+#include "memory/util.h"
+
+namespace soul::memory
+{
+  namespace
+  {
+    // NOTE(kevinyu): Stored right before the address returned to the user, inside the committed
+    // page that precede the user region.
+    struct RegionHeader
+    {
+      void* base_addr;
+      usize mapped_size;
+      usize usable_size;
+    };
+
+    constexpr usize DEFAULT_HUGE_PAGE_SIZE = 2 * ONE_MEGABYTE;
+
+    auto get_huge_page_size() -> usize
+    {
+#if defined(__linux__)
+      FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+      if (file != nullptr)
+      {
+        usize huge_page_size = 0;
+        const b8 success     = fscanf(file, "%zu", &huge_page_size) == 1;
+        fclose(file);
+        if (success && huge_page_size != 0)
+        {
+          return huge_page_size;
+        }
+      }
+#endif
+      return DEFAULT_HUGE_PAGE_SIZE;
+    }
+
+    auto align_up(usize value, usize alignment) -> usize
+    {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    auto get_header(void* addr) -> RegionHeader*
+    {
+      return soul::cast<RegionHeader*>(util::pointer_sub(addr, sizeof(RegionHeader)));
+    }
+
+#if defined(__linux__)
+    // NOTE(kevinyu): Make [addr, addr + size) accessible and fault in its huge pages now, so an
+    // empty huge page pool is reported here instead of as SIGBUS on the first access. Already
+    // populated pages are left untouched.
+    auto commit_huge_pages(void* addr, usize size) -> b8
+    {
+      if (mprotect(addr, size, PROT_READ | PROT_WRITE) != 0)
+      {
+        return false;
+      }
+      // NOTE(kevinyu): Kernel older than 5.14 does not know MADV_POPULATE_WRITE, the pages are
+      // then faulted in on first access.
+      return madvise(addr, size, MADV_POPULATE_WRITE) == 0 || errno == EINVAL;
+    }
+
+    auto reserve_huge_pages(usize size) -> void*
+    {
+      void* addr = mmap(
+        nullptr,
+        size,
+        PROT_NONE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_NORESERVE,
+        -1,
+        0);
+      return addr == MAP_FAILED ? nullptr : addr;
+    }
+#endif
+
+    // size and alignment are already rounded up to the commit granularity
+    auto reserve_huge_tlb(usize usable_size, usize region_alignment, usize huge_page_size)
+      -> Allocation
+    {
+#if defined(__linux__)
+      // NOTE(kevinyu): Huge TLB mapping can only be protected in huge page unit, so the header take
+      // a whole huge page. The region is reserved with MAP_NORESERVE and PROT_NONE, its huge pages
+      // are only taken from the pool in commit(). Over reserve to align the region, then trim the
+      // slack on both side.
+      const usize reserved_size = usable_size + region_alignment;
+      void* reserved_addr       = reserve_huge_pages(reserved_size);
+      if (reserved_addr == nullptr)
+      {
+        return {nullptr, 0};
+      }
+
+      const auto reserved_begin = reinterpret_cast<uptr>(reserved_addr);
+      const uptr addr_begin     = align_up(reserved_begin + huge_page_size, region_alignment);
+      const uptr base_begin     = addr_begin - huge_page_size;
+      const uptr base_end       = addr_begin + usable_size;
+      const uptr reserved_end   = reserved_begin + reserved_size;
+      if (base_begin != reserved_begin)
+      {
+        munmap(reserved_addr, base_begin - reserved_begin);
+      }
+      if (reserved_end != base_end)
+      {
+        munmap(reinterpret_cast<void*>(base_end), reserved_end - base_end); // NOLINT
+      }
+
+      void* base_addr = reinterpret_cast<void*>(base_begin); // NOLINT(performance-no-int-to-ptr)
+      if (!commit_huge_pages(base_addr, huge_page_size))
+      {
+        munmap(base_addr, huge_page_size + usable_size);
+        return {nullptr, 0};
+      }
+      void* addr = reinterpret_cast<void*>(addr_begin); // NOLINT(performance-no-int-to-ptr)
+      *get_header(addr) = {base_addr, huge_page_size + usable_size, usable_size};
+      return {addr, usable_size};
+#else
+      return {nullptr, 0};
+#endif
+    }
+
+    auto reserve_pages(
+      usize usable_size, usize region_alignment, usize page_size, HugePageMode huge_page_mode)
+      -> Allocation
+    {
+      // NOTE(kevinyu): Reserve one extra page for the header and enough slack to align the region.
+      const usize mapped_size = page_size + usable_size + region_alignment - page_size;
+      void* base_addr =
+        mmap(nullptr, mapped_size, PROT_NONE, MAP_PRIVATE | MAP_ANON | MAP_NORESERVE, -1, 0);
+      if (base_addr == MAP_FAILED)
+      {
+        return {nullptr, 0};
+      }
+
+      const usize addr_offset =
+        align_up(reinterpret_cast<uptr>(base_addr) + page_size, region_alignment) -
+        reinterpret_cast<uptr>(base_addr);
+      void* addr = util::pointer_add(base_addr, addr_offset);
+      mprotect(util::pointer_sub(addr, page_size), page_size, PROT_READ | PROT_WRITE);
+      *get_header(addr) = {base_addr, mapped_size, usable_size};
+
+#if defined(__linux__)
+      if (huge_page_mode != HugePageMode::NONE)
+      {
+        madvise(addr, usable_size, MADV_HUGEPAGE);
+      }
+#endif
+
+      return {addr, usable_size};
+    }
+  } // namespace
+
+  PageAllocator::PageAllocator(CompStr name, HugePageMode huge_page_mode)
+      : Allocator(name), huge_page_mode_(huge_page_mode)
+  {
+    page_size_      = soul::cast<usize>(sysconf(_SC_PAGESIZE));
+    huge_page_size_ = get_huge_page_size();
+  }
+
+  void PageAllocator::reset() {}
+
+  auto PageAllocator::try_allocate(usize size, usize alignment, StringView /* tag */)
+    -> Allocation
+  {
+    const usize granularity      = get_commit_granularity();
+    const usize region_alignment = std::max(granularity, alignment);
+    const usize usable_size      = align_up(size, granularity);
+
+    if (huge_page_mode_ == HugePageMode::EXPLICIT)
+    {
+      // NOTE(kevinyu): The region is committed right away, so an empty huge page pool is only
+      // known at commit time. Fall back to normal page like reserve() does.
+      const Allocation allocation =
+        reserve_huge_tlb(usable_size, region_alignment, huge_page_size_);
+      if (allocation.addr != nullptr)
+      {
+        if (commit(allocation.addr, allocation.size))
+        {
+          return allocation;
+        }
+        deallocate(allocation.addr);
+      }
+    }
+
+    const Allocation allocation =
+      reserve_pages(usable_size, region_alignment, page_size_, huge_page_mode_);
+    if (allocation.addr != nullptr && !commit(allocation.addr, allocation.size))
+    {
+      deallocate(allocation.addr);
+      return {nullptr, 0};
+    }
+    return allocation;
+  }
+
+  auto PageAllocator::reserve(usize size, usize alignment) -> Allocation
+  {
+    const usize granularity      = get_commit_granularity();
+    const usize region_alignment = std::max(granularity, alignment);
+    const usize usable_size      = align_up(size, granularity);
+
+    if (huge_page_mode_ == HugePageMode::EXPLICIT)
+    {
+      const Allocation allocation =
+        reserve_huge_tlb(usable_size, region_alignment, huge_page_size_);
+      if (allocation.addr != nullptr)
+      {
+        return allocation;
+      }
+    }
+    return reserve_pages(usable_size, region_alignment, page_size_, huge_page_mode_);
+  }
+
+  auto PageAllocator::commit(void* addr, usize size) -> b8
+  {
+    const usize granularity = get_commit_granularity();
+    const auto begin        = reinterpret_cast<uptr>(addr) & ~(granularity - 1);
+    const auto end          = align_up(reinterpret_cast<uptr>(addr) + size, granularity);
+#if defined(__linux__)
+    // NOTE(kevinyu): Also used for region that fall back to transparent huge page in reserve(),
+    // populating them is harmless.
+    if (huge_page_mode_ == HugePageMode::EXPLICIT)
+    {
+      return commit_huge_pages(
+        reinterpret_cast<void*>(begin), // NOLINT(performance-no-int-to-ptr)
+        end - begin);
+    }
+#endif
+    const auto result = mprotect(
+      reinterpret_cast<void*>(begin), // NOLINT(performance-no-int-to-ptr)
+      end - begin,
+      PROT_READ | PROT_WRITE);
+    return result == 0;
+  }
+
+  void PageAllocator::decommit(void* addr, usize size)
+  {
+    const usize granularity = get_commit_granularity();
+    const auto begin        = align_up(reinterpret_cast<uptr>(addr), granularity);
+    const auto end          = (reinterpret_cast<uptr>(addr) + size) & ~(granularity - 1);
+    if (end <= begin)
+    {
+      return;
+    }
+#if defined(__linux__)
+    if (huge_page_mode_ == HugePageMode::EXPLICIT)
+    {
+      // NOTE(kevinyu): Give the huge pages back to the pool but keep the range huge TLB backed.
+      // Kernel older than 5.18 cannot MADV_DONTNEED huge TLB page, the range is then remapped
+      // below with normal page.
+      void* begin_addr = reinterpret_cast<void*>(begin); // NOLINT(performance-no-int-to-ptr)
+      if (madvise(begin_addr, end - begin, MADV_DONTNEED) == 0)
+      {
+        const auto result = mprotect(begin_addr, end - begin, PROT_NONE);
+        SOUL_ASSERT(0, result == 0);
+        return;
+      }
+    }
+#endif
+    // NOTE(kevinyu): Mapping a fresh PROT_NONE region on top drop the physical pages on both Linux
+    // and macOS while keeping the address range reserved.
+    void* result = mmap(
+      reinterpret_cast<void*>(begin), // NOLINT(performance-no-int-to-ptr)
+      end - begin,
+      PROT_NONE,
+      MAP_FIXED | MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
+      -1,
+      0);
+    SOUL_ASSERT(0, result != MAP_FAILED);
+#if defined(__linux__)
+    if (huge_page_mode_ != HugePageMode::NONE)
+    {
+      madvise(result, end - begin, MADV_HUGEPAGE);
+    }
+#endif
+  }
+
+  auto PageAllocator::get_allocation_size(void* addr) const -> usize
+  {
+    if (addr == nullptr)
+    {
+      return 0;
+    }
+    return get_header(addr)->usable_size;
+  }
+
+  void PageAllocator::deallocate(void* addr)
+  {
+    if (addr == nullptr)
+    {
+      return;
+    }
+    const RegionHeader header = *get_header(addr);
+    const auto result         = munmap(header.base_addr, header.mapped_size);
+    SOUL_ASSERT(0, result == 0);
+  }
+
+  auto PageAllocator::get_page_size() const -> usize
+  {
+    return page_size_;
+  }
+
+  auto PageAllocator::get_commit_granularity() const -> usize
+  {
+    // NOTE(kevinyu): Huge page region is aligned and sized to the huge page, commit it in huge page
+    // unit so we never split a huge TLB mapping.
+    return huge_page_mode_ == HugePageMode::NONE ? page_size_ : huge_page_size_;
+  }
+
+} // namespace soul::memory
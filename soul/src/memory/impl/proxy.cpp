@@ -10,16 +10,11 @@ namespace soul::memory
     name_ = name;
   }
 
-  auto ProfileProxy::on_pre_allocate(const AllocateParam& alloc_param) -> AllocateParam
-  {
-    current_alloc_ = alloc_param;
-    return alloc_param;
-  }
-
-  auto ProfileProxy::on_post_allocate(const Allocation allocation) -> Allocation
+  auto ProfileProxy::on_post_allocate(const AllocateParam& alloc_param, const Allocation allocation)
+    -> Allocation
   {
     SOUL_MEMPROFILE_REGISTER_ALLOCATION(
-      name_.data(), current_alloc_.tag, allocation.addr, current_alloc_.size);
+      name_.data(), alloc_param.tag.data(), allocation.addr, alloc_param.size);
     return allocation;
   }
 
@@ -35,7 +30,7 @@ namespace soul::memory
 
   void ProfileProxy::on_pre_cleanup()
   {
-    SOUL_MEMPROFILE_DEREGISTER_ALLOCATOR(name_);
+    SOUL_MEMPROFILE_DEREGISTER_ALLOCATOR(name_.data());
   }
 
 } // namespace soul::memory
@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <bit>
+#include <memory>
+
+#include "memory/allocators/slab_allocator.h"
+#include "memory/impl/thread_cache_slot.h"
+#include "memory/util.h"
+
+namespace soul::memory
+{
+  struct SlabAllocator::SlabHeader
+  {
+    u32 size_class;
+    usize large_size;
+    SlabHeader* prev;
+    SlabHeader* next;
+  };
+
+  namespace
+  {
+    constexpr u32 LARGE_SIZE_CLASS         = ~0u;
+    constexpr usize SLAB_HEADER_SIZE       = SOUL_CACHELINE_SIZE;
+    constexpr usize MAGAZINE_BATCH_SIZE    = 4 * ONE_KILOBYTE;
+    constexpr u32 MIN_MAGAZINE_CAPACITY    = 4;
+    constexpr u32 MAX_MAGAZINE_CAPACITY    = 32;
+    constexpr u32 MIN_BLOCK_SIZE_BIT_WIDTH = std::bit_width(SlabAllocator::MIN_BLOCK_SIZE - 1);
+
+    auto get_size_class(usize block_size) -> u32
+    {
+      block_size = std::max(block_size, SlabAllocator::MIN_BLOCK_SIZE);
+      return soul::cast<u32>(std::bit_width(block_size - 1)) - MIN_BLOCK_SIZE_BIT_WIDTH;
+    }
+
+    // NOTE(kevinyu): The first block start at its own size, so every block is aligned to its size.
+    auto get_first_block_offset(usize block_size) -> usize
+    {
+      return std::max(SLAB_HEADER_SIZE, block_size);
+    }
+  } // namespace
+
+  SlabAllocator::SlabAllocator(CompStr name, Allocator* backing_allocator, const Config& config)
+      : Allocator(name), backing_allocator_(backing_allocator), config_(config)
+  {
+    SOUL_ASSERT(0, backing_allocator_ != nullptr);
+    SOUL_ASSERT(0, std::has_single_bit(config_.slab_size), "Slab size must be a power of two");
+    SOUL_ASSERT(
+      0, std::has_single_bit(config_.max_block_size), "Max block size must be a power of two");
+    SOUL_ASSERT(0, config_.max_block_size >= MIN_BLOCK_SIZE);
+    SOUL_ASSERT(0, config_.max_block_size <= config_.slab_size / 8, "Max block size is too big");
+    size_class_count_ = get_size_class(config_.max_block_size) + 1;
+    SOUL_ASSERT(0, size_class_count_ <= MAX_SIZE_CLASS_COUNT);
+
+    if (config_.thread_magazine)
+    {
+      const usize magazine_count = usize(impl::MAX_THREAD_CACHE_SLOT_COUNT) * size_class_count_;
+      magazines_                 = backing_allocator_->allocate_array<Magazine>(magazine_count);
+      std::uninitialized_value_construct_n(magazines_, magazine_count);
+    }
+  }
+
+  SlabAllocator::~SlabAllocator()
+  {
+    reset();
+    while (free_slabs_ != nullptr)
+    {
+      SlabHeader* next = free_slabs_->next;
+      backing_allocator_->deallocate(free_slabs_);
+      free_slabs_ = next;
+    }
+    if (magazines_ != nullptr)
+    {
+      backing_allocator_->deallocate(magazines_);
+    }
+  }
+
+  void SlabAllocator::reset()
+  {
+    auto guard = lock();
+    std::fill_n(free_lists_, MAX_SIZE_CLASS_COUNT, nullptr);
+    if (magazines_ != nullptr)
+    {
+      const usize magazine_count = usize(impl::MAX_THREAD_CACHE_SLOT_COUNT) * size_class_count_;
+      std::fill_n(magazines_, magazine_count, Magazine());
+    }
+
+    while (used_slabs_ != nullptr)
+    {
+      SlabHeader* next  = used_slabs_->next;
+      used_slabs_->next = free_slabs_;
+      free_slabs_       = used_slabs_;
+      used_slabs_       = next;
+    }
+
+    while (large_allocations_ != nullptr)
+    {
+      SlabHeader* next = large_allocations_->next;
+      backing_allocator_->deallocate(large_allocations_);
+      large_allocations_ = next;
+    }
+  }
+
+  auto SlabAllocator::try_allocate(usize size, usize alignment, StringView /* tag */)
+    -> Allocation
+  {
+    SOUL_ASSERT(0, alignment == 0 || std::has_single_bit(alignment));
+    const usize block_size = std::max(size, alignment);
+    if (block_size > config_.max_block_size)
+    {
+      return allocate_large(size, alignment);
+    }
+    void* block = allocate_block(get_size_class(block_size));
+    if (block == nullptr)
+    {
+      return {nullptr, 0};
+    }
+    return {block, size};
+  }
+
+  auto SlabAllocator::get_allocation_size(void* addr) const -> usize
+  {
+    if (addr == nullptr)
+    {
+      return 0;
+    }
+    const auto* slab =
+      soul::cast<const SlabHeader*>(util::pointer_align_backward(addr, config_.slab_size));
+    if (slab->size_class == LARGE_SIZE_CLASS)
+    {
+      return slab->large_size;
+    }
+    return get_block_size(slab->size_class);
+  }
+
+  void SlabAllocator::deallocate(void* addr)
+  {
+    if (addr == nullptr)
+    {
+      return;
+    }
+    auto* slab = soul::cast<SlabHeader*>(util::pointer_align_backward(addr, config_.slab_size));
+    if (slab->size_class != LARGE_SIZE_CLASS)
+    {
+      deallocate_block(addr, slab->size_class);
+      return;
+    }
+
+    {
+      auto guard = lock();
+      if (slab->prev != nullptr)
+      {
+        slab->prev->next = slab->next;
+      } else
+      {
+        large_allocations_ = slab->next;
+      }
+      if (slab->next != nullptr)
+      {
+        slab->next->prev = slab->prev;
+      }
+    }
+    backing_allocator_->deallocate(slab);
+  }
+
+  auto SlabAllocator::lock() -> std::unique_lock<std::mutex>
+  {
+    if (config_.thread_magazine)
+    {
+      return std::unique_lock(mutex_);
+    }
+    return {};
+  }
+
+  auto SlabAllocator::allocate_block(u32 size_class) -> void*
+  {
+    const u32 slot = magazines_ != nullptr ? impl::get_thread_cache_slot()
+                                           : impl::INVALID_THREAD_CACHE_SLOT;
+    if (slot == impl::INVALID_THREAD_CACHE_SLOT)
+    {
+      auto guard = lock();
+      if (free_lists_[size_class] == nullptr && !refill_free_list(size_class))
+      {
+        return nullptr;
+      }
+      FreeBlock* block        = free_lists_[size_class];
+      free_lists_[size_class] = block->next;
+      return block;
+    }
+
+    Magazine& magazine = magazines_[slot * size_class_count_ + size_class];
+    if (magazine.head == nullptr)
+    {
+      // NOTE(kevinyu): Fill the magazine half way, so a following deallocation does not
+      // immediately overflow it.
+      const u32 fill_count = get_magazine_capacity(size_class) / 2;
+      auto guard           = lock();
+      while (magazine.count < fill_count)
+      {
+        if (free_lists_[size_class] == nullptr && !refill_free_list(size_class))
+        {
+          break;
+        }
+        FreeBlock* block        = free_lists_[size_class];
+        free_lists_[size_class] = block->next;
+        block->next             = magazine.head;
+        magazine.head           = block;
+        magazine.count++;
+      }
+      if (magazine.head == nullptr)
+      {
+        return nullptr;
+      }
+    }
+    FreeBlock* block = magazine.head;
+    magazine.head    = block->next;
+    magazine.count--;
+    return block;
+  }
+
+  void SlabAllocator::deallocate_block(void* block, u32 size_class)
+  {
+    auto* free_block = soul::cast<FreeBlock*>(block);
+    const u32 slot   = magazines_ != nullptr ? impl::get_thread_cache_slot()
+                                             : impl::INVALID_THREAD_CACHE_SLOT;
+    if (slot == impl::INVALID_THREAD_CACHE_SLOT)
+    {
+      auto guard              = lock();
+      free_block->next        = free_lists_[size_class];
+      free_lists_[size_class] = free_block;
+      return;
+    }
+
+    Magazine& magazine = magazines_[slot * size_class_count_ + size_class];
+    free_block->next   = magazine.head;
+    magazine.head      = free_block;
+    magazine.count++;
+
+    const u32 capacity = get_magazine_capacity(size_class);
+    if (magazine.count > capacity)
+    {
+      auto guard = lock();
+      while (magazine.count > capacity / 2)
+      {
+        FreeBlock* flushed_block = magazine.head;
+        magazine.head            = flushed_block->next;
+        flushed_block->next      = free_lists_[size_class];
+        free_lists_[size_class]  = flushed_block;
+        magazine.count--;
+      }
+    }
+  }
+
+  auto SlabAllocator::allocate_large(usize size, usize alignment) -> Allocation
+  {
+    SOUL_ASSERT(0, alignment < config_.slab_size, "Alignment must be smaller than the slab size");
+    const usize offset = std::max(SLAB_HEADER_SIZE, alignment);
+    const Allocation allocation =
+      backing_allocator_->try_allocate(offset + size, config_.slab_size, name());
+    if (allocation.addr == nullptr)
+    {
+      return {nullptr, 0};
+    }
+    SOUL_ASSERT(
+      0,
+      util::pointer_align_backward(allocation.addr, config_.slab_size) == allocation.addr,
+      "Backing allocator does not honor the slab alignment");
+
+    auto* slab       = soul::cast<SlabHeader*>(allocation.addr);
+    slab->size_class = LARGE_SIZE_CLASS;
+    slab->large_size = size;
+    slab->prev       = nullptr;
+    {
+      auto guard = lock();
+      slab->next = large_allocations_;
+      if (large_allocations_ != nullptr)
+      {
+        large_allocations_->prev = slab;
+      }
+      large_allocations_ = slab;
+    }
+    return {util::pointer_add(allocation.addr, offset), size};
+  }
+
+  auto SlabAllocator::refill_free_list(u32 size_class) -> b8
+  {
+    SlabHeader* slab = free_slabs_;
+    if (slab != nullptr)
+    {
+      free_slabs_ = slab->next;
+    } else
+    {
+      const Allocation allocation =
+        backing_allocator_->try_allocate(config_.slab_size, config_.slab_size, name());
+      if (allocation.addr == nullptr)
+      {
+        return false;
+      }
+      SOUL_ASSERT(
+        0,
+        util::pointer_align_backward(allocation.addr, config_.slab_size) == allocation.addr,
+        "Backing allocator does not honor the slab alignment");
+      slab = soul::cast<SlabHeader*>(allocation.addr);
+    }
+    slab->size_class = size_class;
+    slab->prev       = nullptr;
+    slab->next       = used_slabs_;
+    used_slabs_      = slab;
+
+    // NOTE(kevinyu): Push in reverse so the blocks are handed out in address order.
+    const usize block_size         = get_block_size(size_class);
+    const usize first_block_offset = get_first_block_offset(block_size);
+    for (usize offset = config_.slab_size - block_size; offset >= first_block_offset;
+         offset -= block_size)
+    {
+      auto* block             = soul::cast<FreeBlock*>(util::pointer_add(slab, offset));
+      block->next             = free_lists_[size_class];
+      free_lists_[size_class] = block;
+    }
+    return true;
+  }
+
+  auto SlabAllocator::get_block_size(u32 size_class) const -> usize
+  {
+    return MIN_BLOCK_SIZE << size_class;
+  }
+
+  auto SlabAllocator::get_magazine_capacity(u32 size_class) const -> u32
+  {
+    const usize capacity = MAGAZINE_BATCH_SIZE / get_block_size(size_class);
+    return soul::cast<u32>(
+      std::clamp<usize>(capacity, MIN_MAGAZINE_CAPACITY, MAX_MAGAZINE_CAPACITY));
+  }
+
+} // namespace soul::memory
@@ -0,0 +1,63 @@
+#include <mutex>
+
+#include "memory/impl/thread_cache_slot.h"
+
+namespace soul::memory::impl
+{
+  namespace
+  {
+    std::mutex g_thread_cache_slot_mutex;                          // NOLINT
+    b8 g_thread_cache_slot_used[MAX_THREAD_CACHE_SLOT_COUNT] = {}; // NOLINT
+
+    class ThreadCacheSlot
+    {
+    public:
+      ThreadCacheSlot()
+      {
+        std::lock_guard guard(g_thread_cache_slot_mutex);
+        for (u32 slot_index = 0; slot_index < MAX_THREAD_CACHE_SLOT_COUNT; slot_index++)
+        {
+          if (!g_thread_cache_slot_used[slot_index])
+          {
+            g_thread_cache_slot_used[slot_index] = true;
+            index_                               = slot_index;
+            break;
+          }
+        }
+      }
+
+      ThreadCacheSlot(const ThreadCacheSlot&) = delete;
+
+      auto operator=(const ThreadCacheSlot&) -> ThreadCacheSlot& = delete;
+
+      ThreadCacheSlot(ThreadCacheSlot&&) = delete;
+
+      auto operator=(ThreadCacheSlot&&) -> ThreadCacheSlot& = delete;
+
+      ~ThreadCacheSlot()
+      {
+        if (index_ != INVALID_THREAD_CACHE_SLOT)
+        {
+          std::lock_guard guard(g_thread_cache_slot_mutex);
+          g_thread_cache_slot_used[index_] = false;
+          index_                           = INVALID_THREAD_CACHE_SLOT;
+        }
+      }
+
+      [[nodiscard]]
+      auto index() const -> u32
+      {
+        return index_;
+      }
+
+    private:
+      u32 index_ = INVALID_THREAD_CACHE_SLOT;
+    };
+  } // namespace
+
+  auto get_thread_cache_slot() -> u32
+  {
+    thread_local ThreadCacheSlot slot;
+    return slot.index();
+  }
+} // namespace soul::memory::impl
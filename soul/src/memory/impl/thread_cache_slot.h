@@ -0,0 +1,17 @@
+#pragma once
+
+#include "core/type.h"
+
+namespace soul::memory::impl
+{
+  inline constexpr u32 MAX_THREAD_CACHE_SLOT_COUNT = 128;
+  inline constexpr u32 INVALID_THREAD_CACHE_SLOT   = ~0u;
+
+  /*
+    Return a dense index of the calling thread, shared by every allocator that keep per-thread
+    cache. The slot is taken the first time a thread call this and given back when the thread
+    exit, so the next thread that take the slot inherit whatever is cached in it. Return
+    INVALID_THREAD_CACHE_SLOT when all MAX_THREAD_CACHE_SLOT_COUNT slots are taken.
+  */
+  auto get_thread_cache_slot() -> u32;
+} // namespace soul::memory::impl
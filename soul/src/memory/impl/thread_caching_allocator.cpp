@@ -0,0 +1,457 @@
+#include <algorithm>
+#include <bit>
+
+#include "memory/allocators/thread_caching_allocator.h"
+#include "memory/impl/thread_cache_slot.h"
+#include "memory/util.h"
+
+namespace soul::memory
+{
+  namespace
+  {
+    constexpr u32 LARGE_SIZE_CLASS          = ~0u;
+    constexpr usize CHUNK_HEADER_SIZE       = SOUL_CACHELINE_SIZE;
+    constexpr usize SPAN_SIZE               = 16 * ThreadCachingAllocator::CHUNK_SIZE;
+    constexpr usize THREAD_CACHE_BATCH_SIZE = 8 * ONE_KILOBYTE;
+    constexpr u32 MAX_THREAD_CACHE_BATCH    = 32;
+    constexpr usize LARGE_BLOCK_GRANULARITY = 4 * ONE_KILOBYTE;
+
+    struct ChunkHeader
+    {
+      u32 size_class;
+      usize large_size;
+      usize large_capacity;
+      // NOTE(kevinyu): Link a large block into the live list or the cache.
+      ChunkHeader* prev;
+      ChunkHeader* next;
+      // NOTE(kevinyu): Only used by the first chunk of a span, to link all the spans together.
+      void* next_span;
+    };
+    static_assert(sizeof(ChunkHeader) <= CHUNK_HEADER_SIZE);
+
+    /*
+      Size class 0 - 7 are 16 bytes apart up to 128 bytes. After that every power of two is split
+      into 4 size classes, so the internal fragmentation is at most 25%.
+    */
+    constexpr auto get_size_class(usize size) -> u32
+    {
+      if (size <= 128)
+      {
+        return soul::cast<u32>((std::max<usize>(size, 1) + 15) / 16) - 1;
+      }
+      const usize value = size - 1;
+      const u32 msb     = 63 - soul::cast<u32>(std::countl_zero(value));
+      return 8 + (msb - 7) * 4 + soul::cast<u32>((value >> (msb - 2)) & 3);
+    }
+
+    constexpr auto get_size_class_size(u32 size_class) -> usize
+    {
+      if (size_class < 8)
+      {
+        return (usize(size_class) + 1) * 16;
+      }
+      const u32 msb = 7 + (size_class - 8) / 4;
+      const u32 sub = (size_class - 8) % 4;
+      return (usize(1) << msb) + (usize(sub) + 1) * (usize(1) << (msb - 2));
+    }
+
+    static_assert(
+      get_size_class(ThreadCachingAllocator::MAX_SMALL_SIZE) ==
+      ThreadCachingAllocator::SIZE_CLASS_COUNT - 1);
+    static_assert(
+      get_size_class_size(ThreadCachingAllocator::SIZE_CLASS_COUNT - 1) ==
+      ThreadCachingAllocator::MAX_SMALL_SIZE);
+    static_assert(get_size_class(160) == 8 && get_size_class(161) == 9);
+
+    constexpr auto get_thread_cache_batch(u32 size_class) -> u32
+    {
+      const usize batch = THREAD_CACHE_BATCH_SIZE / get_size_class_size(size_class);
+      return soul::cast<u32>(std::clamp<usize>(batch, 2, MAX_THREAD_CACHE_BATCH));
+    }
+
+    auto align_up(usize value, usize alignment) -> usize
+    {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    auto get_chunk_header(const void* addr) -> ChunkHeader*
+    {
+      return soul::cast<ChunkHeader*>(
+        util::pointer_align_backward(addr, ThreadCachingAllocator::CHUNK_SIZE));
+    }
+
+    auto get_size_tag(void* block, u32 size_class) -> u32*
+    {
+      return soul::cast<u32*>(util::pointer_add(
+        block, get_size_class_size(size_class) - ThreadCachingAllocator::SIZE_TAG_SIZE));
+    }
+
+    auto get_block_index(const ChunkHeader* chunk, const void* addr, usize block_size) -> usize
+    {
+      const auto offset = soul::cast<usize>(
+        soul::cast<const byte*>(addr) - soul::cast<const byte*>(chunk) - CHUNK_HEADER_SIZE);
+      return offset / block_size;
+    }
+
+    void link_chunk(void** list, ChunkHeader* chunk)
+    {
+      auto* head  = soul::cast<ChunkHeader*>(*list);
+      chunk->prev = nullptr;
+      chunk->next = head;
+      if (head != nullptr)
+      {
+        head->prev = chunk;
+      }
+      *list = chunk;
+    }
+
+    void unlink_chunk(void** list, ChunkHeader* chunk)
+    {
+      if (chunk->prev != nullptr)
+      {
+        chunk->prev->next = chunk->next;
+      } else
+      {
+        *list = chunk->next;
+      }
+      if (chunk->next != nullptr)
+      {
+        chunk->next->prev = chunk->prev;
+      }
+    }
+
+    void deallocate_chunk_list(Allocator* allocator, void* list)
+    {
+      auto* chunk = soul::cast<ChunkHeader*>(list);
+      while (chunk != nullptr)
+      {
+        ChunkHeader* next = chunk->next;
+        allocator->deallocate(chunk);
+        chunk = next;
+      }
+    }
+
+    void deallocate_span_list(Allocator* allocator, void* list)
+    {
+      void* span = list;
+      while (span != nullptr)
+      {
+        void* next_span = soul::cast<ChunkHeader*>(span)->next_span;
+        allocator->deallocate(span);
+        span = next_span;
+      }
+    }
+  } // namespace
+
+  ThreadCachingAllocator::ThreadCachingAllocator(CompStr name, Allocator* backing_allocator)
+      : Allocator(name), backing_allocator_(backing_allocator)
+  {
+    SOUL_ASSERT(0, backing_allocator_ != nullptr);
+    thread_caches_ = soul::cast<ThreadCache*>(backing_allocator_->allocate(
+      sizeof(ThreadCache) * MAX_THREAD_CACHE_COUNT, alignof(ThreadCache), name));
+    for (u32 cache_index = 0; cache_index < MAX_THREAD_CACHE_COUNT; cache_index++)
+    {
+      new (thread_caches_ + cache_index) ThreadCache();
+    }
+  }
+
+  ThreadCachingAllocator::~ThreadCachingAllocator()
+  {
+    deallocate_span_list(backing_allocator_, span_list_);
+    deallocate_span_list(backing_allocator_, free_span_list_);
+    deallocate_chunk_list(backing_allocator_, large_allocations_);
+    deallocate_chunk_list(backing_allocator_, large_cache_);
+    backing_allocator_->deallocate(thread_caches_);
+  }
+
+  void ThreadCachingAllocator::reset()
+  {
+    for (u32 cache_index = 0; cache_index < MAX_THREAD_CACHE_COUNT; cache_index++)
+    {
+      thread_caches_[cache_index] = ThreadCache();
+    }
+    for (CentralBin& central_bin : central_bins_)
+    {
+      std::lock_guard guard(central_bin.mutex);
+      central_bin.head  = nullptr;
+      central_bin.count = 0;
+    }
+
+    {
+      // NOTE(kevinyu): The chunk headers of a span are left as they are, so next_span of the first
+      // chunk is still valid and the span can be moved to the free list as a whole.
+      std::lock_guard guard(chunk_mutex_);
+      while (span_list_ != nullptr)
+      {
+        auto* span_header      = soul::cast<ChunkHeader*>(span_list_);
+        void* next_span        = span_header->next_span;
+        span_header->next_span = free_span_list_;
+        free_span_list_        = span_list_;
+        span_list_             = next_span;
+      }
+      span_cursor_ = nullptr;
+      span_end_    = nullptr;
+    }
+
+    std::lock_guard guard(large_mutex_);
+    deallocate_chunk_list(backing_allocator_, large_allocations_);
+    large_allocations_ = nullptr;
+  }
+
+  auto ThreadCachingAllocator::try_allocate(usize size, usize alignment, StringView /* tag */)
+    -> Allocation
+  {
+    alignment = std::max(alignment, MIN_ALIGNMENT);
+    SOUL_ASSERT(0, std::has_single_bit(alignment), "Alignment must be a power of two");
+    SOUL_ASSERT(0, alignment < CHUNK_SIZE, "Alignment must be smaller than the chunk size");
+
+    // NOTE(kevinyu): Every block start at MIN_ALIGNMENT, bigger alignment is handled by reserving
+    // enough slack to align inside the block. The last SIZE_TAG_SIZE bytes of the block keep the
+    // requested size, the proxies need the exact size and not the size class.
+    const usize block_size = size + alignment - MIN_ALIGNMENT + SIZE_TAG_SIZE;
+    if (block_size > MAX_SMALL_SIZE)
+    {
+      return allocate_large(size, alignment);
+    }
+
+    const u32 size_class = get_size_class(block_size);
+    void* block          = allocate_small(size_class);
+    if (block == nullptr)
+    {
+      return {nullptr, 0};
+    }
+    *get_size_tag(block, size_class) = soul::cast<u32>(size);
+    const usize addr                 = align_up(reinterpret_cast<uptr>(block), alignment);
+    return {reinterpret_cast<void*>(addr), size}; // NOLINT(performance-no-int-to-ptr)
+  }
+
+  auto ThreadCachingAllocator::get_allocation_size(void* addr) const -> usize
+  {
+    if (addr == nullptr)
+    {
+      return 0;
+    }
+    const ChunkHeader* chunk = get_chunk_header(addr);
+    if (chunk->size_class == LARGE_SIZE_CLASS)
+    {
+      return chunk->large_size;
+    }
+    const usize block_size  = get_size_class_size(chunk->size_class);
+    const usize block_index = get_block_index(chunk, addr, block_size);
+    return *get_size_tag(
+      util::pointer_add(chunk, CHUNK_HEADER_SIZE + block_index * block_size), chunk->size_class);
+  }
+
+  void ThreadCachingAllocator::deallocate(void* addr)
+  {
+    if (addr == nullptr)
+    {
+      return;
+    }
+    ChunkHeader* chunk = get_chunk_header(addr);
+    if (chunk->size_class == LARGE_SIZE_CLASS)
+    {
+      deallocate_large(chunk);
+      return;
+    }
+    const usize block_size  = get_size_class_size(chunk->size_class);
+    const usize block_index = get_block_index(chunk, addr, block_size);
+    deallocate_small(
+      util::pointer_add(chunk, CHUNK_HEADER_SIZE + block_index * block_size), chunk->size_class);
+  }
+
+  auto ThreadCachingAllocator::allocate_small(u32 size_class) -> void*
+  {
+    const u32 cache_index = impl::get_thread_cache_slot();
+    if (cache_index == impl::INVALID_THREAD_CACHE_SLOT)
+    {
+      ThreadCacheBin bin;
+      fetch_from_central(size_class, &bin, 1);
+      return bin.head;
+    }
+
+    ThreadCacheBin& bin = thread_caches_[cache_index].bins[size_class];
+    if (bin.head == nullptr &&
+        fetch_from_central(size_class, &bin, get_thread_cache_batch(size_class)) == 0)
+    {
+      return nullptr;
+    }
+    FreeBlock* block = bin.head;
+    bin.head         = block->next;
+    bin.count--;
+    return block;
+  }
+
+  void ThreadCachingAllocator::deallocate_small(void* block, u32 size_class)
+  {
+    auto* free_block      = soul::cast<FreeBlock*>(block);
+    const u32 cache_index = impl::get_thread_cache_slot();
+    if (cache_index == impl::INVALID_THREAD_CACHE_SLOT)
+    {
+      ThreadCacheBin bin = {free_block, 1};
+      free_block->next   = nullptr;
+      release_to_central(size_class, &bin, 1);
+      return;
+    }
+
+    // NOTE(kevinyu): A block freed by another thread goes to the cache of the freeing thread.
+    // Blocks of the same size class are interchangeable, the central free list rebalance them.
+    ThreadCacheBin& bin = thread_caches_[cache_index].bins[size_class];
+    free_block->next    = bin.head;
+    bin.head            = free_block;
+    bin.count++;
+    const u32 batch = get_thread_cache_batch(size_class);
+    if (bin.count > 2 * batch)
+    {
+      release_to_central(size_class, &bin, batch);
+    }
+  }
+
+  auto ThreadCachingAllocator::allocate_large(usize size, usize alignment) -> Allocation
+  {
+    const usize offset   = std::max(CHUNK_HEADER_SIZE, alignment);
+    const usize capacity = align_up(offset + size, LARGE_BLOCK_GRANULARITY);
+    {
+      // NOTE(kevinyu): Take the first cached block that waste at most a quarter of the capacity.
+      std::lock_guard guard(large_mutex_);
+      auto* chunk = soul::cast<ChunkHeader*>(large_cache_);
+      while (chunk != nullptr &&
+             (chunk->large_capacity < capacity || chunk->large_capacity - capacity > capacity / 4))
+      {
+        chunk = chunk->next;
+      }
+      if (chunk != nullptr)
+      {
+        unlink_chunk(&large_cache_, chunk);
+        large_cache_size_ -= chunk->large_capacity;
+        chunk->large_size = size;
+        link_chunk(&large_allocations_, chunk);
+        return {util::pointer_add(chunk, offset), size};
+      }
+    }
+
+    const Allocation allocation = backing_allocator_->try_allocate(capacity, CHUNK_SIZE, name());
+    if (allocation.addr == nullptr)
+    {
+      return {nullptr, 0};
+    }
+    SOUL_ASSERT(0, get_chunk_header(allocation.addr) == allocation.addr);
+    auto* chunk           = soul::cast<ChunkHeader*>(allocation.addr);
+    chunk->size_class     = LARGE_SIZE_CLASS;
+    chunk->large_size     = size;
+    chunk->large_capacity = capacity;
+    chunk->next_span      = nullptr;
+    {
+      std::lock_guard guard(large_mutex_);
+      link_chunk(&large_allocations_, chunk);
+    }
+    return {util::pointer_add(chunk, offset), size};
+  }
+
+  void ThreadCachingAllocator::deallocate_large(void* chunk_addr)
+  {
+    auto* chunk = soul::cast<ChunkHeader*>(chunk_addr);
+    {
+      std::lock_guard guard(large_mutex_);
+      unlink_chunk(&large_allocations_, chunk);
+      if (large_cache_size_ + chunk->large_capacity <= MAX_LARGE_CACHE_SIZE)
+      {
+        link_chunk(&large_cache_, chunk);
+        large_cache_size_ += chunk->large_capacity;
+        return;
+      }
+    }
+    backing_allocator_->deallocate(chunk);
+  }
+
+  auto ThreadCachingAllocator::fetch_from_central(u32 size_class, ThreadCacheBin* bin, u32 count)
+    -> u32
+  {
+    CentralBin& central_bin = central_bins_[size_class];
+    std::lock_guard guard(central_bin.mutex);
+
+    if (central_bin.count < count)
+    {
+      void* chunk_addr = allocate_chunk();
+      if (chunk_addr != nullptr)
+      {
+        auto* chunk             = soul::cast<ChunkHeader*>(chunk_addr);
+        chunk->size_class       = size_class;
+        const usize block_size  = get_size_class_size(size_class);
+        const usize block_count = (CHUNK_SIZE - CHUNK_HEADER_SIZE) / block_size;
+        // NOTE(kevinyu): Push in reverse so the blocks are handed out in address order.
+        for (usize block_index = block_count; block_index > 0; block_index--)
+        {
+          auto* block = soul::cast<FreeBlock*>(
+            util::pointer_add(chunk, CHUNK_HEADER_SIZE + (block_index - 1) * block_size));
+          block->next      = central_bin.head;
+          central_bin.head = block;
+        }
+        central_bin.count += soul::cast<u32>(block_count);
+      }
+    }
+
+    u32 fetch_count = 0;
+    while (fetch_count < count && central_bin.head != nullptr)
+    {
+      FreeBlock* block = central_bin.head;
+      central_bin.head = block->next;
+      block->next      = bin->head;
+      bin->head        = block;
+      fetch_count++;
+    }
+    central_bin.count -= fetch_count;
+    bin->count += fetch_count;
+    return fetch_count;
+  }
+
+  void ThreadCachingAllocator::release_to_central(u32 size_class, ThreadCacheBin* bin, u32 count)
+  {
+    SOUL_ASSERT(0, count != 0 && count <= bin->count);
+    FreeBlock* head = bin->head;
+    FreeBlock* tail = head;
+    for (u32 block_index = 1; block_index < count; block_index++)
+    {
+      tail = tail->next;
+    }
+    bin->head = tail->next;
+    bin->count -= count;
+
+    CentralBin& central_bin = central_bins_[size_class];
+    std::lock_guard guard(central_bin.mutex);
+    tail->next       = central_bin.head;
+    central_bin.head = head;
+    central_bin.count += count;
+  }
+
+  auto ThreadCachingAllocator::allocate_chunk() -> void*
+  {
+    std::lock_guard guard(chunk_mutex_);
+    if (span_cursor_ == span_end_)
+    {
+      void* span = free_span_list_;
+      if (span != nullptr)
+      {
+        free_span_list_ = soul::cast<ChunkHeader*>(span)->next_span;
+      } else
+      {
+        const Allocation allocation =
+          backing_allocator_->try_allocate(SPAN_SIZE, CHUNK_SIZE, name());
+        if (allocation.addr == nullptr)
+        {
+          return nullptr;
+        }
+        SOUL_ASSERT(0, get_chunk_header(allocation.addr) == allocation.addr);
+        span = allocation.addr;
+      }
+      soul::cast<ChunkHeader*>(span)->next_span = span_list_;
+      span_list_                                = span;
+      span_cursor_                              = soul::cast<byte*>(span);
+      span_end_                                 = span_cursor_ + SPAN_SIZE;
+    }
+    void* chunk = span_cursor_;
+    span_cursor_ += CHUNK_SIZE;
+    return chunk;
+  }
+
+} // namespace soul::memory
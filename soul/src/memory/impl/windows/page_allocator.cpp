@@ -6,22 +6,102 @@
 namespace soul::memory
 {
 
-  PageAllocator::PageAllocator(CompStr name) : Allocator(name)
+  PageAllocator::PageAllocator(CompStr name, HugePageMode huge_page_mode)
+      : Allocator(name), huge_page_mode_(huge_page_mode)
   {
     SYSTEM_INFO s_sys_info;
     GetSystemInfo(&s_sys_info);
-    page_size_ = s_sys_info.dwPageSize;
+    page_size_      = s_sys_info.dwPageSize;
+    huge_page_size_ = GetLargePageMinimum();
+
+    // NOTE(kevinyu): Windows has no transparent huge page, and large page need the
+    // SeLockMemoryPrivilege. Use normal page when it is not available.
+    if (huge_page_mode_ == HugePageMode::TRANSPARENT || huge_page_size_ == 0)
+    {
+      huge_page_mode_ = HugePageMode::NONE;
+    }
   }
 
   void PageAllocator::reset(){};
 
-  auto PageAllocator::try_allocate(usize size, usize /* alignment */, StringView /* tag */)
+  auto PageAllocator::try_allocate(usize size, usize alignment, StringView /* tag */)
     -> Allocation
   {
+    // NOTE(kevinyu): Large page region is only aligned to the large page size, bigger alignment
+    // go through the normal page path below.
+    if (huge_page_mode_ == HugePageMode::EXPLICIT && alignment <= huge_page_size_)
+    {
+      // NOTE(kevinyu): Large page must be reserved and committed at the same time
+      const usize new_size = (size + huge_page_size_ - 1) & ~(huge_page_size_ - 1);
+      void* addr           = VirtualAlloc(
+        nullptr, new_size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+      if (addr != nullptr)
+      {
+        return {addr, new_size};
+      }
+    }
+    const Allocation allocation = reserve(size, alignment);
+    if (allocation.addr == nullptr)
+    {
+      return {nullptr, 0};
+    }
+    if (!commit(allocation.addr, allocation.size))
+    {
+      deallocate(allocation.addr);
+      return {nullptr, 0};
+    }
+    return allocation;
+  }
+
+  auto PageAllocator::reserve(usize size, usize alignment) -> Allocation
+  {
+    SYSTEM_INFO s_sys_info;
+    GetSystemInfo(&s_sys_info);
     auto new_size = util::pointer_page_size_round(size, page_size_);
-    void* addr    = VirtualAlloc(nullptr, new_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-    SOUL_ASSERT(0, addr != nullptr);
-    return {addr, new_size};
+    if (alignment <= s_sys_info.dwAllocationGranularity)
+    {
+      void* addr = VirtualAlloc(nullptr, new_size, MEM_RESERVE, PAGE_NOACCESS);
+      if (addr == nullptr)
+      {
+        return {nullptr, 0};
+      }
+      return {addr, new_size};
+    }
+
+    // NOTE(kevinyu): A reservation can only be released as a whole, so it cannot be trimmed like
+    // on POSIX. Find an aligned address inside a bigger reservation, release it and reserve again
+    // at that address. Another thread can take the range in between, so retry a few times.
+    static constexpr u32 MAX_ALIGNED_RESERVE_ATTEMPT_COUNT = 8;
+    for (u32 attempt_index = 0; attempt_index < MAX_ALIGNED_RESERVE_ATTEMPT_COUNT; attempt_index++)
+    {
+      void* probe_addr = VirtualAlloc(nullptr, new_size + alignment, MEM_RESERVE, PAGE_NOACCESS);
+      if (probe_addr == nullptr)
+      {
+        return {nullptr, 0};
+      }
+      void* aligned_addr    = util::pointer_align_forward(probe_addr, alignment);
+      const auto is_success = VirtualFree(probe_addr, 0, MEM_RELEASE);
+      SOUL_ASSERT(0, is_success);
+      void* addr = VirtualAlloc(aligned_addr, new_size, MEM_RESERVE, PAGE_NOACCESS);
+      if (addr != nullptr)
+      {
+        SOUL_ASSERT(0, addr == aligned_addr);
+        return {addr, new_size};
+      }
+    }
+    return {nullptr, 0};
+  }
+
+  auto PageAllocator::commit(void* addr, usize size) -> b8
+  {
+    void* result = VirtualAlloc(addr, size, MEM_COMMIT, PAGE_READWRITE);
+    return result != nullptr;
+  }
+
+  void PageAllocator::decommit(void* addr, usize size)
+  {
+    const auto is_success = VirtualFree(addr, size, MEM_DECOMMIT);
+    SOUL_ASSERT(0, is_success);
   }
 
   auto PageAllocator::get_allocation_size(void* addr) const -> usize
@@ -30,9 +110,21 @@ namespace soul::memory
     {
       return 0;
     }
+
+    // NOTE(kevinyu): A region returned by VirtualQuery stop at the first page with different
+    // state, so walk all regions of the reservation to get its full size.
     MEMORY_BASIC_INFORMATION memory_basic_information;
     VirtualQuery(addr, &memory_basic_information, sizeof(memory_basic_information));
-    return memory_basic_information.RegionSize;
+    void* allocation_base = memory_basic_information.AllocationBase;
+    usize allocation_size = 0;
+    auto* cursor          = soul::cast<byte*>(addr);
+    while (VirtualQuery(cursor, &memory_basic_information, sizeof(memory_basic_information)) != 0 &&
+           memory_basic_information.AllocationBase == allocation_base)
+    {
+      allocation_size += memory_basic_information.RegionSize;
+      cursor += memory_basic_information.RegionSize;
+    }
+    return allocation_size;
   }
 
   void PageAllocator::deallocate(void* addr)
@@ -41,4 +133,14 @@ namespace soul::memory
     SOUL_ASSERT(0, is_success);
   }
 
+  auto PageAllocator::get_page_size() const -> usize
+  {
+    return page_size_;
+  }
+
+  auto PageAllocator::get_commit_granularity() const -> usize
+  {
+    return huge_page_mode_ == HugePageMode::NONE ? page_size_ : huge_page_size_;
+  }
+
 } // namespace soul::memory
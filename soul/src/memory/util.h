@@ -21,7 +21,7 @@ namespace soul::memory::util
   static auto pointer_align_forward(const void* address, const usize alignment) -> void*
   {
     return reinterpret_cast<void*>( // NOLINT(performance-no-int-to-ptr)
-      (reinterpret_cast<uptr>(address) + alignment) & ~(alignment - 1));
+      (reinterpret_cast<uptr>(address) + alignment - 1) & ~(alignment - 1));
   }
 
   [[nodiscard]]
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "core/config.h"
 #include "core/path.h"
 #include "core/string.h"
@@ -366,7 +366,10 @@ namespace soul
 
     auto dump(NotNull<memory::Allocator*> allocator = get_default_allocator()) -> String
     {
-      return String::From(yyjson_mut_write(doc_, 0, nullptr), allocator);
+      char* json         = yyjson_mut_write(doc_, 0, nullptr);
+      String json_string = String::From(json, allocator);
+      free(json);
+      return json_string;
     }
 
   private:
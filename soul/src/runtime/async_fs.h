@@ -0,0 +1,26 @@
+#pragma once
+
+#include "core/config.h"
+#include "core/path.h"
+#include "core/string.h"
+#include "misc/filesystem.h"
+#include "runtime/coroutine.h"
+
+// NOTE(kevinyu): co_await-able wrappers of misc/filesystem.h. They live in runtime so misc does
+// not depend on the runtime.
+namespace soul::runtime
+{
+  /*
+    co_await-able version of fs::get_file_content(). The file is read on the runtime background
+    lane and the awaiting coroutine is resumed there.
+  */
+  inline auto get_file_content_async(
+    Path path, memory::Allocator* allocator = soul::get_default_allocator())
+  {
+    return run_in_background(
+      [path = std::move(path), allocator]() -> String
+      {
+        return fs::get_file_content(path, allocator);
+      });
+  }
+} // namespace soul::runtime
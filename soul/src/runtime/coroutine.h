@@ -0,0 +1,397 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "core/option.h"
+#include "core/span.h"
+#include "core/type_traits.h"
+#include "runtime/runtime.h"
+
+/*
+  Coroutine front-end for the runtime. Coroutine lets a chain of dependent work be written as a
+  straight line code without blocking a worker in wait_task().
+
+  Lifetime rules:
+  - Frame task is reset in begin_frame(), so co_await on a TaskID must happen in the same frame
+    the task is created.
+  - After co_await run_in_background(), the coroutine continue on the background lane, where it
+    cannot create frame task. Use co_await next_frame() to come back to the frame lane.
+  - Coroutine frame is allocated from the runtime coroutine frame cache, not from the global heap.
+*/
+namespace soul::runtime
+{
+  template <typename T = void>
+  class Coroutine;
+
+  namespace impl
+  {
+    class CoroutinePromiseBase
+    {
+    public:
+      static auto operator new(usize size) -> void*
+      {
+        return System::get().allocate_coroutine_frame(size);
+      }
+
+      static void operator delete(void* addr, usize size)
+      {
+        System::get().deallocate_coroutine_frame(addr, size);
+      }
+
+      auto initial_suspend() noexcept -> std::suspend_always
+      {
+        return {};
+      }
+
+      struct FinalAwaiter
+      {
+        auto await_ready() noexcept -> b8
+        {
+          return false;
+        }
+
+        template <typename Promise>
+        auto await_suspend(std::coroutine_handle<Promise> handle) noexcept
+          -> std::coroutine_handle<>
+        {
+          CoroutinePromiseBase& promise = handle.promise();
+          if (promise.continuation_)
+          {
+            return promise.continuation_;
+          }
+          if (promise.is_detached_)
+          {
+            handle.destroy();
+          }
+          return std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+      };
+
+      auto final_suspend() noexcept -> FinalAwaiter
+      {
+        return {};
+      }
+
+      void unhandled_exception()
+      {
+        // NOTE(kevinyu): Soul is compiled without exception support.
+        std::terminate();
+      }
+
+      void set_continuation(std::coroutine_handle<> continuation)
+      {
+        continuation_ = continuation;
+      }
+
+      void detach()
+      {
+        is_detached_ = true;
+      }
+
+    private:
+      std::coroutine_handle<> continuation_;
+      b8 is_detached_ = false;
+    };
+
+    template <typename T>
+    class CoroutinePromise : public CoroutinePromiseBase
+    {
+    public:
+      auto get_return_object() -> Coroutine<T>;
+
+      void return_value(T value)
+      {
+        result_ = std::move(value);
+      }
+
+      auto take_result() -> T
+      {
+        return std::move(result_).unwrap();
+      }
+
+    private:
+      Option<T> result_;
+    };
+
+    template <>
+    class CoroutinePromise<void> : public CoroutinePromiseBase
+    {
+    public:
+      auto get_return_object() -> Coroutine<void>;
+
+      void return_void() {}
+
+      void take_result() {}
+    };
+  } // namespace impl
+
+  /*
+    Lazily started coroutine. It start running when it is co_await-ed by another coroutine or
+    passed to spawn_coroutine().
+  */
+  template <typename T>
+  class Coroutine
+  {
+  public:
+    using promise_type = impl::CoroutinePromise<T>;
+    using handle_type  = std::coroutine_handle<promise_type>;
+
+    explicit Coroutine(handle_type handle) : handle_(handle) {}
+
+    Coroutine(const Coroutine&) = delete;
+
+    auto operator=(const Coroutine&) -> Coroutine& = delete;
+
+    Coroutine(Coroutine&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    auto operator=(Coroutine&& other) noexcept -> Coroutine&
+    {
+      if (this != &other)
+      {
+        if (handle_)
+        {
+          handle_.destroy();
+        }
+        handle_ = std::exchange(other.handle_, nullptr);
+      }
+      return *this;
+    }
+
+    ~Coroutine()
+    {
+      if (handle_)
+      {
+        handle_.destroy();
+      }
+    }
+
+    struct Awaiter
+    {
+      handle_type handle;
+
+      auto await_ready() noexcept -> b8
+      {
+        return false;
+      }
+
+      auto await_suspend(std::coroutine_handle<> continuation) noexcept -> std::coroutine_handle<>
+      {
+        handle.promise().set_continuation(continuation);
+        return handle;
+      }
+
+      auto await_resume() -> T
+      {
+        return handle.promise().take_result();
+      }
+    };
+
+    auto operator co_await() && noexcept -> Awaiter
+    {
+      SOUL_ASSERT(0, handle_, "Coroutine has already been started");
+      return Awaiter{handle_};
+    }
+
+    /*
+      Give up the ownership of the coroutine frame. The frame destroy itself when the coroutine
+      finish.
+    */
+    auto release() -> handle_type
+    {
+      handle_.promise().detach();
+      return std::exchange(handle_, nullptr);
+    }
+
+  private:
+    handle_type handle_;
+  };
+
+  namespace impl
+  {
+    template <typename T>
+    auto CoroutinePromise<T>::get_return_object() -> Coroutine<T>
+    {
+      return Coroutine<T>(std::coroutine_handle<CoroutinePromise>::from_promise(*this));
+    }
+
+    inline auto CoroutinePromise<void>::get_return_object() -> Coroutine<void>
+    {
+      return Coroutine<void>(std::coroutine_handle<CoroutinePromise>::from_promise(*this));
+    }
+  } // namespace impl
+
+  /*
+    Start a coroutine on the calling thread and detach it. It runs until its first suspension point
+    before this function return.
+  */
+  inline void spawn_coroutine(Coroutine<void>&& coroutine)
+  {
+    coroutine.release().resume();
+  }
+
+  /*
+    Resume the coroutine after all the tasks (and their children) finish. The coroutine is resumed
+    from a runtime task, on whichever worker that run it.
+  */
+  class TaskGroupAwaiter
+  {
+  public:
+    explicit TaskGroupAwaiter(Span<const TaskID*> task_ids) : task_ids_(task_ids) {}
+
+    auto await_ready() const -> b8
+    {
+      for (const TaskID task_id : task_ids_)
+      {
+        if (!System::get().is_task_complete(task_id))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const
+    {
+      const TaskID resume_task_id =
+        create_task(TaskID::ROOT(), [handle](TaskID /* task_id */) { handle.resume(); });
+      for (const TaskID task_id : task_ids_)
+      {
+        add_task_dependency(resume_task_id, task_id);
+      }
+      // NOTE(kevinyu): The coroutine may already be running on another thread after this call, do
+      // not touch any member after it.
+      run_task(resume_task_id);
+    }
+
+    void await_resume() const {}
+
+  private:
+    Span<const TaskID*> task_ids_;
+  };
+
+  inline auto when_all(Span<const TaskID*> task_ids) -> TaskGroupAwaiter
+  {
+    return TaskGroupAwaiter(task_ids);
+  }
+
+  inline auto when_all(std::initializer_list<TaskID> task_ids) -> TaskGroupAwaiter
+  {
+    return TaskGroupAwaiter({task_ids.begin(), task_ids.size()});
+  }
+
+  class TaskAwaiter
+  {
+  public:
+    explicit TaskAwaiter(TaskID task_id) : task_id_(task_id) {}
+
+    auto await_ready() const -> b8
+    {
+      return System::get().is_task_complete(task_id_);
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const
+    {
+      TaskGroupAwaiter({&task_id_, 1}).await_suspend(handle);
+    }
+
+    void await_resume() const {}
+
+  private:
+    TaskID task_id_;
+  };
+
+  inline auto operator co_await(TaskID task_id) -> TaskAwaiter
+  {
+    return TaskAwaiter(task_id);
+  }
+
+  /*
+    Run fn on the background lane and resume the coroutine there with fn's result.
+  */
+  template <typename Fn>
+  class BackgroundAwaiter
+  {
+  public:
+    using result_type = std::invoke_result_t<Fn>;
+
+    explicit BackgroundAwaiter(Fn&& fn) : fn_(std::move(fn)) {}
+
+    auto await_ready() const -> b8
+    {
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      create_background_task(
+        [this, handle]()
+        {
+          if constexpr (std::is_void_v<result_type>)
+          {
+            fn_();
+          } else
+          {
+            result_ = fn_();
+          }
+          handle.resume();
+        });
+    }
+
+    auto await_resume() -> result_type
+    {
+      if constexpr (!std::is_void_v<result_type>)
+      {
+        return std::move(result_).unwrap();
+      }
+    }
+
+  private:
+    struct Empty
+    {
+    };
+    using storage_type = std::conditional_t<std::is_void_v<result_type>, Empty, result_type>;
+
+    Fn fn_;
+    Option<storage_type> result_;
+  };
+
+  template <typename Fn>
+  auto run_in_background(Fn&& fn) -> BackgroundAwaiter<std::decay_t<Fn>>
+  {
+    return BackgroundAwaiter<std::decay_t<Fn>>(std::decay_t<Fn>(std::forward<Fn>(fn)));
+  }
+
+  /*
+    Suspend the coroutine until the next begin_frame(). It is resumed on the main thread after the
+    frame pools are reset, so it can create frame task again. Safe to use from the background lane.
+  */
+  class NextFrameAwaiter
+  {
+  public:
+    auto await_ready() const -> b8
+    {
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      node_.handle = handle;
+      System::get().resume_on_next_frame(&node_);
+    }
+
+    void await_resume() const {}
+
+  private:
+    CoroutineResumeNode node_ = {};
+  };
+
+  inline auto next_frame() -> NextFrameAwaiter
+  {
+    return {};
+  }
+
+} // namespace soul::runtime
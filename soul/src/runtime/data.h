@@ -4,15 +4,18 @@
 #include <mutex>
 #include <thread>
 #include <condition_variable>
+#include <coroutine>
 
 #include "core/architecture.h"
 #include "core/fixed_vector.h"
 #include "core/type.h"
 #include "core/vector.h"
 #include "memory/allocator.h"
+#include "memory/allocators/frame_ring_allocator.h"
 #include "memory/allocators/linear_allocator.h"
 #include "memory/allocators/malloc_allocator.h"
 #include "memory/allocators/proxy_allocator.h"
+#include "memory/allocators/thread_caching_allocator.h"
 
 namespace soul::runtime
 {
@@ -21,32 +24,139 @@ namespace soul::runtime
   using TempProxy     = memory::NoOpProxy;
   using TempAllocator = memory::ProxyAllocator<memory::LinearAllocator, TempProxy>;
 
+  /*
+    Report every allocation to System::on_frame_allocation(), so the runtime can enforce the
+    frame allocation budget. It is part of DefaultAllocatorProxy, put it in the proxy of any other
+    allocator that should count toward the budget.
+  */
+  class FrameAllocationProxy final : public memory::Proxy
+  {
+  public:
+    struct Config
+    {
+    };
+
+    explicit FrameAllocationProxy(const Config& /* config */) {}
+
+    FrameAllocationProxy() = default;
+
+    void on_pre_init(StringView name) override
+    {
+      name_ = name;
+    }
+
+    void on_post_init() override {}
+
+    void on_pre_allocate(const memory::AllocateParam& alloc_param) override {}
+
+    auto on_post_allocate(const memory::AllocateParam& alloc_param, memory::Allocation allocation)
+      -> memory::Allocation override;
+
+    auto on_pre_deallocate(const memory::DeallocateParam& dealloc_param)
+      -> memory::DeallocateParam override
+    {
+      return dealloc_param;
+    }
+
+    void on_post_deallocate() override {}
+
+    void on_pre_cleanup() override {}
+
+    void on_post_cleanup() override {}
+
+  private:
+    StringView name_ = {nullptr, 0};
+  };
+
+#if defined(SOUL_THREAD_CACHING_DEFAULT_ALLOCATOR)
+  using DefaultBackingAllocator = memory::ThreadCachingAllocator;
+#else
+  using DefaultBackingAllocator = memory::MallocAllocator;
+#endif
+  // NOTE(kevinyu): Both backing allocators are thread safe and the proxies keep no state between
+  // their hooks, so the diagnostics run without a global lock.
   using DefaultAllocatorProxy = memory::MultiProxy<
-    memory::MutexProxy,
     memory::ProfileProxy,
+    FrameAllocationProxy,
     memory::CounterProxy,
     memory::ClearValuesProxy,
     memory::BoundGuardProxy>;
-  using DefaultAllocator = memory::ProxyAllocator<memory::MallocAllocator, DefaultAllocatorProxy>;
+  using DefaultAllocator = memory::ProxyAllocator<DefaultBackingAllocator, DefaultAllocatorProxy>;
+
+#if defined(SOUL_RUNTIME_STATS_ENABLE)
+  constexpr b8 RUNTIME_STATS_ENABLE = true;
+#else
+  constexpr b8 RUNTIME_STATS_ENABLE = false;
+#endif
+
+  constexpr u32 FRAME_ALLOCATION_BUDGET_DISABLED = ~0u;
 
   struct Config
   {
     u16 threadCount; // 0 to use hardware thread count
     u16 taskPoolCount;
     TempAllocator* mainThreadTempAllocator;
+    // Reserved address space of each worker temp allocator, memory is committed on demand
     u64 workerTempAllocatorSize;
     DefaultAllocator* defaultAllocator;
+    u32 workerSpinCount = 0;       // 0 to use DEFAULT_WORKER_SPIN_COUNT
+    u16 backgroundThreadCount = 0; // 0 to use half of the worker threads
+
+    // NOTE(kevinyu): Pin each worker to one logical core. Pinned workers prefer to steal from
+    // workers that share their L3 cache.
+    b8 pinWorkerThreads = false;
+    // Pin the main thread to the first core and keep the workers off it. Only used together with
+    // pinWorkerThreads.
+    b8 reserveMainThreadCore = false;
+    // OS thread name of the workers is "<workerThreadName> <thread index>", nullptr to use "Worker"
+    const char* workerThreadName = nullptr;
+    // Advanced in every begin_frame(), so its allocation live for its frame count of frames.
+    // nullptr if not used
+    memory::FrameRingAllocator* frameRingAllocator = nullptr;
+    // Maximum number of allocation through the default allocator between two begin_frame().
+    // Frame that goes over it is reported in the next begin_frame().
+    u32 frameAllocationBudget = FRAME_ALLOCATION_BUDGET_DISABLED;
+    // Panic instead of only logging the frame that goes over the budget, e.g. for CI
+    b8 panicOnFrameAllocationBudget = false;
   };
 
   struct Constant
   {
-    static constexpr u32 TASK_ID_THREAD_INDEX_MASK  = 0xFFFFC000;
-    static constexpr u32 TASK_ID_THREAD_INDEX_SHIFT = 14;
-    static constexpr u32 TASK_ID_TASK_INDEX_MASK    = 0x00003FFF;
+    static constexpr u32 TASK_ID_THREAD_INDEX_MASK  = 0xFF000000;
+    static constexpr u32 TASK_ID_THREAD_INDEX_SHIFT = 24;
+    static constexpr u32 TASK_ID_TASK_INDEX_MASK    = 0x00FFFFFF;
     static constexpr u32 TASK_ID_TASK_INDEX_SHIFT   = 0;
 
-    static constexpr u16 MAX_THREAD_COUNT      = 16;
-    static constexpr usize MAX_TASK_PER_THREAD = 2u << (TASK_ID_THREAD_INDEX_SHIFT - 1);
+    static constexpr u16 MAX_THREAD_COUNT      = 1u << (32 - TASK_ID_THREAD_INDEX_SHIFT);
+    static constexpr usize MAX_TASK_PER_THREAD = 1u << TASK_ID_THREAD_INDEX_SHIFT;
+
+    // NOTE(kevinyu): Task pool grow one page at a time. Pages are kept alive until shutdown and
+    // recycled in begin_frame()
+    static constexpr u32 TASK_PAGE_SHIFT            = 10;
+    static constexpr u32 TASK_PAGE_SIZE             = 1u << TASK_PAGE_SHIFT;
+    static constexpr u32 TASK_PAGE_MASK             = TASK_PAGE_SIZE - 1;
+    static constexpr usize MAX_TASK_PAGE_PER_THREAD = MAX_TASK_PER_THREAD / TASK_PAGE_SIZE;
+    static constexpr u32 CONTINUATION_PAGE_SIZE     = 1024;
+    static constexpr i32 INITIAL_TASK_DEQUE_CAPACITY = 4096;
+
+    // NOTE(kevinyu): Task payload that does not fit in Task::storage is placed in a per thread
+    // arena made of pages of this size.
+    static constexpr usize TASK_PAYLOAD_PAGE_SIZE = 64 * ONE_KILOBYTE;
+
+    // NOTE(kevinyu): Number of failed steal attempt before an idle worker park itself
+    static constexpr u32 DEFAULT_WORKER_SPIN_COUNT = 64;
+
+    static constexpr u32 MAX_BACKGROUND_TASK_COUNT = 1024;
+
+    // NOTE(kevinyu): Coroutine frame size class are power of two from 64 bytes to 4 KiB. Bigger
+    // frame go straight to the default allocator.
+    static constexpr u32 COROUTINE_FRAME_MIN_SIZE_SHIFT            = 6;
+    static constexpr u32 COROUTINE_FRAME_SIZE_CLASS_COUNT          = 7;
+    static constexpr u32 MAX_CACHED_COROUTINE_FRAME_PER_SIZE_CLASS = 64;
+
+    // NOTE(kevinyu): Only the first violations of a frame are recorded, the rest are only counted.
+    static constexpr u32 MAX_FRAME_ALLOCATION_VIOLATION_COUNT  = 16;
+    static constexpr u32 MAX_FRAME_ALLOCATION_CALL_STACK_DEPTH = 16;
   };
 
   struct Task;
@@ -121,25 +231,88 @@ namespace soul::runtime
   {
     static constexpr u32 STORAGE_SIZE_BYTE = SOUL_CACHELINE_SIZE - sizeof(TaskFunc) // func size
                                              - sizeof(TaskID)                       // parentID size
-                                             - sizeof(std::atomic<u16>); // unfinishedCount size
+                                             - sizeof(std::atomic<u16>) // unfinishedCount size
+                                             - sizeof(std::atomic<u16>); // dependencyCount size
 
     void* storage[STORAGE_SIZE_BYTE / sizeof(void*)] = {};
     TaskFunc func                                    = nullptr;
     TaskID parent_id;
     std::atomic<u16> unfinished_count = {0};
+
+    // NOTE(kevinyu): Number of unfinished dependency plus one for the run gate that is released by
+    // run_task(). The task is pushed to a deque when it reach zero.
+    std::atomic<u16> dependency_count = {0};
   };
 
   static_assert(
     sizeof(Task) == SOUL_CACHELINE_SIZE, "Task must be the same size as cache line size.");
 
+  struct TaskContinuation
+  {
+    TaskID task_id;
+    TaskContinuation* next = nullptr;
+  };
+
+  struct TaskContinuationPage
+  {
+    TaskContinuation continuations[Constant::CONTINUATION_PAGE_SIZE];
+  };
+
+  // NOTE(kevinyu): There is no space left in Task for the continuation list, so the list head
+  // is stored in task_continuations, parallel to the tasks of the same page.
+  struct TaskPage
+  {
+    Task tasks[Constant::TASK_PAGE_SIZE];
+    std::atomic<TaskContinuation*> task_continuations[Constant::TASK_PAGE_SIZE];
+  };
+
+  using BackgroundTaskFunc = void (*)(void* data);
+
+  struct BackgroundTaskID
+  {
+    u32 index;
+    u32 generation;
+  };
+
+  // NOTE(kevinyu): Background task live outside of the per frame task pool so it can keep running
+  // across begin_frame(). generation is bumped every time the task in this slot complete.
+  struct BackgroundTask
+  {
+    BackgroundTaskFunc func     = nullptr;
+    void* data                  = nullptr;
+    std::atomic<u32> generation = 0;
+  };
+
+  // NOTE(kevinyu): Chase-Lev deque with a growable circular buffer. Buffer that has been replaced
+  // by a bigger one is kept alive until shutdown() because a concurrent steal() might still read
+  // from it.
   class TaskDeque
   {
   public:
-    TaskID _tasks[Constant::MAX_TASK_PER_THREAD];
+    struct Buffer
+    {
+      TaskID* tasks   = nullptr;
+      i32 capacity    = 0;
+      Buffer* retired = nullptr;
+
+      [[nodiscard]]
+      auto get(i32 index) const -> TaskID
+      {
+        return tasks[index & (capacity - 1)];
+      }
+
+      void put(i32 index, TaskID task)
+      {
+        tasks[index & (capacity - 1)] = task;
+      }
+    };
+
+    std::atomic<Buffer*> _buffer;
     std::atomic<i32> _bottom;
     std::atomic<i32> _top;
+    memory::Allocator* _allocator = nullptr;
 
-    void init();
+    void init(memory::Allocator* allocator);
 
     void shutdown();
 
@@ -151,42 +324,264 @@ namespace soul::runtime
 
     // return nullptr if empty or fail (other thread do steal operation concurrently)
     auto steal() -> TaskID;
+
+    // only meaningful when called from the owner thread
+    [[nodiscard]]
+    auto is_empty() const -> b8
+    {
+      return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+    }
+
+    // approximate when called concurrently with steal()
+    [[nodiscard]]
+    auto size() const -> usize
+    {
+      const i32 bottom = _bottom.load(std::memory_order_relaxed);
+      const i32 top    = _top.load(std::memory_order_relaxed);
+      return bottom > top ? soul::cast<usize>(bottom - top) : 0;
+    }
+
+    // same as steal(), but leave the task in the deque if the oldest task does not satisfy pred
+    template <ts_fn<b8, TaskID> Pred>
+    auto steal_if(Pred pred) -> TaskID
+    {
+      auto top          = _top.load(std::memory_order_acquire);
+      const auto bottom = _bottom.load(std::memory_order_acquire);
+
+      if (top >= bottom)
+      {
+        return TaskID::NULLVAL();
+      }
+
+      const TaskID task = _buffer.load(std::memory_order_acquire)->get(top);
+      if (!pred(task))
+      {
+        return TaskID::NULLVAL();
+      }
+
+      if (_top.compare_exchange_strong(
+            top, top + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+      {
+        return task;
+      }
+
+      return TaskID::NULLVAL();
+    }
+
+  private:
+    auto create_buffer(i32 capacity) -> Buffer*;
+
+    auto grow(Buffer* buffer, i32 bottom, i32 top) -> Buffer*;
+  };
+
+  // NOTE(kevinyu): Free list node that live inside a cached coroutine frame
+  struct CoroutineFrame
+  {
+    CoroutineFrame* next;
+  };
+
+  struct CoroutineResumeNode
+  {
+    std::coroutine_handle<> handle;
+    CoroutineResumeNode* next;
+  };
+
+  // NOTE(kevinyu): Statistic of one thread for one frame. Only collected when the runtime is
+  // compiled with SOUL_RUNTIME_STATS_ENABLE, all zero otherwise.
+  struct WorkerStats
+  {
+    u64 executed_task_count = 0;
+    u64 steal_attempt_count = 0;
+    u64 steal_success_count = 0;
+    u64 idle_time_ns        = 0; // spinning for work without finding any
+    u64 parked_time_ns      = 0;
+    u64 wait_task_time_ns   = 0; // blocked in wait_task(), excluding nested task run while waiting
+    u32 max_queue_depth     = 0;
+  };
+
+  // NOTE(kevinyu): Only the owner thread increment the counters, begin_frame() take them.
+  struct WorkerStatsCounter
+  {
+    std::atomic<u64> executed_task_count = 0;
+    std::atomic<u64> steal_attempt_count = 0;
+    std::atomic<u64> steal_success_count = 0;
+    std::atomic<u64> idle_time_ns        = 0;
+    std::atomic<u64> parked_time_ns      = 0;
+    std::atomic<u64> wait_task_time_ns   = 0;
+    std::atomic<u32> max_queue_depth     = 0;
+  };
+
+  // NOTE(kevinyu): An allocation made after the frame allocation budget is used up. thread_index
+  // is ~0 when the allocation is made from a thread that the runtime does not own. Allocator name
+  // and tag are kept as view, they are static string like every allocator name and tag in soul.
+  struct FrameAllocationViolation
+  {
+    StringView allocator_name = {nullptr, 0};
+    StringView tag            = {nullptr, 0};
+    usize size                = 0;
+    u16 thread_index          = 0;
+    u32 call_stack_depth      = 0;
+
+    void* call_stack[Constant::MAX_FRAME_ALLOCATION_CALL_STACK_DEPTH] = {};
+  };
+
+  enum class TraceEventType : u8
+  {
+    TASK,
+    WAIT_TASK,
+    COUNT
+  };
+
+  struct TraceEvent
+  {
+    TraceEventType type;
+    TaskID task_id;
+    u64 begin_ns;
+    u64 end_ns;
+  };
+
+  enum class ParkState : u32
+  {
+    RUNNING,
+    PARKED,
+    NOTIFIED,
+    COUNT
   };
 
   struct alignas(SOUL_CACHELINE_SIZE) ThreadContext
   {
     TaskDeque task_deque;
 
-    Task task_pool[Constant::MAX_TASK_PER_THREAD];
-    u16 task_count = 0;
+    // NOTE(kevinyu): Written by other threads when they wake this worker up, keep it in its own
+    // cache line so it does not false share with the fields below.
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<ParkState> park_state = ParkState::RUNNING;
+
+    // NOTE(kevinyu): Page table is a fixed array so other threads can look up task while the
+    // owner thread add new pages.
+    TaskPage* task_pages[Constant::MAX_TASK_PAGE_PER_THREAD] = {};
+    u32 task_page_count                                        = 0;
+    u32 task_count                                             = 0;
+
+    Vector<TaskContinuationPage*> continuation_pages;
+    u32 continuation_count = 0;
+
+    // NOTE(kevinyu): Payload arena is rewound in begin_frame() and its pages are kept until
+    // shutdown, so steady state frames never go to the default allocator.
+    Vector<byte*> task_payload_pages;
+    u32 task_payload_page_index = 0;
+    usize task_payload_offset   = 0;
 
     u16 thread_index = 0;
 
+    // NOTE(kevinyu): Workers sharing a cache with this thread are
+    // Database::steal_group_threads[steal_group_begin .. steal_group_begin + steal_group_count)
+    usize core_index      = 0;
+    u16 steal_group_begin = 0;
+    u16 steal_group_count = 0;
+
+    b8 is_running_background_task = false;
+
+    // NOTE(kevinyu): Coroutine can be resumed on a different thread, so a frame may be returned to
+    // a different cache than the one it come from. It is fine since every cached frame of a size
+    // class has the same size and come from the default allocator.
+    CoroutineFrame* coroutine_frame_free_lists[Constant::COROUTINE_FRAME_SIZE_CLASS_COUNT] = {};
+    u32 coroutine_frame_free_counts[Constant::COROUTINE_FRAME_SIZE_CLASS_COUNT]            = {};
+
     Vector<memory::Allocator*> allocator_stack;
     TempAllocator* temp_allocator = nullptr;
+
+    alignas(SOUL_CACHELINE_SIZE) WorkerStatsCounter stats;
+    WorkerStats last_frame_stats;
+
+    // NOTE(kevinyu): Only written by the owner thread while running frame task, so begin_frame()
+    // can swap them without synchronization after the root task is done.
+    Vector<TraceEvent> trace_events;
+    Vector<TraceEvent> last_frame_trace_events;
   };
 
   struct Database
   {
     thread_local static ThreadContext* g_thread_context; // NOLINT
     FixedVector<ThreadContext> thread_contexts;
-    std::thread threads[Constant::MAX_THREAD_COUNT];
+    FixedVector<std::thread> threads;
 
     std::condition_variable wait_cond_var;
     std::mutex wait_mutex;
-
-    std::condition_variable loop_cond_var;
-    std::mutex loop_mutex;
+    // NOTE(kevinyu): Bumped under wait_mutex by schedule_task() when a thread sleep in
+    // wait_task(), so the sleeper wake up to help with the new task.
+    u32 wait_generation = 0;
 
     std::atomic<b8> is_terminated;
 
-    usize active_task_count  = 0;
-    ThreadCount thread_count = 0;
+    // NOTE(kevinyu): Marker stored as the continuation list head of a finished task.
+    TaskContinuation closed_continuation;
 
-    memory::Allocator* default_allocator = nullptr;
-    usize temp_allocator_size            = 0;
+    // NOTE(kevinyu): Number of task that has been pushed to any deque but has not been executed
+    // yet.
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<usize> active_task_count = 0;
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<u32> parked_thread_count = 0;
+    // NOTE(kevinyu): Number of thread sleeping in wait_task(), schedule_task() only take
+    // wait_mutex when it is not zero.
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<u32> waiting_thread_count = 0;
 
-    Database() : thread_contexts(nullptr) {}
+    ThreadCount thread_count = 0;
+    u32 worker_spin_count    = 0;
+
+    // NOTE(kevinyu): Thread index sorted by cache group
+    FixedVector<u16> steal_group_threads;
+    b8 pin_worker_threads          = false;
+    const char* worker_thread_name = "Worker";
+
+    // NOTE(kevinyu): Background lane. Background task are coarse grained so a mutex guarded
+    // queue is good enough here. Workers only take from this queue when there is no frame task.
+    std::mutex background_mutex;
+    // Notified every time a slot is returned to background_free_slots, shutdown() wait on it to
+    // drain the lane.
+    std::condition_variable background_free_cond_var;
+    FixedVector<BackgroundTask> background_tasks;
+    FixedVector<u32> background_free_slots;
+    u32 background_free_slot_count = 0;
+    FixedVector<u32> background_queue;
+    u32 background_queue_head = 0;
+    u32 background_queue_tail = 0;
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<u32> background_pending_count = 0;
+    std::atomic<u32> background_running_count                             = 0;
+    u32 max_background_thread_count                                       = 0;
+    std::atomic<b8> is_background_cancel_requested                        = false;
+
+    // NOTE(kevinyu): Coroutine waiting for the next begin_frame(). Lock free push list, the node
+    // live inside the suspended coroutine frame.
+    std::atomic<CoroutineResumeNode*> next_frame_resume_head = nullptr;
+
+    memory::Allocator* default_allocator             = nullptr;
+    usize temp_allocator_size                        = 0;
+    memory::FrameRingAllocator* frame_ring_allocator = nullptr;
+
+    u64 frame_begin_ns      = 0;
+    u64 last_frame_begin_ns = 0;
+
+    // NOTE(kevinyu): Allocation counting for the frame allocation budget. The counter is bumped
+    // from every thread, violations are only written under the mutex.
+    alignas(SOUL_CACHELINE_SIZE) std::atomic<u32> frame_allocation_count = 0;
+
+    std::atomic<u32> frame_allocation_budget = FRAME_ALLOCATION_BUDGET_DISABLED;
+    b8 panic_on_frame_allocation_budget      = false;
+    std::mutex frame_allocation_violation_mutex;
+    u32 frame_allocation_violation_count = 0;
+    FrameAllocationViolation
+      frame_allocation_violations[Constant::MAX_FRAME_ALLOCATION_VIOLATION_COUNT];
+    u32 last_frame_allocation_count = 0;
+    u64 frame_index                 = 0;
+
+    Database()
+        : thread_contexts(nullptr),
+          threads(nullptr),
+          steal_group_threads(nullptr),
+          background_tasks(nullptr),
+          background_free_slots(nullptr),
+          background_queue(nullptr)
+    {
+    }
   };
 
   template <typename Func>
@@ -211,4 +606,7 @@ namespace soul::runtime
   template <typename T>
   concept execution = ts_fn<T, void, TaskID>;
 
+  template <typename T>
+  concept background_execution = ts_fn<T, void>;
+
 } // namespace soul::runtime
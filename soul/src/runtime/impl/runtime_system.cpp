@@ -1,6 +1,12 @@
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <string_view>
 #include <thread>
 
 #include "core/architecture.h"
+#include "core/flag_map.h"
+#include "core/log.h"
 #include "core/panic_format.h"
 #include "core/profile.h"
 #include "core/string.h"
@@ -8,6 +14,7 @@
 #include "memory/allocators/linear_allocator.h"
 #include "memory/allocators/proxy_allocator.h"
 #include "runtime/data.h"
+#include "runtime/impl/thread_platform.h"
 #include "runtime/system.h"
 
 namespace soul::runtime
@@ -15,15 +22,97 @@ namespace soul::runtime
 
   thread_local ThreadContext* Database::g_thread_context = nullptr; // NOLINT
 
-  void System::execute(TaskID task_id)
+  namespace
   {
+    auto get_coroutine_frame_size_class(usize size) -> u32
     {
-      std::lock_guard<std::mutex> lock(db_.loop_mutex);
-      db_.active_task_count -= 1;
+      if (size <= (usize(1) << Constant::COROUTINE_FRAME_MIN_SIZE_SHIFT))
+      {
+        return 0;
+      }
+      return soul::cast<u32>(std::bit_width(size - 1)) - Constant::COROUTINE_FRAME_MIN_SIZE_SHIFT;
     }
-    Task* task = get_task_ptr(task_id);
+
+    auto get_time_ns() -> u64
+    {
+      const auto now = std::chrono::steady_clock::now().time_since_epoch();
+      return soul::cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
+
+    // NOTE(kevinyu): All the stats helpers below compile to nothing when SOUL_RUNTIME_STATS_ENABLE
+    // is not defined.
+    auto get_stats_time_ns() -> u64
+    {
+      if constexpr (RUNTIME_STATS_ENABLE)
+      {
+        return get_time_ns();
+      }
+      return 0;
+    }
+
+    void increment_stats(std::atomic<u64>& counter)
+    {
+      if constexpr (RUNTIME_STATS_ENABLE)
+      {
+        counter.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    void record_trace_event(
+      ThreadContext* thread_context, TraceEventType type, TaskID task_id, u64 begin_ns)
+    {
+      if constexpr (RUNTIME_STATS_ENABLE)
+      {
+        thread_context->trace_events.push_back(TraceEvent{type, task_id, begin_ns, get_time_ns()});
+      }
+    }
+
+    // NOTE(kevinyu): Task is cache line aligned so two workers never share a line, request the
+    // alignment explicitly instead of relying on the backing allocator honouring alignof().
+    auto create_task_page(memory::Allocator* allocator) -> TaskPage*
+    {
+      static_assert(alignof(TaskPage) == SOUL_CACHELINE_SIZE);
+      void* addr =
+        allocator->allocate(sizeof(TaskPage), alignof(TaskPage), "runtime::task_page"_str);
+      SOUL_ASSERT(0, addr != nullptr && (uptr(addr) & (alignof(TaskPage) - 1)) == 0);
+      return new (addr) TaskPage();
+    }
+
+    class StatsTimer
+    {
+    public:
+      StatsTimer() : begin_ns_(get_stats_time_ns()) {}
+
+      void restart()
+      {
+        begin_ns_ = get_stats_time_ns();
+      }
+
+      // add the elapsed time since the last restart to counter, then restart
+      void flush_to(std::atomic<u64>& counter)
+      {
+        if constexpr (RUNTIME_STATS_ENABLE)
+        {
+          const u64 now_ns = get_time_ns();
+          counter.fetch_add(now_ns - begin_ns_, std::memory_order_relaxed);
+          begin_ns_ = now_ns;
+        }
+      }
+
+    private:
+      u64 begin_ns_;
+    };
+  } // namespace
+
+  void System::execute(TaskID task_id)
+  {
+    db_.active_task_count.fetch_sub(1, std::memory_order_relaxed);
+    Task* task         = get_task_ptr(task_id);
+    const u64 begin_ns = get_stats_time_ns();
     task->func(task_id, task->storage);
-    finish_task(task);
+    record_trace_event(Database::g_thread_context, TraceEventType::TASK, task_id, begin_ns);
+    increment_stats(Database::g_thread_context->stats.executed_task_count);
+    finish_task(task_id);
   }
 
   void System::loop(ThreadContext* thread_context)
@@ -32,34 +121,72 @@ namespace soul::runtime
 
     const auto thread_name = String::Format("Worker Thread = {}", get_thread_id());
     SOUL_PROFILE_THREAD_SET_NAME(thread_name.data());
+    impl::set_current_thread_name(
+      String::Format("{} {}", db_.worker_thread_name, get_thread_id()).c_str());
+    if (db_.pin_worker_threads)
+    {
+      impl::set_current_thread_affinity(thread_context->core_index);
+    }
 
+    memory::PageAllocator page_allocator("runtime::System::loop"_str);
     memory::LinearAllocator linear_allocator(
-      "runtime::System::loop"_str, 20 * ONE_MEGABYTE, get_context_allocator());
+      "runtime::System::loop"_str, db_.temp_allocator_size, &page_allocator);
     TempAllocator temp_allocator(&linear_allocator, TempProxy::Config());
     thread_context->temp_allocator = &temp_allocator;
 
+    WorkerStatsCounter& stats = thread_context->stats;
     while (true)
     {
+      u32 spin_count = 0;
+      StatsTimer idle_timer;
       TaskID task_id = thread_context->task_deque.pop();
       while (task_id == TaskID::NULLVAL())
       {
+        if (db_.is_terminated.load(std::memory_order_relaxed))
+        {
+          break;
+        }
 
+        if (db_.active_task_count.load(std::memory_order_relaxed) != 0)
+        {
+          const usize thread_index = get_steal_victim(thread_context, spin_count);
+          task_id                  = db_.thread_contexts[thread_index].task_deque.steal();
+          increment_stats(stats.steal_attempt_count);
+          if (!task_id.is_null())
+          {
+            increment_stats(stats.steal_success_count);
+            // NOTE(kevinyu): task_run() only wake one worker. If there is still more work left,
+            // pass the wake up to another parked worker.
+            if (db_.active_task_count.load(std::memory_order_relaxed) > 1)
+            {
+              wake_one_worker();
+            }
+            break;
+          }
+        } else
         {
-          std::unique_lock<std::mutex> lock(db_.loop_mutex);
-          while (db_.active_task_count == 0 && !db_.is_terminated.load(std::memory_order_relaxed))
+          idle_timer.flush_to(stats.idle_time_ns);
+          if (try_execute_background_task(thread_context))
           {
-            db_.loop_cond_var.wait(lock);
+            idle_timer.restart();
+            spin_count = 0;
+            continue;
           }
         }
 
-        if (db_.is_terminated.load(std::memory_order_relaxed))
+        if (spin_count < db_.worker_spin_count)
         {
-          break;
+          spin_count++;
+          cpu_pause();
+        } else
+        {
+          idle_timer.flush_to(stats.idle_time_ns);
+          park(thread_context);
+          idle_timer.flush_to(stats.parked_time_ns);
+          spin_count = 0;
         }
-
-        const usize thread_index = (util::get_random_u32() % db_.thread_count);
-        task_id                  = db_.thread_contexts[thread_index].task_deque.steal();
       }
+      idle_timer.flush_to(stats.idle_time_ns);
 
       if (db_.is_terminated.load(std::memory_order_relaxed))
       {
@@ -69,13 +196,185 @@ namespace soul::runtime
     }
   }
 
+  auto System::get_steal_victim(const ThreadContext* thread_context, u32 attempt) const -> usize
+  {
+    // NOTE(kevinyu): Steal from a worker that share the cache most of the time, but still try any
+    // worker every few attempts so work can flow between cache groups.
+    static constexpr u32 GLOBAL_STEAL_INTERVAL = 4;
+    if (thread_context->steal_group_count > 1 && (attempt % GLOBAL_STEAL_INTERVAL) != 0)
+    {
+      const u32 group_offset = util::get_random_u32() % thread_context->steal_group_count;
+      return db_.steal_group_threads[thread_context->steal_group_begin + group_offset];
+    }
+    return util::get_random_u32() % db_.thread_count;
+  }
+
+  void System::park(ThreadContext* thread_context)
+  {
+    // NOTE(kevinyu): The park state store and the active_task_count load below pair with the
+    // active_task_count increment and the park state load in task_run(). Because all of them are
+    // sequentially consistent, either this worker see the new task and skip parking or task_run()
+    // see this worker as parked and wake it up. No wake up can be lost.
+    thread_context->park_state.store(ParkState::PARKED, std::memory_order_seq_cst);
+    db_.parked_thread_count.fetch_add(1, std::memory_order_seq_cst);
+
+    if (!has_pending_work() && !db_.is_terminated.load(std::memory_order_seq_cst))
+    {
+      thread_context->park_state.wait(ParkState::PARKED, std::memory_order_acquire);
+    }
+
+    db_.parked_thread_count.fetch_sub(1, std::memory_order_relaxed);
+    thread_context->park_state.store(ParkState::RUNNING, std::memory_order_relaxed);
+  }
+
+  auto System::has_pending_work() const -> b8
+  {
+    if (db_.active_task_count.load(std::memory_order_seq_cst) != 0)
+    {
+      return true;
+    }
+    return db_.background_pending_count.load(std::memory_order_seq_cst) != 0 &&
+           db_.background_running_count.load(std::memory_order_relaxed) <
+             db_.max_background_thread_count;
+  }
+
+  auto System::submit_background_task(BackgroundTaskFunc func, void* data) -> BackgroundTaskID
+  {
+    SOUL_ASSERT(0, db_.thread_count > 1, "Background task need at least one worker thread");
+
+    BackgroundTaskID task_id;
+    {
+      std::lock_guard<std::mutex> lock(db_.background_mutex);
+      SOUL_ASSERT(
+        0,
+        db_.background_free_slot_count != 0,
+        "Number of background task exceed capacity."
+        "You can configure capacity in Runtime::Constant::MAX_BACKGROUND_TASK_COUNT.");
+      db_.background_free_slot_count -= 1;
+      const u32 slot_index = db_.background_free_slots[db_.background_free_slot_count];
+
+      BackgroundTask& task = db_.background_tasks[slot_index];
+      task.func            = func;
+      task.data            = data;
+      task_id.index        = slot_index;
+      task_id.generation   = task.generation.load(std::memory_order_relaxed);
+
+      db_.background_queue[db_.background_queue_tail % Constant::MAX_BACKGROUND_TASK_COUNT] =
+        slot_index;
+      db_.background_queue_tail += 1;
+    }
+
+    // NOTE(kevinyu): Pair with has_pending_work() in park(), same as the active_task_count
+    // increment in task_run()
+    db_.background_pending_count.fetch_add(1, std::memory_order_seq_cst);
+    wake_one_worker();
+    return task_id;
+  }
+
+  auto System::try_execute_background_task(ThreadContext* thread_context) -> b8
+  {
+    if (db_.background_pending_count.load(std::memory_order_relaxed) == 0)
+    {
+      return false;
+    }
+
+    // NOTE(kevinyu): Limit the number of worker that run background task at the same time, so
+    // long background task cannot starve the frame task.
+    u32 running_count = db_.background_running_count.load(std::memory_order_relaxed);
+    do
+    {
+      if (running_count >= db_.max_background_thread_count)
+      {
+        return false;
+      }
+    }
+    while (!db_.background_running_count.compare_exchange_weak(
+      running_count, running_count + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    u32 slot_index = 0;
+    {
+      std::lock_guard<std::mutex> lock(db_.background_mutex);
+      if (db_.background_queue_head == db_.background_queue_tail)
+      {
+        db_.background_running_count.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+      }
+      slot_index =
+        db_.background_queue[db_.background_queue_head % Constant::MAX_BACKGROUND_TASK_COUNT];
+      db_.background_queue_head += 1;
+    }
+    db_.background_pending_count.fetch_sub(1, std::memory_order_relaxed);
+
+    BackgroundTask& task                       = db_.background_tasks[slot_index];
+    thread_context->is_running_background_task = true;
+    task.func(task.data);
+    thread_context->is_running_background_task = false;
+
+    // NOTE(kevinyu): Bump the generation before the slot is recycled, so a waiter never see the
+    // generation of the next task that use this slot.
+    task.generation.fetch_add(1, std::memory_order_release);
+    task.generation.notify_all();
+    {
+      std::lock_guard<std::mutex> lock(db_.background_mutex);
+      db_.background_free_slots[db_.background_free_slot_count] = slot_index;
+      db_.background_free_slot_count += 1;
+    }
+    db_.background_free_cond_var.notify_all();
+
+    db_.background_running_count.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  auto System::is_background_task_complete(BackgroundTaskID task_id) const -> b8
+  {
+    const BackgroundTask& task = db_.background_tasks[task_id.index];
+    return task.generation.load(std::memory_order_acquire) != task_id.generation;
+  }
+
+  void System::wait_background_task(BackgroundTaskID task_id)
+  {
+    const BackgroundTask& task = db_.background_tasks[task_id.index];
+    while (task.generation.load(std::memory_order_acquire) == task_id.generation)
+    {
+      task.generation.wait(task_id.generation, std::memory_order_acquire);
+    }
+  }
+
+  auto System::is_background_cancel_requested() const -> b8
+  {
+    return db_.is_background_cancel_requested.load(std::memory_order_relaxed);
+  }
+
+  void System::wake_one_worker()
+  {
+    if (db_.parked_thread_count.load(std::memory_order_seq_cst) == 0)
+    {
+      return;
+    }
+
+    const usize start_index = util::get_random_u32() % db_.thread_count;
+    for (usize i = 0; i < db_.thread_count; i++)
+    {
+      ThreadContext& thread_context = db_.thread_contexts[(start_index + i) % db_.thread_count];
+      auto expected                 = ParkState::PARKED;
+      if (thread_context.park_state.compare_exchange_strong(
+            expected, ParkState::NOTIFIED, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        thread_context.park_state.notify_one();
+        return;
+      }
+    }
+  }
+
   void System::terminate()
   {
-    db_.is_terminated.store(true);
+    db_.is_terminated.store(true, std::memory_order_seq_cst);
+    for (usize i = 1; i < db_.thread_count; i++)
     {
-      std::lock_guard<std::mutex> lock(db_.loop_mutex);
+      ThreadContext& thread_context = db_.thread_contexts[i];
+      thread_context.park_state.store(ParkState::NOTIFIED, std::memory_order_seq_cst);
+      thread_context.park_state.notify_one();
     }
-    db_.loop_cond_var.notify_all();
   }
 
   void System::begin_frame()
@@ -84,10 +383,37 @@ namespace soul::runtime
     SOUL_ASSERT_MAIN_THREAD();
 
     wait_task(TaskID::NULLVAL());
+    SOUL_MEMPROFILE_FRAME();
+    check_frame_allocation_budget();
+
+    if constexpr (RUNTIME_STATS_ENABLE)
+    {
+      for (auto& thread_context : db_.thread_contexts)
+      {
+        WorkerStatsCounter& stats = thread_context.stats;
+        thread_context.last_frame_stats = {
+          .executed_task_count = stats.executed_task_count.exchange(0, std::memory_order_relaxed),
+          .steal_attempt_count = stats.steal_attempt_count.exchange(0, std::memory_order_relaxed),
+          .steal_success_count = stats.steal_success_count.exchange(0, std::memory_order_relaxed),
+          .idle_time_ns        = stats.idle_time_ns.exchange(0, std::memory_order_relaxed),
+          .parked_time_ns      = stats.parked_time_ns.exchange(0, std::memory_order_relaxed),
+          .wait_task_time_ns   = stats.wait_task_time_ns.exchange(0, std::memory_order_relaxed),
+          .max_queue_depth     = stats.max_queue_depth.exchange(0, std::memory_order_relaxed),
+        };
+        std::swap(thread_context.trace_events, thread_context.last_frame_trace_events);
+        thread_context.trace_events.clear();
+      }
+      db_.last_frame_begin_ns = db_.frame_begin_ns;
+      db_.frame_begin_ns      = get_time_ns();
+    }
 
     init_root_task();
 
     db_.thread_contexts[0].temp_allocator->reset();
+    if (db_.frame_ring_allocator != nullptr)
+    {
+      db_.frame_ring_allocator->begin_frame();
+    }
 
     for (usize i = 1; i < db_.thread_count; i++)
     {
@@ -95,21 +421,61 @@ namespace soul::runtime
       db_.thread_contexts[i].task_deque.reset();
       db_.thread_contexts[i].temp_allocator->reset();
     }
+
+    for (auto& thread_context : db_.thread_contexts)
+    {
+      thread_context.continuation_count      = 0;
+      thread_context.task_payload_page_index = 0;
+      thread_context.task_payload_offset     = 0;
+    }
+
+    // NOTE(kevinyu): The list is pushed in LIFO order, reverse it so coroutines are resumed in the
+    // order they are suspended.
+    CoroutineResumeNode* node =
+      db_.next_frame_resume_head.exchange(nullptr, std::memory_order_acquire);
+    CoroutineResumeNode* ordered_node = nullptr;
+    while (node != nullptr)
+    {
+      CoroutineResumeNode* next = node->next;
+      node->next                = ordered_node;
+      ordered_node              = node;
+      node                      = next;
+    }
+    while (ordered_node != nullptr)
+    {
+      // NOTE(kevinyu): The node live inside the coroutine frame, read next before resuming.
+      CoroutineResumeNode* next = ordered_node->next;
+      ordered_node->handle.resume();
+      ordered_node = next;
+    }
   }
 
   auto System::create_task(TaskID parent, TaskFunc func) -> TaskID
   {
     ThreadContext* thread_state = Database::g_thread_context;
+    SOUL_ASSERT(
+      0, !thread_state->is_running_background_task, "Background task cannot create frame task");
 
     const auto thread_index = thread_state->thread_index;
     const auto task_index   = thread_state->task_count;
     const auto task_id      = TaskID(thread_index, task_index);
 
+    const u32 page_index = task_index >> Constant::TASK_PAGE_SHIFT;
+    if (page_index == thread_state->task_page_count)
+    {
+      thread_state->task_pages[page_index] = create_task_page(db_.default_allocator);
+      thread_state->task_page_count += 1;
+    }
+    TaskPage& task_page = *thread_state->task_pages[page_index];
+
     thread_state->task_count += 1;
-    Task& task     = thread_state->task_pool[task_index];
+    Task& task     = task_page.tasks[task_index & Constant::TASK_PAGE_MASK];
     task.parent_id = parent;
     task.unfinished_count.store(1, std::memory_order_relaxed);
+    task.dependency_count.store(1, std::memory_order_relaxed);
     task.func = func;
+    task_page.task_continuations[task_index & Constant::TASK_PAGE_MASK].store(
+      nullptr, std::memory_order_relaxed);
 
     Task* parent_task = get_task_ptr(parent);
     parent_task->unfinished_count.fetch_add(1, std::memory_order_relaxed);
@@ -117,12 +483,93 @@ namespace soul::runtime
     return task_id;
   }
 
+  auto System::allocate_task_payload(usize size, usize alignment) -> void*
+  {
+    ThreadContext* thread_context = Database::g_thread_context;
+    Vector<byte*>& pages          = thread_context->task_payload_pages;
+    while (true)
+    {
+      if (thread_context->task_payload_page_index == pages.size())
+      {
+        pages.push_back(static_cast<byte*>(db_.default_allocator->allocate(
+          Constant::TASK_PAYLOAD_PAGE_SIZE, SOUL_CACHELINE_SIZE, "runtime::task_payload"_str)));
+      }
+
+      const usize offset = (thread_context->task_payload_offset + alignment - 1) & ~(alignment - 1);
+      if (offset + size <= Constant::TASK_PAYLOAD_PAGE_SIZE)
+      {
+        thread_context->task_payload_offset = offset + size;
+        return pages[thread_context->task_payload_page_index] + offset;
+      }
+      thread_context->task_payload_page_index++;
+      thread_context->task_payload_offset = 0;
+    }
+  }
+
   auto System::get_task_ptr(TaskID task_id) -> Task*
   {
     const usize thread_index = task_id.get_thread_index();
     const usize task_index   = task_id.get_task_index();
 
-    return &db_.thread_contexts[thread_index].task_pool[task_index];
+    return &db_.thread_contexts[thread_index]
+              .task_pages[task_index >> Constant::TASK_PAGE_SHIFT]
+              ->tasks[task_index & Constant::TASK_PAGE_MASK];
+  }
+
+  auto System::get_task_continuation_head(TaskID task_id) -> std::atomic<TaskContinuation*>&
+  {
+    const usize thread_index = task_id.get_thread_index();
+    const usize task_index   = task_id.get_task_index();
+
+    return db_.thread_contexts[thread_index]
+      .task_pages[task_index >> Constant::TASK_PAGE_SHIFT]
+      ->task_continuations[task_index & Constant::TASK_PAGE_MASK];
+  }
+
+  void System::add_task_dependency(TaskID task_id, TaskID dependency_id)
+  {
+    SOUL_ASSERT(0, !dependency_id.is_root(), "Root task cannot be used as a dependency");
+    Task* task = get_task_ptr(task_id);
+    SOUL_ASSERT(
+      0,
+      task->dependency_count.load(std::memory_order_relaxed) != 0,
+      "Cannot add dependency to a task that has been run");
+
+    ThreadContext* thread_state    = Database::g_thread_context;
+    const u32 continuation_index   = thread_state->continuation_count;
+    const u32 page_index           = continuation_index / Constant::CONTINUATION_PAGE_SIZE;
+    if (page_index == thread_state->continuation_pages.size())
+    {
+      thread_state->continuation_pages.push_back(
+        db_.default_allocator->create<TaskContinuationPage>().unwrap());
+    }
+    TaskContinuation* continuation = &thread_state->continuation_pages[page_index]->continuations
+                                        [continuation_index % Constant::CONTINUATION_PAGE_SIZE];
+    thread_state->continuation_count += 1;
+    continuation->task_id = task_id;
+
+    task->dependency_count.fetch_add(1, std::memory_order_relaxed);
+
+    auto& continuation_head = get_task_continuation_head(dependency_id);
+    TaskContinuation* next  = continuation_head.load(std::memory_order_acquire);
+    do
+    {
+      if (next == &db_.closed_continuation)
+      {
+        // NOTE(kevinyu): dependency is already finished. The run gate is still held so the count
+        // cannot reach zero here.
+        task->dependency_count.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
+      continuation->next = next;
+    }
+    while (!continuation_head.compare_exchange_weak(
+      next, continuation, std::memory_order_release, std::memory_order_acquire));
+  }
+
+  auto System::is_task_complete(TaskID task_id) -> b8
+  {
+    return is_task_complete(get_task_ptr(task_id));
   }
 
   auto System::is_task_complete(Task* task) -> b8
@@ -132,39 +579,148 @@ namespace soul::runtime
     return task->unfinished_count.load(std::memory_order_acquire) == 0;
   }
 
-  // TODO(kevinyu) : Implement stealing from other deque when waiting for task.
-  // Currently we only try to pop task from our thread local deque.
+  auto System::is_descendant_task(TaskID task_id, TaskID ancestor_id) -> b8
+  {
+    if (ancestor_id.is_root())
+    {
+      return true;
+    }
+    while (!task_id.is_root())
+    {
+      if (task_id == ancestor_id)
+      {
+        return true;
+      }
+      task_id = get_task_ptr(task_id)->parent_id;
+    }
+    return false;
+  }
+
+  auto System::is_local_deque_empty() const -> b8
+  {
+    return Database::g_thread_context->task_deque.is_empty();
+  }
+
+  auto System::steal_nested_task(TaskID wait_task_id) -> TaskID
+  {
+    // NOTE(kevinyu): Only descendant of the task that we wait are safe to run nested. The waited
+    // task cannot complete before its descendant anyway, so running them here never delay the
+    // return of wait_task() and never create wait cycle between unrelated tasks.
+    const auto is_nested_safe = [this, wait_task_id](TaskID task_id) -> b8
+    {
+      return is_descendant_task(task_id, wait_task_id);
+    };
+
+    const usize start_index = util::get_random_u32() % db_.thread_count;
+    for (usize i = 0; i < db_.thread_count; i++)
+    {
+      const usize thread_index = (start_index + i) % db_.thread_count;
+      if (thread_index == get_thread_id())
+      {
+        continue;
+      }
+      const TaskID task_id = db_.thread_contexts[thread_index].task_deque.steal_if(is_nested_safe);
+      if (!task_id.is_null())
+      {
+        return task_id;
+      }
+    }
+    return TaskID::NULLVAL();
+  }
+
   void System::wait_task(TaskID task_id)
   {
     ThreadContext* thread_state = Database::g_thread_context;
     Task* task_to_wait          = get_task_ptr(task_id);
+    u32 spin_count              = 0;
+    const u64 begin_ns          = get_stats_time_ns();
+    StatsTimer wait_timer;
     while (!is_task_complete(task_to_wait))
     {
-
       TaskID task_to_do = thread_state->task_deque.pop();
+      if (task_to_do.is_null())
+      {
+        task_to_do = steal_nested_task(task_id);
+      }
 
       if (!task_to_do.is_null())
       {
+        wait_timer.flush_to(thread_state->stats.wait_task_time_ns);
         execute(task_to_do);
+        wait_timer.restart();
+        spin_count = 0;
+      } else if (spin_count < db_.worker_spin_count)
+      {
+        spin_count++;
+        cpu_pause();
       } else
       {
-        std::unique_lock<std::mutex> lock(db_.wait_mutex);
-        while (!is_task_complete(task_to_wait))
+        // NOTE(kevinyu): Every deque is out of work that we can run, the remaining descendant are
+        // being executed by other threads. Sleep until the task complete or a new task is
+        // scheduled, the running descendant can still spawn children that we should help with.
+        // Register as waiter before the last scan, so a task scheduled after the scan always
+        // bump wait_generation and wake us up.
+        u32 wait_generation;
+        {
+          std::lock_guard<std::mutex> lock(db_.wait_mutex);
+          db_.waiting_thread_count.fetch_add(1, std::memory_order_seq_cst);
+          wait_generation = db_.wait_generation;
+        }
+        const TaskID stolen_task_id = steal_nested_task(task_id);
+        if (!stolen_task_id.is_null())
+        {
+          db_.waiting_thread_count.fetch_sub(1, std::memory_order_relaxed);
+          wait_timer.flush_to(thread_state->stats.wait_task_time_ns);
+          execute(stolen_task_id);
+          wait_timer.restart();
+          spin_count = 0;
+          continue;
+        }
         {
-          db_.wait_cond_var.wait(lock);
+          std::unique_lock<std::mutex> lock(db_.wait_mutex);
+          db_.wait_cond_var.wait(
+            lock,
+            [this, task_to_wait, wait_generation]() -> b8
+            {
+              return is_task_complete(task_to_wait) || db_.wait_generation != wait_generation;
+            });
         }
+        db_.waiting_thread_count.fetch_sub(1, std::memory_order_relaxed);
+        spin_count = 0;
       }
     }
+    wait_timer.flush_to(thread_state->stats.wait_task_time_ns);
+    record_trace_event(thread_state, TraceEventType::WAIT_TASK, task_id, begin_ns);
   }
 
   void System::init_root_task()
   {
     // NOTE(kevinyu): TaskID 0 is ROOT. TaskID 0 is used as parent for all task
-    db_.thread_contexts[0].task_pool[0].unfinished_count.store(0, std::memory_order_relaxed);
+    ThreadContext& main_thread_context = db_.thread_contexts[0];
+    if (main_thread_context.task_page_count == 0)
+    {
+      main_thread_context.task_pages[0] = create_task_page(db_.default_allocator);
+      main_thread_context.task_page_count = 1;
+    }
+    TaskPage& root_page = *main_thread_context.task_pages[0];
+    root_page.tasks[0].unfinished_count.store(0, std::memory_order_relaxed);
+    root_page.tasks[0].dependency_count.store(0, std::memory_order_relaxed);
+    root_page.task_continuations[0].store(nullptr, std::memory_order_relaxed);
     db_.thread_contexts[0].task_count = 1;
     db_.thread_contexts[0].task_deque.reset();
   }
 
+  auto FrameAllocationProxy::on_post_allocate(
+    const memory::AllocateParam& alloc_param, const memory::Allocation allocation)
+    -> memory::Allocation
+  {
+    if (allocation.addr != nullptr)
+    {
+      System::get().on_frame_allocation(name_, alloc_param.tag, alloc_param.size);
+    }
+    return allocation;
+  }
+
   auto System::is_worker_thread() const -> b8
   {
     return db_.g_thread_context != nullptr;
@@ -172,8 +728,13 @@ namespace soul::runtime
 
   void System::init(const Config& config)
   {
-    db_.default_allocator   = config.defaultAllocator;
-    db_.temp_allocator_size = config.workerTempAllocatorSize;
+    db_.default_allocator    = config.defaultAllocator;
+    db_.temp_allocator_size  = config.workerTempAllocatorSize;
+    db_.frame_ring_allocator = config.frameRingAllocator;
+    db_.frame_allocation_budget.store(config.frameAllocationBudget, std::memory_order_relaxed);
+    db_.panic_on_frame_allocation_budget = config.panicOnFrameAllocationBudget;
+    db_.worker_spin_count    = config.workerSpinCount != 0 ? config.workerSpinCount
+                                                           : Constant::DEFAULT_WORKER_SPIN_COUNT;
 
     const auto thread_count = config.threadCount != 0
                                 ? config.threadCount
@@ -193,47 +754,179 @@ namespace soul::runtime
       [&config](usize idx) -> ThreadContext
       {
         return ThreadContext{
-          .task_count      = 0,
-          .thread_index    = static_cast<u16>(idx),
-          .allocator_stack = Vector<memory::Allocator*>(config.defaultAllocator),
+          .task_count              = 0,
+          .continuation_pages      = Vector<TaskContinuationPage*>(config.defaultAllocator),
+          .task_payload_pages      = Vector<byte*>(config.defaultAllocator),
+          .thread_index            = static_cast<u16>(idx),
+          .allocator_stack         = Vector<memory::Allocator*>(config.defaultAllocator),
+          .trace_events            = Vector<TraceEvent>(config.defaultAllocator),
+          .last_frame_trace_events = Vector<TraceEvent>(config.defaultAllocator),
         };
       });
 
     // NOTE(kevinyu): i == 0 is for main thread
     Database::g_thread_context = db_.thread_contexts.data();
 
+    init_thread_topology(config);
+
     for (auto& thread_context : db_.thread_contexts)
     {
-      thread_context.task_deque.init();
+      thread_context.task_deque.init(config.defaultAllocator);
     }
 
     db_.is_terminated.store(false, std::memory_order_relaxed);
+    db_.active_task_count.store(0, std::memory_order_relaxed);
+    db_.parked_thread_count.store(0, std::memory_order_relaxed);
+    db_.threads.init(*config.defaultAllocator, thread_count);
+
+    db_.max_background_thread_count =
+      config.backgroundThreadCount != 0 ? config.backgroundThreadCount
+                                        : std::max(1, (thread_count - 1) / 2);
+    db_.background_tasks.init(*config.defaultAllocator, Constant::MAX_BACKGROUND_TASK_COUNT);
+    db_.background_free_slots.init_generate(
+      config.defaultAllocator,
+      Constant::MAX_BACKGROUND_TASK_COUNT,
+      [](usize idx) -> u32
+      {
+        return soul::cast<u32>(Constant::MAX_BACKGROUND_TASK_COUNT - 1 - idx);
+      });
+    db_.background_free_slot_count = Constant::MAX_BACKGROUND_TASK_COUNT;
+    db_.background_queue.init(*config.defaultAllocator, Constant::MAX_BACKGROUND_TASK_COUNT);
+    db_.background_queue_head = 0;
+    db_.background_queue_tail = 0;
+    db_.background_pending_count.store(0, std::memory_order_relaxed);
+    db_.background_running_count.store(0, std::memory_order_relaxed);
+    db_.is_background_cancel_requested.store(false, std::memory_order_relaxed);
     for (u16 i = 1; i < thread_count; ++i)
     {
       db_.threads[i] = std::thread(&System::loop, this, &db_.thread_contexts[i]);
     }
-    db_.active_task_count = 0;
 
     get_thread_context().temp_allocator = config.mainThreadTempAllocator;
 
+    db_.frame_begin_ns      = get_stats_time_ns();
+    db_.last_frame_begin_ns = db_.frame_begin_ns;
+
     init_root_task();
   }
 
+  void System::init_thread_topology(const Config& config)
+  {
+    db_.pin_worker_threads = config.pinWorkerThreads;
+    db_.worker_thread_name =
+      config.workerThreadName != nullptr ? config.workerThreadName : "Worker";
+    db_.steal_group_threads.init_generate(
+      config.defaultAllocator,
+      db_.thread_count,
+      [](usize idx) -> u16
+      {
+        return soul::cast<u16>(idx);
+      });
+
+    if (!config.pinWorkerThreads)
+    {
+      // NOTE(kevinyu): Unpinned thread can migrate between cores, every worker is a neighbour.
+      for (auto& thread_context : db_.thread_contexts)
+      {
+        thread_context.steal_group_begin = 0;
+        thread_context.steal_group_count = db_.thread_count;
+      }
+      return;
+    }
+
+    const usize core_count        = get_hardware_thread_count();
+    const usize first_worker_core = config.reserveMainThreadCore && core_count > 1 ? 1 : 0;
+    const auto core_groups = impl::get_core_cache_groups(core_count, config.defaultAllocator);
+    for (auto& thread_context : db_.thread_contexts)
+    {
+      thread_context.core_index =
+        thread_context.thread_index == 0
+          ? 0
+          : (first_worker_core + thread_context.thread_index - 1) % core_count;
+    }
+
+    const auto get_thread_group = [this, &core_groups](u16 thread_index) -> u16
+    {
+      return core_groups[db_.thread_contexts[thread_index].core_index];
+    };
+    std::ranges::stable_sort(
+      db_.steal_group_threads,
+      [&get_thread_group](u16 left, u16 right) -> b8
+      {
+        return get_thread_group(left) < get_thread_group(right);
+      });
+
+    u16 group_begin = 0;
+    while (group_begin < db_.thread_count)
+    {
+      const u16 group = get_thread_group(db_.steal_group_threads[group_begin]);
+      u16 group_end   = group_begin;
+      while (group_end < db_.thread_count &&
+             get_thread_group(db_.steal_group_threads[group_end]) == group)
+      {
+        group_end++;
+      }
+      for (u16 i = group_begin; i < group_end; i++)
+      {
+        ThreadContext& thread_context    = db_.thread_contexts[db_.steal_group_threads[i]];
+        thread_context.steal_group_begin = group_begin;
+        thread_context.steal_group_count = group_end - group_begin;
+      }
+      group_begin = group_end;
+    }
+
+    if (config.reserveMainThreadCore)
+    {
+      impl::set_current_thread_affinity(0);
+    }
+  }
+
   void System::task_run(TaskID task_id)
   {
-    Database::g_thread_context->task_deque.push(task_id);
+    // NOTE(kevinyu): Release the run gate. If there are still unfinished dependencies, the last
+    // one to finish will schedule the task in run_continuations().
+    Task* task = get_task_ptr(task_id);
+    if (task->dependency_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      schedule_task(task_id);
+    }
+  }
+
+  void System::schedule_task(TaskID task_id)
+  {
+    ThreadContext* thread_context = Database::g_thread_context;
+    thread_context->task_deque.push(task_id);
+    if constexpr (RUNTIME_STATS_ENABLE)
+    {
+      const auto depth = soul::cast<u32>(thread_context->task_deque.size());
+      std::atomic<u32>& max_depth = thread_context->stats.max_queue_depth;
+      u32 current_max_depth       = max_depth.load(std::memory_order_relaxed);
+      while (depth > current_max_depth &&
+             !max_depth.compare_exchange_weak(
+               current_max_depth, depth, std::memory_order_relaxed, std::memory_order_relaxed))
+      {
+      }
+    }
+    db_.active_task_count.fetch_add(1, std::memory_order_seq_cst);
+    wake_one_worker();
+    if (db_.waiting_thread_count.load(std::memory_order_seq_cst) != 0)
     {
-      std::lock_guard<std::mutex> lock(db_.loop_mutex);
-      db_.active_task_count += 1;
+      {
+        std::lock_guard<std::mutex> lock(db_.wait_mutex);
+        db_.wait_generation++;
+      }
+      db_.wait_cond_var.notify_all();
     }
-    db_.loop_cond_var.notify_all();
   }
 
-  void System::finish_task(Task* task)
+  void System::finish_task(TaskID task_id)
   {
+    Task* task = get_task_ptr(task_id);
+
     // NOTE(kevinyu): make sure _isCompleteTask() return true only after the task truly finish.
     // Without std::memory_order_release, this operation can be reorder before the task is executed.
-    const auto unfinished_count = task->unfinished_count.fetch_sub(1, std::memory_order_release);
+    // The acquire part make the children work visible to the continuations that we schedule below.
+    const auto unfinished_count = task->unfinished_count.fetch_sub(1, std::memory_order_acq_rel);
 
     if (unfinished_count == 1)
     {
@@ -249,28 +942,94 @@ namespace soul::runtime
       }
       db_.wait_cond_var.notify_all();
 
-      if (task != get_task_ptr(TaskID::NULLVAL()))
+      if (!task_id.is_root())
       {
-        finish_task(get_task_ptr(task->parent_id));
+        run_continuations(task_id);
+        finish_task(task->parent_id);
       }
     }
   }
 
+  void System::run_continuations(TaskID task_id)
+  {
+    TaskContinuation* continuation = get_task_continuation_head(task_id).exchange(
+      &db_.closed_continuation, std::memory_order_acq_rel);
+    while (continuation != nullptr)
+    {
+      // NOTE(kevinyu): Read next before scheduling, the continuation task may run immediately.
+      TaskContinuation* next = continuation->next;
+      Task* task             = get_task_ptr(continuation->task_id);
+      if (task->dependency_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        schedule_task(continuation->task_id);
+      }
+      continuation = next;
+    }
+  }
+
   void System::shutdown()
   {
     SOUL_ASSERT_MAIN_THREAD();
 
     SOUL_ASSERT_FORMAT(
       0,
-      db_.active_task_count == 0,
+      db_.active_task_count.load(std::memory_order_relaxed) == 0,
       "There is still pending task in work deque! Active Task Count = {}.",
-      db_.active_task_count);
+      db_.active_task_count.load(std::memory_order_relaxed));
+
+    // NOTE(kevinyu): Ask the background tasks to stop, then let the workers drain the lane. Queued
+    // tasks still run, but see the cancel request as soon as they start.
+    db_.is_background_cancel_requested.store(true, std::memory_order_relaxed);
+    {
+      std::unique_lock<std::mutex> lock(db_.background_mutex);
+      db_.background_free_cond_var.wait(
+        lock,
+        [this]() -> b8
+        {
+          return db_.background_free_slot_count == Constant::MAX_BACKGROUND_TASK_COUNT;
+        });
+    }
     terminate();
     for (u64 i = 1; i < db_.thread_count; i++)
     {
       db_.threads[i].join();
     }
+    db_.threads.cleanup();
+    db_.steal_group_threads.cleanup();
+
+    for (auto& thread_context : db_.thread_contexts)
+    {
+      thread_context.task_deque.shutdown();
+      for (u32 page_index = 0; page_index < thread_context.task_page_count; page_index++)
+      {
+        db_.default_allocator->destroy(NotNull(thread_context.task_pages[page_index]));
+      }
+      for (TaskContinuationPage* continuation_page : thread_context.continuation_pages)
+      {
+        db_.default_allocator->destroy(NotNull(continuation_page));
+      }
+      for (byte* task_payload_page : thread_context.task_payload_pages)
+      {
+        db_.default_allocator->deallocate(task_payload_page);
+      }
+    }
+    for (auto& thread_context : db_.thread_contexts)
+    {
+      for (CoroutineFrame* frame : thread_context.coroutine_frame_free_lists)
+      {
+        while (frame != nullptr)
+        {
+          CoroutineFrame* next = frame->next;
+          db_.default_allocator->deallocate(frame);
+          frame = next;
+        }
+      }
+    }
     db_.thread_contexts.cleanup();
+
+    db_.background_tasks.cleanup();
+    db_.background_free_slots.cleanup();
+    db_.background_queue.cleanup();
   }
 
   auto System::get_thread_count() const -> u16
@@ -322,7 +1081,220 @@ namespace soul::runtime
   auto System::get_temp_allocator() -> TempAllocator*
   {
     SOUL_ASSERT(0, get_thread_context().temp_allocator != nullptr);
+    SOUL_ASSERT(
+      0,
+      !get_thread_context().is_running_background_task,
+      "Temp allocator is reset every frame, background task cannot use it");
     return get_thread_context().temp_allocator;
   }
 
+  auto System::get_frame_ring_allocator() -> memory::FrameRingAllocator*
+  {
+    SOUL_ASSERT(0, db_.frame_ring_allocator != nullptr);
+    SOUL_ASSERT(
+      0,
+      !get_thread_context().is_running_background_task,
+      "Frame ring allocator is advanced in begin_frame, background task cannot use it");
+    return db_.frame_ring_allocator;
+  }
+
+  auto System::get_worker_stats(u16 thread_index) const -> WorkerStats
+  {
+    SOUL_ASSERT_MAIN_THREAD();
+    return db_.thread_contexts[thread_index].last_frame_stats;
+  }
+
+  auto System::get_chrome_trace(memory::Allocator* allocator) const -> String
+  {
+    SOUL_ASSERT_MAIN_THREAD();
+    static constexpr auto TRACE_EVENT_NAMES =
+      FlagMap<TraceEventType, const char*>::FromValues({"Task", "Wait Task"});
+
+    String result(allocator);
+    result.appendf("{{\"traceEvents\":[");
+    b8 is_first_event = true;
+    for (const auto& thread_context : db_.thread_contexts)
+    {
+      result.appendf(
+        "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},"
+        "\"args\":{{\"name\":\"{} Thread = {}\"}}}}",
+        is_first_event ? "" : ",",
+        thread_context.thread_index,
+        thread_context.thread_index == 0 ? "Main" : "Worker",
+        thread_context.thread_index);
+      is_first_event = false;
+
+      // NOTE(kevinyu): Chrome trace timestamp is in microsecond, relative to the frame begin
+      for (const TraceEvent& event : thread_context.last_frame_trace_events)
+      {
+        const auto ts_us =
+          static_cast<f64>(static_cast<i64>(event.begin_ns - db_.last_frame_begin_ns)) / 1000.0;
+        const auto dur_us = static_cast<f64>(event.end_ns - event.begin_ns) / 1000.0;
+        result.appendf(
+          ",{{\"name\":\"{}\",\"cat\":\"runtime\",\"ph\":\"X\",\"pid\":0,\"tid\":{},"
+          "\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"task_id\":{}}}}}",
+          TRACE_EVENT_NAMES[event.type],
+          thread_context.thread_index,
+          ts_us,
+          dur_us,
+          event.task_id.id);
+      }
+    }
+    result.appendf("]}}");
+    return result;
+  }
+
+  auto System::allocate_coroutine_frame(usize size) -> void*
+  {
+    SOUL_ASSERT(0, db_.default_allocator != nullptr, "Runtime is not initialized");
+    const u32 size_class = get_coroutine_frame_size_class(size);
+    if (size_class >= Constant::COROUTINE_FRAME_SIZE_CLASS_COUNT)
+    {
+      return db_.default_allocator->allocate(size, alignof(std::max_align_t));
+    }
+
+    ThreadContext* thread_context = Database::g_thread_context;
+    if (thread_context != nullptr)
+    {
+      CoroutineFrame*& free_list = thread_context->coroutine_frame_free_lists[size_class];
+      if (free_list != nullptr)
+      {
+        CoroutineFrame* frame = free_list;
+        free_list             = frame->next;
+        thread_context->coroutine_frame_free_counts[size_class]--;
+        return frame;
+      }
+    }
+
+    const usize frame_size = usize(1) << (size_class + Constant::COROUTINE_FRAME_MIN_SIZE_SHIFT);
+    return db_.default_allocator->allocate(frame_size, alignof(std::max_align_t));
+  }
+
+  void System::deallocate_coroutine_frame(void* addr, usize size)
+  {
+    const u32 size_class          = get_coroutine_frame_size_class(size);
+    ThreadContext* thread_context = Database::g_thread_context;
+    if (
+      size_class < Constant::COROUTINE_FRAME_SIZE_CLASS_COUNT && thread_context != nullptr &&
+      thread_context->coroutine_frame_free_counts[size_class] <
+        Constant::MAX_CACHED_COROUTINE_FRAME_PER_SIZE_CLASS)
+    {
+      CoroutineFrame*& free_list = thread_context->coroutine_frame_free_lists[size_class];
+      free_list                  = new (addr) CoroutineFrame{free_list};
+      thread_context->coroutine_frame_free_counts[size_class]++;
+      return;
+    }
+    db_.default_allocator->deallocate(addr);
+  }
+
+  void System::set_frame_allocation_budget(u32 budget)
+  {
+    SOUL_ASSERT_MAIN_THREAD();
+    db_.frame_allocation_budget.store(budget, std::memory_order_relaxed);
+  }
+
+  auto System::get_last_frame_allocation_count() const -> u32
+  {
+    SOUL_ASSERT_MAIN_THREAD();
+    return db_.last_frame_allocation_count;
+  }
+
+  void System::on_frame_allocation(StringView allocator_name, StringView tag, usize size)
+  {
+    const u32 budget = db_.frame_allocation_budget.load(std::memory_order_relaxed);
+    if (budget == FRAME_ALLOCATION_BUDGET_DISABLED)
+    {
+      return;
+    }
+    const u32 allocation_index = db_.frame_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (
+      allocation_index < budget ||
+      allocation_index - budget >= Constant::MAX_FRAME_ALLOCATION_VIOLATION_COUNT)
+    {
+      return;
+    }
+
+    const ThreadContext* thread_context = Database::g_thread_context;
+
+    FrameAllocationViolation violation = {
+      .allocator_name = allocator_name,
+      .tag            = tag,
+      .size           = size,
+      .thread_index   = thread_context != nullptr ? thread_context->thread_index : u16(~0),
+    };
+    // NOTE(kevinyu): Skip this function and the proxy hook, the stack is captured outside of the
+    // lock since it is the slow part.
+    violation.call_stack_depth = impl::capture_call_stack(
+      violation.call_stack, Constant::MAX_FRAME_ALLOCATION_CALL_STACK_DEPTH, 2);
+
+    std::lock_guard guard(db_.frame_allocation_violation_mutex);
+    if (db_.frame_allocation_violation_count < Constant::MAX_FRAME_ALLOCATION_VIOLATION_COUNT)
+    {
+      db_.frame_allocation_violations[db_.frame_allocation_violation_count] = violation;
+      db_.frame_allocation_violation_count++;
+    }
+  }
+
+  void System::check_frame_allocation_budget()
+  {
+    const u32 allocation_count = db_.frame_allocation_count.load(std::memory_order_relaxed);
+    const u32 budget           = db_.frame_allocation_budget.load(std::memory_order_relaxed);
+    if (budget != FRAME_ALLOCATION_BUDGET_DISABLED && allocation_count > budget)
+    {
+      SOUL_LOG_WARN(
+        "Frame {} make {} allocation(s), over the frame allocation budget of {}",
+        db_.frame_index,
+        allocation_count,
+        budget);
+      for (u32 violation_index = 0; violation_index < db_.frame_allocation_violation_count;
+           violation_index++)
+      {
+        const FrameAllocationViolation& violation =
+          db_.frame_allocation_violations[violation_index];
+        char call_stack[Constant::MAX_FRAME_ALLOCATION_CALL_STACK_DEPTH * 20] = {};
+        usize call_stack_length                                               = 0;
+        for (u32 frame_index = 0; frame_index < violation.call_stack_depth; frame_index++)
+        {
+          call_stack_length += soul::cast<usize>(snprintf(
+            call_stack + call_stack_length,
+            sizeof(call_stack) - call_stack_length,
+            " %p",
+            violation.call_stack[frame_index]));
+        }
+        SOUL_LOG_WARN(
+          "  {} bytes, allocator = {}, tag = {}, thread = {}, call stack ={}",
+          violation.size,
+          std::string_view(violation.allocator_name.data(), violation.allocator_name.size()),
+          std::string_view(violation.tag.data(), violation.tag.size()),
+          violation.thread_index,
+          call_stack);
+      }
+      if (db_.panic_on_frame_allocation_budget)
+      {
+        // NOTE(kevinyu): Requested explicitly, so panic even when assertion is disabled.
+        soul::panic(__FILE__, __LINE__, __FUNCTION__, "Frame allocation budget is exceeded");
+      }
+    }
+
+    // NOTE(kevinyu): Reset after logging, so allocation made by the report itself is not counted
+    // in the new frame.
+    {
+      std::lock_guard guard(db_.frame_allocation_violation_mutex);
+      db_.frame_allocation_violation_count = 0;
+    }
+    db_.last_frame_allocation_count =
+      db_.frame_allocation_count.exchange(0, std::memory_order_relaxed);
+    db_.frame_index++;
+  }
+
+  void System::resume_on_next_frame(CoroutineResumeNode* node)
+  {
+    CoroutineResumeNode* head = db_.next_frame_resume_head.load(std::memory_order_relaxed);
+    do
+    {
+      node->next = head;
+    } while (!db_.next_frame_resume_head.compare_exchange_weak(
+      head, node, std::memory_order_release, std::memory_order_relaxed));
+  }
+
 } // namespace soul::runtime
@@ -4,9 +4,11 @@
 namespace soul::runtime
 {
 
-  void TaskDeque::init()
+  void TaskDeque::init(memory::Allocator* allocator)
   {
     SOUL_ASSERT_MAIN_THREAD();
+    _allocator = allocator;
+    _buffer.store(create_buffer(Constant::INITIAL_TASK_DEQUE_CAPACITY), std::memory_order_relaxed);
     _bottom.store(0, std::memory_order_relaxed);
     _top.store(0, std::memory_order_relaxed);
   }
@@ -14,6 +16,15 @@ namespace soul::runtime
   void TaskDeque::shutdown()
   {
     SOUL_ASSERT_MAIN_THREAD();
+    Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+    while (buffer != nullptr)
+    {
+      Buffer* retired = buffer->retired;
+      _allocator->deallocate_array(buffer->tasks, buffer->capacity);
+      _allocator->destroy(NotNull(buffer));
+      buffer = retired;
+    }
+    _buffer.store(nullptr, std::memory_order_relaxed);
   }
 
   void TaskDeque::reset()
@@ -32,13 +43,14 @@ namespace soul::runtime
 
   void TaskDeque::push(TaskID task)
   {
-    auto bottom = _bottom.load(std::memory_order_relaxed);
-    SOUL_ASSERT(
-      0,
-      bottom < Constant::MAX_TASK_PER_THREAD,
-      "Number of task exceed capacity."
-      "You can configure capacity in Runtime::Constant::MAX_TASK_PER_THREAD.");
-    _tasks[bottom] = task;
+    auto bottom    = _bottom.load(std::memory_order_relaxed);
+    auto top       = _top.load(std::memory_order_acquire);
+    Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+    if (bottom - top >= buffer->capacity)
+    {
+      buffer = grow(buffer, bottom, top);
+    }
+    buffer->put(bottom, task);
 
     // NOTE(kevinyu): make sure steal() can see the item that is push to the deque
     _bottom.store(bottom + 1, std::memory_order_release);
@@ -57,9 +69,10 @@ namespace soul::runtime
       return TaskID::NULLVAL();
     }
 
+    const Buffer* buffer = _buffer.load(std::memory_order_relaxed);
     if (bottom > top)
     {
-      return _tasks[bottom];
+      return buffer->get(bottom);
     }
 
     // NOTE(kevinyu): bottom == top. last element case. pretend to steal
@@ -68,7 +81,7 @@ namespace soul::runtime
           top, top + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
     {
       top += 1;
-      task = _tasks[bottom];
+      task = buffer->get(bottom);
     }
 
     _bottom.store(top, std::memory_order_relaxed);
@@ -89,7 +102,9 @@ namespace soul::runtime
       return TaskID::NULLVAL();
     }
 
-    const TaskID task = _tasks[top];
+    // NOTE(kevinyu): Even if the buffer has been replaced after we load it, the item at top is
+    // still valid in the old buffer since grow() copy [top, bottom) and never free the old buffer.
+    const TaskID task = _buffer.load(std::memory_order_acquire)->get(top);
     if (_top.compare_exchange_strong(
           top, top + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
     {
@@ -99,4 +114,29 @@ namespace soul::runtime
     return TaskID::NULLVAL();
   }
 
+  auto TaskDeque::create_buffer(i32 capacity) -> Buffer*
+  {
+    SOUL_ASSERT(0, (capacity & (capacity - 1)) == 0, "Capacity must be power of two");
+    Buffer* buffer   = _allocator->create<Buffer>().unwrap();
+    buffer->tasks    = _allocator->allocate_array<TaskID>(capacity);
+    buffer->capacity = capacity;
+    return buffer;
+  }
+
+  auto TaskDeque::grow(Buffer* buffer, i32 bottom, i32 top) -> Buffer*
+  {
+    SOUL_ASSERT(
+      0,
+      buffer->capacity <= std::numeric_limits<i32>::max() / 2,
+      "Number of task in the deque exceed capacity.");
+    Buffer* new_buffer = create_buffer(buffer->capacity * 2);
+    for (i32 index = top; index < bottom; index++)
+    {
+      new_buffer->put(index, buffer->get(index));
+    }
+    new_buffer->retired = buffer;
+    _buffer.store(new_buffer, std::memory_order_release);
+    return new_buffer;
+  }
+
 } // namespace soul::runtime
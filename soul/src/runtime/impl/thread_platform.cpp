@@ -0,0 +1,173 @@
+#include <algorithm>
+
+#include "runtime/impl/thread_platform.h"
+
+#if defined(SOUL_OS_WINDOWS)
+#  include <Windows.h>
+#else
+#  include <pthread.h>
+#  include <cstdio>
+#endif
+
+#if defined(__linux__)
+#  include <sched.h>
+#endif
+
+#if defined(__linux__) || defined(__APPLE__)
+#  include <execinfo.h>
+#endif
+
+namespace soul::runtime::impl
+{
+  namespace
+  {
+    // NOTE(kevinyu): Remap raw platform id (cache id, package id, mask index) to dense group index
+    // in the order of first appearance.
+    void make_dense_groups(Vector<u16>* groups)
+    {
+      Vector<u16> seen_ids;
+      for (u16& group : *groups)
+      {
+        const u16 raw_id = group;
+        usize index      = 0;
+        while (index < seen_ids.size() && seen_ids[index] != raw_id)
+        {
+          index++;
+        }
+        if (index == seen_ids.size())
+        {
+          seen_ids.push_back(raw_id);
+        }
+        group = soul::cast<u16>(index);
+      }
+    }
+
+#if defined(__linux__)
+    auto read_sysfs_u32(const char* path, u32* value) -> b8
+    {
+      FILE* file = fopen(path, "r");
+      if (file == nullptr)
+      {
+        return false;
+      }
+      const b8 success = fscanf(file, "%u", value) == 1;
+      fclose(file);
+      return success;
+    }
+#endif
+  } // namespace
+
+  auto get_core_cache_groups(usize core_count, memory::Allocator* allocator) -> Vector<u16>
+  {
+    auto groups = Vector<u16>::FillN(core_count, 0, *allocator);
+
+#if defined(__linux__)
+    for (usize core_index = 0; core_index < core_count; core_index++)
+    {
+      char path[128];
+      u32 id = 0;
+      snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/cache/index3/id", core_index);
+      if (!read_sysfs_u32(path, &id))
+      {
+        snprintf(
+          path,
+          sizeof(path),
+          "/sys/devices/system/cpu/cpu%zu/topology/physical_package_id",
+          core_index);
+        read_sysfs_u32(path, &id);
+      }
+      groups[core_index] = soul::cast<u16>(id);
+    }
+#elif defined(SOUL_OS_WINDOWS)
+    DWORD buffer_size = 0;
+    GetLogicalProcessorInformation(nullptr, &buffer_size);
+    const usize info_count = buffer_size / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+    auto infos = Vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION>::WithSize(info_count, *allocator);
+    if (info_count != 0 && GetLogicalProcessorInformation(infos.data(), &buffer_size))
+    {
+      u16 cache_index = 0;
+      for (const auto& info : infos)
+      {
+        if (info.Relationship != RelationCache || info.Cache.Level != 3)
+        {
+          continue;
+        }
+        for (usize core_index = 0; core_index < core_count && core_index < 64; core_index++)
+        {
+          if ((info.ProcessorMask & (ULONG_PTR(1) << core_index)) != 0)
+          {
+            groups[core_index] = cache_index;
+          }
+        }
+        cache_index++;
+      }
+    }
+#endif
+
+    make_dense_groups(&groups);
+    return groups;
+  }
+
+  auto set_current_thread_affinity(usize core_index) -> b8
+  {
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core_index, &cpu_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#elif defined(SOUL_OS_WINDOWS)
+    if (core_index >= 64)
+    {
+      return false;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core_index) != 0;
+#else
+    // NOTE(kevinyu): macOS only support affinity hint through thread_policy_set, and it is ignored
+    // on Apple silicon.
+    return false;
+#endif
+  }
+
+  void set_current_thread_name(const char* name)
+  {
+#if defined(__linux__)
+    char truncated_name[16] = {};
+    snprintf(truncated_name, sizeof(truncated_name), "%s", name);
+    pthread_setname_np(pthread_self(), truncated_name);
+#elif defined(SOUL_OS_WINDOWS)
+    wchar_t wide_name[64] = {};
+    for (usize i = 0; i < 63 && name[i] != '\0'; i++)
+    {
+      wide_name[i] = static_cast<wchar_t>(name[i]);
+    }
+    SetThreadDescription(GetCurrentThread(), wide_name);
+#else
+    pthread_setname_np(name);
+#endif
+  }
+
+  auto capture_call_stack(void** frames, u32 max_count, u32 skip_count) -> u32
+  {
+#if defined(SOUL_OS_WINDOWS)
+    // NOTE(kevinyu): Skip this function too, so the first frame is the caller.
+    return CaptureStackBackTrace(skip_count + 1, max_count, frames, nullptr);
+#elif defined(__linux__) || defined(__APPLE__)
+    static constexpr u32 MAX_CALL_STACK_DEPTH = 64;
+    void* stack[MAX_CALL_STACK_DEPTH];
+    const u32 capture_count = std::min(max_count + skip_count + 1, MAX_CALL_STACK_DEPTH);
+    const auto depth        = soul::cast<u32>(backtrace(stack, soul::cast<i32>(capture_count)));
+    if (depth <= skip_count + 1)
+    {
+      return 0;
+    }
+    const u32 frame_count = std::min(depth - skip_count - 1, max_count);
+    for (u32 frame_index = 0; frame_index < frame_count; frame_index++)
+    {
+      frames[frame_index] = stack[skip_count + 1 + frame_index];
+    }
+    return frame_count;
+#else
+    return 0;
+#endif
+  }
+} // namespace soul::runtime::impl
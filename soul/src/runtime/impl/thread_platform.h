@@ -0,0 +1,23 @@
+#pragma once
+
+#include "core/type.h"
+#include "core/vector.h"
+
+namespace soul::runtime::impl
+{
+  /*
+    Return the cache group of every logical core, indexed by core index. Cores in the same group
+    share a last level cache (L3) when the platform expose it, or the same package otherwise.
+    Group index is dense and start from zero.
+  */
+  auto get_core_cache_groups(usize core_count, memory::Allocator* allocator) -> Vector<u16>;
+
+  // return false when the platform does not support hard affinity
+  auto set_current_thread_affinity(usize core_index) -> b8;
+
+  // name is truncated to 15 characters on Linux
+  void set_current_thread_name(const char* name);
+
+  // return the number of return address written to frames, 0 when the platform does not support it
+  auto capture_call_stack(void** frames, u32 max_count, u32 skip_count) -> u32;
+} // namespace soul::runtime::impl
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <iterator>
+
+#include "core/aosoa_vector.h"
+#include "core/objops.h"
+#include "core/span.h"
+#include "core/type_traits.h"
+#include "core/vector.h"
+#include "runtime/runtime.h"
+#include "runtime/scope_allocator.h"
+
+// NOTE(kevinyu): All the algorithm here block the calling thread until the work is done. The
+// calling thread help executing the subtasks while waiting (see System::wait_task()).
+namespace soul::runtime
+{
+  namespace impl
+  {
+    inline auto get_block_count(u32 count, u32 block_size) -> u32
+    {
+      return (count + block_size - 1) / block_size;
+    }
+
+    // NOTE(kevinyu): Stable merge of two sorted runs into uninitialized memory at dst.
+    template <typename T, typename CompareFn>
+    void merge_move_construct(
+      T* first1, T* last1, T* first2, T* last2, T* dst, CompareFn& compare_fn)
+    {
+      for (; first1 != last1 && first2 != last2; ++dst)
+      {
+        if (compare_fn(*first2, *first1))
+        {
+          construct_at(dst, std::move(*first2));
+          ++first2;
+        } else
+        {
+          construct_at(dst, std::move(*first1));
+          ++first1;
+        }
+      }
+      uninitialized_move_n(first1, soul::cast<usize>(last1 - first1), dst);
+      dst += last1 - first1;
+      uninitialized_move_n(first2, soul::cast<usize>(last2 - first2), dst);
+    }
+  } // namespace impl
+
+  template <typename T, ts_fn<T, u32> MapFn, ts_fn<T, T, T> ReduceFn>
+  auto parallel_reduce(
+    u32 count, u32 block_size, const T& identity, MapFn&& map_fn, ReduceFn&& reduce_fn) -> T
+  {
+    SOUL_ASSERT(0, block_size != 0, "Block size cannot be zero");
+    if (count == 0)
+    {
+      return identity;
+    }
+
+    ScopeAllocator scope_allocator("runtime::parallel_reduce"_str);
+    const u32 block_count = impl::get_block_count(count, block_size);
+    auto partials         = Vector<T>::WithSize(block_count, scope_allocator);
+
+    struct Context
+    {
+      u32 count;
+      u32 block_size;
+      const T& identity;
+      MapFn& map_fn;
+      ReduceFn& reduce_fn;
+      T* partials;
+    };
+    const Context context = {count, block_size, identity, map_fn, reduce_fn, partials.data()};
+
+    const TaskID task_id = parallel_for_task_create(
+      TaskID::ROOT(),
+      block_count,
+      1,
+      [&context](int block_index)
+      {
+        const u32 start = soul::cast<u32>(block_index) * context.block_size;
+        const u32 end   = std::min(start + context.block_size, context.count);
+        T partial       = context.identity;
+        for (u32 i = start; i < end; i++)
+        {
+          partial = context.reduce_fn(partial, context.map_fn(i));
+        }
+        context.partials[block_index] = partial;
+      });
+    run_and_wait_task(task_id);
+
+    // NOTE(kevinyu): Combine the partials in block order so the result is deterministic even for
+    // non associative floating point reduction.
+    T result = identity;
+    for (const T& partial : partials)
+    {
+      result = reduce_fn(result, partial);
+    }
+    return result;
+  }
+
+  // NOTE(kevinyu): Every chunk is processed by exactly one task, so fn can write to the chunk
+  // columns without synchronization. fn must not push or remove elements.
+  template <typename TupleT, usize ChunkSizeV, typename AllocatorT, typename Fn>
+    requires(ts_fn<Fn, void, typename AosoaVector<TupleT, ChunkSizeV, AllocatorT>::Chunk>)
+  void parallel_for_each(AosoaVector<TupleT, ChunkSizeV, AllocatorT>& vector, Fn fn)
+  {
+    if (vector.empty())
+    {
+      return;
+    }
+
+    const TaskID task_id = parallel_for_task_create(
+      TaskID::ROOT(),
+      soul::cast<u32>(vector.chunk_count()),
+      1,
+      [&vector, &fn](int chunk_index)
+      {
+        fn(vector.chunk_ref(soul::cast<usize>(chunk_index)));
+      });
+    run_and_wait_task(task_id);
+  }
+
+  template <typename TupleT, usize ChunkSizeV, typename AllocatorT, typename Fn>
+    requires(ts_fn<Fn, void, typename AosoaVector<TupleT, ChunkSizeV, AllocatorT>::ConstChunk>)
+  void parallel_for_each(const AosoaVector<TupleT, ChunkSizeV, AllocatorT>& vector, Fn fn)
+  {
+    if (vector.empty())
+    {
+      return;
+    }
+
+    const TaskID task_id = parallel_for_task_create(
+      TaskID::ROOT(),
+      soul::cast<u32>(vector.chunk_count()),
+      1,
+      [&vector, &fn](int chunk_index)
+      {
+        fn(vector.chunk_ref(soul::cast<usize>(chunk_index)));
+      });
+    run_and_wait_task(task_id);
+  }
+
+  // NOTE(kevinyu): input and output can point to the same memory.
+  template <typename T, ts_fn<T, T, T> ReduceFn>
+  void parallel_inclusive_scan(
+    Span<const T*> input,
+    Span<T*> output,
+    u32 block_size,
+    const T& identity,
+    ReduceFn&& reduce_fn)
+  {
+    SOUL_ASSERT(0, block_size != 0, "Block size cannot be zero");
+    SOUL_ASSERT(0, input.size() == output.size());
+    const u32 count = soul::cast<u32>(input.size());
+    if (count == 0)
+    {
+      return;
+    }
+
+    ScopeAllocator scope_allocator("runtime::parallel_inclusive_scan"_str);
+    const u32 block_count = impl::get_block_count(count, block_size);
+    auto block_offsets    = Vector<T>::WithSize(block_count, scope_allocator);
+
+    struct Context
+    {
+      u32 count;
+      u32 block_size;
+      const T* input;
+      T* output;
+      ReduceFn& reduce_fn;
+      T* block_offsets;
+    };
+    const Context context = {
+      count, block_size, input.data(), output.data(), reduce_fn, block_offsets.data()};
+
+    // NOTE(kevinyu): Pass 1, reduce every block
+    const TaskID reduce_task_id = parallel_for_task_create(
+      TaskID::ROOT(),
+      block_count,
+      1,
+      [&context](int block_index)
+      {
+        const u32 start = soul::cast<u32>(block_index) * context.block_size;
+        const u32 end   = std::min(start + context.block_size, context.count);
+        T sum           = context.input[start];
+        for (u32 i = start + 1; i < end; i++)
+        {
+          sum = context.reduce_fn(sum, context.input[i]);
+        }
+        context.block_offsets[block_index] = sum;
+      });
+    run_and_wait_task(reduce_task_id);
+
+    // NOTE(kevinyu): Pass 2, exclusive scan of the block sums. block count is small, do it serially
+    T running = identity;
+    for (u32 block_index = 0; block_index < block_count; block_index++)
+    {
+      const T block_sum          = block_offsets[block_index];
+      block_offsets[block_index] = running;
+      running                    = reduce_fn(running, block_sum);
+    }
+
+    // NOTE(kevinyu): Pass 3, scan every block starting from its offset
+    const TaskID scan_task_id = parallel_for_task_create(
+      TaskID::ROOT(),
+      block_count,
+      1,
+      [&context](int block_index)
+      {
+        const u32 start = soul::cast<u32>(block_index) * context.block_size;
+        const u32 end   = std::min(start + context.block_size, context.count);
+        T sum           = context.block_offsets[block_index];
+        for (u32 i = start; i < end; i++)
+        {
+          sum               = context.reduce_fn(sum, context.input[i]);
+          context.output[i] = sum;
+        }
+      });
+    run_and_wait_task(scan_task_id);
+  }
+
+  // NOTE(kevinyu): Stable bottom up merge sort. Each block is sorted in parallel, then the sorted
+  // runs are merged pairwise in parallel, ping-ponging between data and a scratch buffer. The
+  // scratch buffer is left uninitialized until the first merge pass move construct into it, so T
+  // only need to be move constructible and move assignable.
+  template <typename T, typename CompareFn = std::less<>>
+    requires(std::move_constructible<T> && std::is_move_assignable_v<T>)
+  void parallel_sort(Span<T*> data, u32 block_size, CompareFn compare_fn = CompareFn())
+  {
+    SOUL_ASSERT(0, block_size != 0, "Block size cannot be zero");
+    const u32 count = soul::cast<u32>(data.size());
+    if (count <= 1)
+    {
+      return;
+    }
+
+    ScopeAllocator scope_allocator("runtime::parallel_sort"_str);
+    T* scratch = scope_allocator.allocate_array<T>(count, "runtime::parallel_sort"_str);
+
+    struct Context
+    {
+      u32 count;
+      u32 width;
+      T* src;
+      T* dst;
+      CompareFn& compare_fn;
+    };
+    Context context = {count, block_size, data.data(), scratch, compare_fn};
+
+    const TaskID sort_task_id = parallel_for_task_create(
+      TaskID::ROOT(),
+      impl::get_block_count(count, block_size),
+      1,
+      [&context](int block_index)
+      {
+        const u32 start = soul::cast<u32>(block_index) * context.width;
+        const u32 end   = std::min(start + context.width, context.count);
+        std::stable_sort(context.src + start, context.src + end, context.compare_fn);
+      });
+    run_and_wait_task(sort_task_id);
+
+    // NOTE(kevinyu): Every merge pass write the whole [0, count) range of dst, so scratch is fully
+    // constructed after the first pass.
+    const b8 is_scratch_constructed = context.width < count;
+    b8 is_first_pass                = true;
+    while (context.width < count)
+    {
+      const u32 merge_count      = impl::get_block_count(count, 2 * context.width);
+      const TaskID merge_task_id = parallel_for_task_create(
+        TaskID::ROOT(),
+        merge_count,
+        1,
+        [&context, is_first_pass](int merge_index)
+        {
+          const u32 start = soul::cast<u32>(merge_index) * 2 * context.width;
+          const u32 mid   = std::min(start + context.width, context.count);
+          const u32 end   = std::min(start + 2 * context.width, context.count);
+          if (is_first_pass)
+          {
+            impl::merge_move_construct(
+              context.src + start,
+              context.src + mid,
+              context.src + mid,
+              context.src + end,
+              context.dst + start,
+              context.compare_fn);
+            return;
+          }
+          std::merge(
+            std::make_move_iterator(context.src + start),
+            std::make_move_iterator(context.src + mid),
+            std::make_move_iterator(context.src + mid),
+            std::make_move_iterator(context.src + end),
+            context.dst + start,
+            context.compare_fn);
+        });
+      run_and_wait_task(merge_task_id);
+      std::swap(context.src, context.dst);
+      context.width *= 2;
+      is_first_pass = false;
+    }
+
+    if (context.src != data.data())
+    {
+      const TaskID copy_task_id = parallel_for_task_create(
+        TaskID::ROOT(),
+        impl::get_block_count(count, block_size),
+        1,
+        [&context, block_size](int block_index)
+        {
+          const u32 start = soul::cast<u32>(block_index) * block_size;
+          const u32 end   = std::min(start + block_size, context.count);
+          std::move(context.src + start, context.src + end, context.dst + start);
+        });
+      run_and_wait_task(copy_task_id);
+    }
+
+    if (is_scratch_constructed)
+    {
+      destroy_n(scratch, count);
+    }
+    scope_allocator.deallocate_array(scratch, count);
+  }
+
+} // namespace soul::runtime
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <initializer_list>
+
 #include "core/type_traits.h"
 #include "runtime/data.h"
 #include "runtime/system.h"
@@ -33,6 +35,23 @@ namespace soul::runtime
     return System::get().create_task(parent, std::forward<Execute>(lambda));
   }
 
+  template <execution Execute>
+  auto create_task(
+    const TaskID parent, std::initializer_list<TaskID> dependencies, Execute&& lambda) -> TaskID
+  {
+    const TaskID task_id = System::get().create_task(parent, std::forward<Execute>(lambda));
+    for (const TaskID dependency : dependencies)
+    {
+      System::get().add_task_dependency(task_id, dependency);
+    }
+    return task_id;
+  }
+
+  inline void add_task_dependency(TaskID taskID, TaskID dependencyID)
+  {
+    System::get().add_task_dependency(taskID, dependencyID);
+  }
+
   inline void wait_task(TaskID taskID)
   {
     System::get().wait_task(taskID);
@@ -57,8 +76,48 @@ namespace soul::runtime
     return taskID;
   }
 
+  template <execution Execute>
+  auto create_and_run_task(
+    TaskID parent, std::initializer_list<TaskID> dependencies, Execute&& lambda) -> TaskID
+  {
+    const TaskID taskID = create_task(parent, dependencies, std::forward<Execute>(lambda));
+    run_task(taskID);
+    return taskID;
+  }
+
+  template <background_execution Execute>
+  auto create_background_task(Execute&& lambda) -> BackgroundTaskID
+  {
+    return System::get().create_background_task(std::forward<Execute>(lambda));
+  }
+
+  inline auto is_background_task_complete(BackgroundTaskID taskID) -> b8
+  {
+    return System::get().is_background_task_complete(taskID);
+  }
+
+  inline void wait_background_task(BackgroundTaskID taskID)
+  {
+    System::get().wait_background_task(taskID);
+  }
+
+  inline auto is_background_cancel_requested() -> b8
+  {
+    return System::get().is_background_cancel_requested();
+  }
+
   template <ts_fn<void, int> Fn>
   auto parallel_for_task_create(TaskID parent, u32 count, u32 blockSize, Fn&& func) -> TaskID
+  {
+    return System::get().create_parallel_for_task_adaptive(
+      parent, 0, count, blockSize, std::forward<Fn>(func));
+  }
+
+  // NOTE(kevinyu): Split the whole range eagerly in halves down to blockSize. Prefer
+  // parallel_for_task_create(), this is kept as baseline for the adaptive version.
+  template <ts_fn<void, int> Fn>
+  auto parallel_for_task_create_fixed_grain(TaskID parent, u32 count, u32 blockSize, Fn&& func)
+    -> TaskID
   {
     return System::get().create_parallel_for_task_recursive(
       parent, 0, count, blockSize, std::forward<Fn>(func));
@@ -94,6 +153,11 @@ namespace soul::runtime
     return System::get().get_temp_allocator();
   }
 
+  inline auto get_frame_ring_allocator() -> memory::FrameRingAllocator*
+  {
+    return System::get().get_frame_ring_allocator();
+  }
+
   inline auto allocate(u32 size, u32 alignment) -> void*
   {
     return System::get().allocate(size, alignment);
@@ -109,6 +173,26 @@ namespace soul::runtime
     return System::get().deallocate(addr, size);
   }
 
+  inline auto get_worker_stats(u16 thread_index) -> WorkerStats
+  {
+    return System::get().get_worker_stats(thread_index);
+  }
+
+  inline void set_frame_allocation_budget(u32 budget)
+  {
+    System::get().set_frame_allocation_budget(budget);
+  }
+
+  inline auto get_last_frame_allocation_count() -> u32
+  {
+    return System::get().get_last_frame_allocation_count();
+  }
+
+  inline auto get_chrome_trace(memory::Allocator* allocator = get_default_allocator()) -> String
+  {
+    return System::get().get_chrome_trace(allocator);
+  }
+
   struct AllocatorInitializer
   {
     AllocatorInitializer() = delete;
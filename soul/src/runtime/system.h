@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/string.h"
 #include "core/type.h"
 #include "core/type_traits.h"
 #include "runtime/data.h"
@@ -43,22 +44,17 @@ namespace soul::runtime
     template <execution Execute>
     auto create_task(TaskID parent, Execute&& lambda) -> TaskID
     {
-      static_assert(
-        sizeof lambda <= sizeof(Task::storage),
-        "Lambda size is too big."
-        "Consider increase the storage size of the"
-        "task or dynamically allocate the memory.");
+      using Closure = std::decay_t<Execute>;
 
       auto call = [](TaskID taskID, void* data)
       {
-        Execute& lambda = *static_cast<Execute*>(data);
+        Closure& lambda = get_task_data<Closure>(data);
         lambda(taskID);
-        lambda.~Execute();
+        lambda.~Closure();
       };
 
       const TaskID task_id = create_task(parent, call);
-      Task* task           = get_task_ptr(task_id);
-      new (task->storage) Execute(std::forward<Execute>(lambda));
+      emplace_task_data<Closure>(get_task_ptr(task_id), std::forward<Execute>(lambda));
       return task_id;
     }
 
@@ -68,14 +64,9 @@ namespace soul::runtime
     {
       using TaskData = ParallelForTaskData<Func>;
 
-      static_assert(
-        sizeof(TaskData) <= sizeof(Task::storage),
-        "ParallelForTaskData size is too big. TaskData = %d"
-        "Consider to increase the storage size of the task.");
-
       auto parallel_func = [](TaskID taskID, void* data)
       {
-        TaskData& task_data = (*static_cast<TaskData*>(data));
+        TaskData& task_data = get_task_data<TaskData>(data);
         if (task_data.count > task_data.min_count)
         {
           const u32 left_count      = task_data.count / 2;
@@ -97,20 +88,102 @@ namespace soul::runtime
       };
 
       const TaskID task_id = create_task(parent, std::move(parallel_func));
-      Task* task           = get_task_ptr(task_id);
-      new (task->storage) TaskData(start, data_count, block_size, std::forward<Func>(func));
+      emplace_task_data<TaskData>(
+        get_task_ptr(task_id), start, data_count, block_size, std::forward<Func>(func));
+      return task_id;
+    }
+
+    /*
+      Lazy binary splitting. Instead of splitting the whole range up front, the task process
+      block_size element at a time and only split half of the remaining range into a new task
+      when its deque is empty, i.e. when any thief would find nothing to steal.
+    */
+    template <typename Func>
+    auto create_parallel_for_task_adaptive(
+      TaskID parent, u32 start, u32 data_count, u32 block_size, Func&& func) -> TaskID
+    {
+      using TaskData = ParallelForTaskData<Func>;
+
+      auto parallel_func = [](TaskID taskID, void* data)
+      {
+        TaskData& task_data = get_task_data<TaskData>(data);
+        u32 begin           = task_data.start;
+        u32 end             = task_data.start + task_data.count;
+        while (begin < end)
+        {
+          if (end - begin > task_data.min_count && get().is_local_deque_empty())
+          {
+            const u32 mid              = begin + (end - begin) / 2;
+            const TaskID right_task_id = get().create_parallel_for_task_adaptive(
+              taskID, mid, end - mid, task_data.min_count, task_data.func);
+            get().task_run(right_task_id);
+            end = mid;
+            continue;
+          }
+
+          const u32 block_end = begin + std::min(task_data.min_count, end - begin);
+          for (u32 i = begin; i < block_end; i++)
+          {
+            task_data.func(i);
+          }
+          begin = block_end;
+        }
+      };
+
+      SOUL_ASSERT(0, block_size != 0, "Block size cannot be zero");
+      const TaskID task_id = create_task(parent, std::move(parallel_func));
+      emplace_task_data<TaskData>(
+        get_task_ptr(task_id), start, data_count, block_size, std::forward<Func>(func));
       return task_id;
     }
 
     template <ts_fn<void, int> Fn>
     auto create_parallel_for_task(TaskID parent, u32 count, u32 block_size, Fn&& func) -> TaskID
     {
-      return create_parallel_for_task_recursive(
+      return create_parallel_for_task_adaptive(
         parent, 0, count, block_size, std::forward<Fn>(func));
     }
 
+    /*
+      Make task_id wait for dependency_id (and all of its children) to finish before it is pushed
+      to a deque. Must be called before task_id is run.
+    */
+    void add_task_dependency(TaskID task_id, TaskID dependency_id);
+
     void wait_task(TaskID task_id);
 
+    auto is_task_complete(TaskID task_id) -> b8;
+
+    /*
+      Submit a long lived task to the background lane. Background task is not reset by
+      begin_frame(), and only run on worker threads when there is no frame task left. Background
+      task cannot create frame task or use the temp allocator.
+    */
+    template <background_execution Execute>
+    auto create_background_task(Execute&& lambda) -> BackgroundTaskID
+    {
+      using Closure = std::decay_t<Execute>;
+
+      auto call = [](void* data)
+      {
+        auto* closure = static_cast<Closure*>(data);
+        (*closure)();
+        get().db_.default_allocator->destroy(NotNull(closure));
+      };
+
+      Closure* closure =
+        db_.default_allocator->create<Closure>(std::forward<Execute>(lambda)).unwrap();
+      return submit_background_task(call, closure);
+    }
+
+    auto is_background_task_complete(BackgroundTaskID task_id) const -> b8;
+
+    void wait_background_task(BackgroundTaskID task_id);
+
+    // NOTE(kevinyu): Set by shutdown(). Long background task should poll this and return early,
+    // shutdown() wait for every background task to finish.
+    auto is_background_cancel_requested() const -> b8;
+
     void task_run(TaskID task_id);
 
     auto get_thread_count() const -> u16;
@@ -138,25 +211,135 @@ namespace soul::runtime
 
     auto get_temp_allocator() -> TempAllocator*;
 
+    // allocation stay valid for the frame count of the allocator, not usable from background task
+    auto get_frame_ring_allocator() -> memory::FrameRingAllocator*;
+
+    /*
+      Coroutine frame is cached per thread by size class, so creating coroutine does not go to
+      the default allocator in steady state. Frame can be freed from any thread.
+    */
+    auto allocate_coroutine_frame(usize size) -> void*;
+
+    void deallocate_coroutine_frame(void* addr, usize size);
+
+    /*
+      Resume node->handle on the main thread in the next begin_frame(). Thread safe, node must stay
+      alive until it is resumed.
+    */
+    void resume_on_next_frame(CoroutineResumeNode* node);
+
     auto is_worker_thread() const -> b8;
 
+    /*
+      Scheduler statistic of the last finished frame. Only collected when the runtime is compiled
+      with SOUL_RUNTIME_STATS_ENABLE. Only call this from the main thread.
+    */
+    auto get_worker_stats(u16 thread_index) const -> WorkerStats;
+
+    /*
+      Timeline of the last finished frame in Chrome trace event JSON format. It can be loaded in
+      chrome://tracing or Perfetto. Only call this from the main thread.
+    */
+    auto get_chrome_trace(memory::Allocator* allocator = get_default_allocator()) const -> String;
+
+    /*
+      Maximum number of allocation counted by FrameAllocationProxy between two begin_frame().
+      Allocation over the budget is recorded with its tag and call stack and reported in the next
+      begin_frame(). Use FRAME_ALLOCATION_BUDGET_DISABLED to turn it off, e.g. while loading.
+      Only call this from the main thread.
+    */
+    void set_frame_allocation_budget(u32 budget);
+
+    // Number of counted allocation in the last finished frame. Only call this from the main thread.
+    auto get_last_frame_allocation_count() const -> u32;
+
+    // Called by FrameAllocationProxy from any thread.
+    void on_frame_allocation(StringView allocator_name, StringView tag, usize size);
+
   private:
+    // NOTE(kevinyu): Small task data live inline in Task::storage. Bigger one is placed in the
+    // thread's payload arena and Task::storage only keep the pointer to it.
+    template <typename T>
+    static constexpr b8 IS_TASK_DATA_INLINE =
+      sizeof(T) <= sizeof(Task::storage) && alignof(T) <= alignof(decltype(Task::storage));
+
+    template <typename T, typename... Args>
+    void emplace_task_data(Task* task, Args&&... args)
+    {
+      if constexpr (IS_TASK_DATA_INLINE<T>)
+      {
+        new (task->storage) T(std::forward<Args>(args)...);
+      } else
+      {
+        static_assert(
+          sizeof(T) <= Constant::TASK_PAYLOAD_PAGE_SIZE,
+          "Task data is bigger than the task payload page.");
+        static_assert(
+          alignof(T) <= SOUL_CACHELINE_SIZE, "Task data alignment is bigger than cache line size.");
+        void* payload = allocate_task_payload(sizeof(T), alignof(T));
+        new (payload) T(std::forward<Args>(args)...);
+        task->storage[0] = payload;
+      }
+    }
+
+    template <typename T>
+    static auto get_task_data(void* storage) -> T&
+    {
+      if constexpr (IS_TASK_DATA_INLINE<T>)
+      {
+        return *static_cast<T*>(storage);
+      } else
+      {
+        return *static_cast<T*>(*static_cast<void**>(storage));
+      }
+    }
+
+    auto allocate_task_payload(usize size, usize alignment) -> void*;
+
     auto create_task(TaskID parent, TaskFunc func) -> TaskID;
 
     auto get_task_ptr(TaskID task_id) -> Task*;
 
-    void finish_task(Task* task);
+    auto get_task_continuation_head(TaskID task_id) -> std::atomic<TaskContinuation*>&;
+
+    void schedule_task(TaskID task_id);
+
+    void finish_task(TaskID task_id);
+
+    void run_continuations(TaskID task_id);
+
+    auto submit_background_task(BackgroundTaskFunc func, void* data) -> BackgroundTaskID;
+
+    auto try_execute_background_task(ThreadContext* thread_context) -> b8;
+
+    auto has_pending_work() const -> b8;
 
     static auto is_task_complete(Task* task) -> b8;
 
+    auto is_descendant_task(TaskID task_id, TaskID ancestor_id) -> b8;
+
+    auto is_local_deque_empty() const -> b8;
+
+    auto steal_nested_task(TaskID wait_task_id) -> TaskID;
+
     void loop(ThreadContext* thread_context);
 
+    auto get_steal_victim(const ThreadContext* thread_context, u32 attempt) const -> usize;
+
+    void park(ThreadContext* thread_context);
+
+    void wake_one_worker();
+
     void execute(TaskID task);
 
     void terminate();
 
     void init_root_task();
 
+    void init_thread_topology(const Config& config);
+
+    void check_frame_allocation_budget();
+
     Database db_;
   };
 } // namespace soul::runtime
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "core/type.h"
+#include "memory/allocators/linear_allocator.h"
+#include "memory/allocators/page_allocator.h"
+#include "memory/allocators/proxy_allocator.h"
+#include "runtime/runtime.h"
+
+// NOTE(kevinyu): Init the runtime for the lifetime of the object with the same allocator setup as
+// app::AppRuntime. The allocator fields of config are filled in, the rest is passed as is.
+class TestRuntime
+{
+public:
+  explicit TestRuntime(soul::runtime::Config config = {})
+      : page_allocator_("Test page allocator"_str),
+#if defined(SOUL_THREAD_CACHING_DEFAULT_ALLOCATOR)
+        default_backing_allocator_("Test runtime default allocator"_str, &page_allocator_),
+#else
+        default_backing_allocator_("Test runtime default allocator"_str),
+#endif
+        default_allocator_(
+          &default_backing_allocator_,
+          soul::runtime::DefaultAllocatorProxy::Config(
+            soul::memory::ProfileProxy::Config(),
+            soul::runtime::FrameAllocationProxy::Config(),
+            soul::memory::CounterProxy::Config(),
+            soul::memory::ClearValuesProxy::Config{u8{0xFA}, u8{0xFF}},
+            soul::memory::BoundGuardProxy::Config())),
+        linear_allocator_(
+          "Test main thread temp allocator"_str, soul::ONE_GIGABYTE, &page_allocator_),
+        temp_allocator_(&linear_allocator_, soul::runtime::TempProxy::Config())
+  {
+    if (config.taskPoolCount == 0)
+    {
+      config.taskPoolCount = 4096;
+    }
+    if (config.workerTempAllocatorSize == 0)
+    {
+      config.workerTempAllocatorSize = soul::ONE_GIGABYTE;
+    }
+    config.mainThreadTempAllocator = &temp_allocator_;
+    config.defaultAllocator        = &default_allocator_;
+    soul::runtime::init(config);
+  }
+
+  TestRuntime(const TestRuntime&)                    = delete;
+  TestRuntime(TestRuntime&&)                         = delete;
+  auto operator=(const TestRuntime&) -> TestRuntime& = delete;
+  auto operator=(TestRuntime&&) -> TestRuntime&      = delete;
+
+  ~TestRuntime()
+  {
+    soul::runtime::shutdown();
+  }
+
+  auto default_allocator_ref() -> soul::runtime::DefaultAllocator&
+  {
+    return default_allocator_;
+  }
+
+private:
+  soul::memory::PageAllocator page_allocator_;
+  soul::runtime::DefaultBackingAllocator default_backing_allocator_;
+  soul::runtime::DefaultAllocator default_allocator_;
+  soul::memory::LinearAllocator linear_allocator_;
+  soul::runtime::TempAllocator temp_allocator_;
+};
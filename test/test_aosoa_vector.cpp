@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "core/aosoa_vector.h"
+#include "core/config.h"
+#include "memory/allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+using TestStructure   = soul::Tuple<u64, TestObject, i32>;
+using TestAosoaVector = soul::AosoaVector<TestStructure, 16>;
+
+static_assert(TestAosoaVector::COLUMN_OFFSETS[0] == 0);
+static_assert(TestAosoaVector::COLUMN_OFFSETS[1] % soul::SOUL_CACHELINE_SIZE == 0);
+static_assert(TestAosoaVector::COLUMN_OFFSETS[2] % soul::SOUL_CACHELINE_SIZE == 0);
+
+class TestAosoaVectorManipulation : public testing::Test
+{
+public:
+  static constexpr auto PUSH_BACK_COUNT = 150;
+
+  Sequence<u64> u64_sequence            = generate_random_sequence<u64>(PUSH_BACK_COUNT);
+  Sequence<TestObject> testobj_sequence = generate_random_sequence<TestObject>(PUSH_BACK_COUNT);
+  Sequence<i32> i32_sequence            = generate_random_sequence<i32>(PUSH_BACK_COUNT);
+
+  TestAosoaVector aosoa_vector;
+
+  TestAosoaVectorManipulation()
+  {
+    for (auto index = 0; index < PUSH_BACK_COUNT; index++)
+    {
+      aosoa_vector.push_back(
+        u64_sequence[index], testobj_sequence[index].clone(), i32_sequence[index]);
+    }
+  }
+
+  void verify_elements(const TestAosoaVector& vector, usize size)
+  {
+    SOUL_TEST_ASSERT_EQ(vector.size(), size);
+    for (usize index = 0; index < size; index++)
+    {
+      SOUL_TEST_ASSERT_EQ(vector.ref<0>(index), u64_sequence[index]) << "Index : " << index;
+      SOUL_TEST_ASSERT_EQ(vector.ref<1>(index), testobj_sequence[index]);
+      SOUL_TEST_ASSERT_EQ(vector.ref<2>(index), i32_sequence[index]);
+    }
+  }
+};
+
+TEST(TestAosoaVectorConstruction, TestDefaultConstructor)
+{
+  TestAosoaVector aosoa_vector;
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.size(), 0);
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.capacity(), 0);
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.chunk_count(), 0);
+  SOUL_TEST_ASSERT_TRUE(aosoa_vector.empty());
+}
+
+TEST_F(TestAosoaVectorManipulation, TestPushBack)
+{
+  SOUL_TEST_RUN(verify_elements(aosoa_vector, PUSH_BACK_COUNT));
+  SOUL_TEST_ASSERT_FALSE(aosoa_vector.empty());
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.chunk_count(), 10);
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.capacity(), 160);
+
+  // NOTE(kevinyu): Growing must not relocate the existing elements.
+  const TestObject* first_object = &aosoa_vector.ref<1>(0);
+  for (auto index = PUSH_BACK_COUNT; index < 200; index++)
+  {
+    aosoa_vector.push_back(u64(index), TestObject(index), i32(index));
+  }
+  SOUL_TEST_ASSERT_EQ(&aosoa_vector.ref<1>(0), first_object);
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.size(), 200);
+  SOUL_TEST_RUN(verify_elements(aosoa_vector, PUSH_BACK_COUNT));
+}
+
+TEST_F(TestAosoaVectorManipulation, TestChunk)
+{
+  usize element_index = 0;
+  for (usize chunk_index = 0; chunk_index < aosoa_vector.chunk_count(); chunk_index++)
+  {
+    const auto chunk = aosoa_vector.chunk_ref(chunk_index);
+    const usize expected_size =
+      chunk_index == aosoa_vector.chunk_count() - 1 ? PUSH_BACK_COUNT % 16 : 16;
+    SOUL_TEST_ASSERT_EQ(chunk.size(), expected_size);
+    SOUL_TEST_ASSERT_EQ(uptr(chunk.span<0>().data()) % soul::SOUL_CACHELINE_SIZE, 0);
+    SOUL_TEST_ASSERT_EQ(uptr(chunk.span<1>().data()) % soul::SOUL_CACHELINE_SIZE, 0);
+    SOUL_TEST_ASSERT_EQ(uptr(chunk.span<2>().data()) % soul::SOUL_CACHELINE_SIZE, 0);
+    for (usize slot_index = 0; slot_index < chunk.size(); slot_index++)
+    {
+      SOUL_TEST_ASSERT_EQ(&chunk.ref<0>(slot_index), &aosoa_vector.ref<0>(element_index));
+      SOUL_TEST_ASSERT_EQ(chunk.span<2>()[slot_index], i32_sequence[element_index]);
+      element_index++;
+    }
+  }
+  SOUL_TEST_ASSERT_EQ(element_index, PUSH_BACK_COUNT);
+
+  aosoa_vector.for_each_chunk(
+    [](TestAosoaVector::Chunk chunk)
+    {
+      for (u64& value : chunk.span<0>())
+      {
+        value *= 2;
+      }
+    });
+  u64 sum = 0;
+  std::as_const(aosoa_vector)
+    .for_each_chunk(
+      [&sum](TestAosoaVector::ConstChunk chunk)
+      {
+        sum = std::accumulate(chunk.span<0>().begin(), chunk.span<0>().end(), sum);
+      });
+  SOUL_TEST_ASSERT_EQ(sum, 2 * std::accumulate(u64_sequence.begin(), u64_sequence.end(), u64(0)));
+}
+
+TEST_F(TestAosoaVectorManipulation, TestRemove)
+{
+  aosoa_vector.pop_back();
+  SOUL_TEST_RUN(verify_elements(aosoa_vector, PUSH_BACK_COUNT - 1));
+
+  u64_sequence[55]     = u64_sequence[PUSH_BACK_COUNT - 2];
+  testobj_sequence[55] = testobj_sequence[PUSH_BACK_COUNT - 2].clone();
+  i32_sequence[55]     = i32_sequence[PUSH_BACK_COUNT - 2];
+  aosoa_vector.remove(55);
+  SOUL_TEST_RUN(verify_elements(aosoa_vector, PUSH_BACK_COUNT - 2));
+
+  aosoa_vector.remove(PUSH_BACK_COUNT - 3);
+  SOUL_TEST_RUN(verify_elements(aosoa_vector, PUSH_BACK_COUNT - 3));
+}
+
+TEST_F(TestAosoaVectorManipulation, TestClearAndCleanup)
+{
+  aosoa_vector.clear();
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.size(), 0);
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.chunk_count(), 0);
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.capacity(), 160);
+  SOUL_TEST_ASSERT_TRUE(aosoa_vector.empty());
+
+  aosoa_vector.push_back(u64_sequence[0], testobj_sequence[0].clone(), i32_sequence[0]);
+  SOUL_TEST_RUN(verify_elements(aosoa_vector, 1));
+
+  aosoa_vector.cleanup();
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.size(), 0);
+  SOUL_TEST_ASSERT_EQ(aosoa_vector.capacity(), 0);
+}
+
+TEST_F(TestAosoaVectorManipulation, TestMove)
+{
+  TestAosoaVector aosoa_vector_from_move = std::move(aosoa_vector);
+  SOUL_TEST_RUN(verify_elements(aosoa_vector_from_move, PUSH_BACK_COUNT));
+
+  TestAosoaVector aosoa_vector_assign;
+  aosoa_vector_assign.push_back(u64(1), TestObject(1), i32(1));
+  aosoa_vector_assign = std::move(aosoa_vector_from_move);
+  SOUL_TEST_RUN(verify_elements(aosoa_vector_assign, PUSH_BACK_COUNT));
+}
@@ -0,0 +1,211 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "memory/allocator.h"
+#include "runtime/runtime.h"
+
+#include "runtime_util.h"
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    if (runtime::is_worker_thread())
+    {
+      return runtime::get_context_allocator();
+    }
+    return &test_allocator;
+  }
+} // namespace soul
+
+using namespace soul;
+
+namespace
+{
+  constexpr u16 THREAD_COUNT            = 4;
+  constexpr u16 BACKGROUND_THREAD_COUNT = 2;
+
+  void update_max(std::atomic<u32>* max_value, u32 value)
+  {
+    u32 current_max = max_value->load(std::memory_order_relaxed);
+    while (value > current_max &&
+           !max_value->compare_exchange_weak(current_max, value, std::memory_order_relaxed))
+    {
+    }
+  }
+} // namespace
+
+class TestBackgroundTask : public testing::Test
+{
+public:
+  TestRuntime test_runtime{runtime::Config{
+    .threadCount = THREAD_COUNT, .backgroundThreadCount = BACKGROUND_THREAD_COUNT}};
+};
+
+TEST_F(TestBackgroundTask, TestWaitBackgroundTask)
+{
+  i32 value                               = 0;
+  const runtime::BackgroundTaskID task_id = runtime::create_background_task(
+    [&value]()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      value = 42;
+    });
+  runtime::wait_background_task(task_id);
+  SOUL_TEST_ASSERT_TRUE(runtime::is_background_task_complete(task_id));
+  SOUL_TEST_ASSERT_EQ(value, 42);
+}
+
+TEST_F(TestBackgroundTask, TestGenerationReuse)
+{
+  static constexpr u32 TASK_COUNT = 64;
+
+  // NOTE(kevinyu): Free slots are reused last in first out, so running the tasks one by one keep
+  // landing on the same few slots. An old id must stay complete once its slot run another task.
+  std::vector<runtime::BackgroundTaskID> task_ids;
+  for (u32 task_index = 0; task_index < TASK_COUNT; task_index++)
+  {
+    const runtime::BackgroundTaskID task_id = runtime::create_background_task([]() {});
+    runtime::wait_background_task(task_id);
+    task_ids.push_back(task_id);
+  }
+
+  u32 reuse_count = 0;
+  for (u32 task_index = 0; task_index < TASK_COUNT; task_index++)
+  {
+    const runtime::BackgroundTaskID task_id = task_ids[task_index];
+    SOUL_TEST_ASSERT_TRUE(runtime::is_background_task_complete(task_id));
+    for (u32 prev_index = 0; prev_index < task_index; prev_index++)
+    {
+      const runtime::BackgroundTaskID prev_task_id = task_ids[prev_index];
+      if (prev_task_id.index == task_id.index)
+      {
+        SOUL_TEST_ASSERT_GT(task_id.generation, prev_task_id.generation);
+        reuse_count++;
+      }
+    }
+  }
+  SOUL_TEST_ASSERT_GT(reuse_count, 0);
+
+  // NOTE(kevinyu): A pending task on a reused slot is not complete, the old ids still are.
+  std::atomic<b8> is_released             = false;
+  const runtime::BackgroundTaskID task_id = runtime::create_background_task(
+    [&is_released]()
+    {
+      while (!is_released.load(std::memory_order_acquire))
+      {
+        std::this_thread::yield();
+      }
+    });
+  SOUL_TEST_ASSERT_FALSE(runtime::is_background_task_complete(task_id));
+  for (const runtime::BackgroundTaskID prev_task_id : task_ids)
+  {
+    SOUL_TEST_ASSERT_TRUE(runtime::is_background_task_complete(prev_task_id));
+  }
+  is_released.store(true, std::memory_order_release);
+  runtime::wait_background_task(task_id);
+}
+
+TEST_F(TestBackgroundTask, TestMaxBackgroundThreadCount)
+{
+  static constexpr u32 TASK_COUNT = 16;
+
+  std::atomic<u32> running_count     = 0;
+  std::atomic<u32> max_running_count = 0;
+  std::vector<runtime::BackgroundTaskID> task_ids;
+  for (u32 task_index = 0; task_index < TASK_COUNT; task_index++)
+  {
+    task_ids.push_back(runtime::create_background_task(
+      [&running_count, &max_running_count]()
+      {
+        const u32 count = running_count.fetch_add(1, std::memory_order_relaxed) + 1;
+        update_max(&max_running_count, count);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        running_count.fetch_sub(1, std::memory_order_relaxed);
+      }));
+  }
+  for (const runtime::BackgroundTaskID task_id : task_ids)
+  {
+    runtime::wait_background_task(task_id);
+  }
+
+  SOUL_TEST_ASSERT_GE(max_running_count.load(), 1);
+  SOUL_TEST_ASSERT_LE(max_running_count.load(), BACKGROUND_THREAD_COUNT);
+}
+
+TEST_F(TestBackgroundTask, TestFrameTaskFirst)
+{
+  static constexpr u32 FRAME_TASK_COUNT = 512;
+
+  // NOTE(kevinyu): Worker only pick a background task when no frame task is queued. A frame task
+  // can be popped and not yet counted as started, so allow one such task per thread.
+  std::atomic<u32> started_count = 0;
+  std::vector<runtime::TaskID> frame_tasks;
+  for (u32 task_index = 0; task_index < FRAME_TASK_COUNT; task_index++)
+  {
+    frame_tasks.push_back(runtime::create_and_run_task(
+      runtime::TaskID::ROOT(),
+      [&started_count](runtime::TaskID /* task_id */)
+      {
+        started_count.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }));
+  }
+
+  u32 observed_started_count                         = 0;
+  const runtime::BackgroundTaskID background_task_id = runtime::create_background_task(
+    [&started_count, &observed_started_count]()
+    {
+      observed_started_count = started_count.load(std::memory_order_relaxed);
+    });
+
+  for (const runtime::TaskID task_id : frame_tasks)
+  {
+    runtime::wait_task(task_id);
+  }
+  runtime::wait_background_task(background_task_id);
+
+  SOUL_TEST_ASSERT_GE(observed_started_count + THREAD_COUNT, FRAME_TASK_COUNT);
+  runtime::begin_frame();
+}
+
+TEST(TestBackgroundTaskShutdown, TestCancelAndDrain)
+{
+  static constexpr u32 TASK_COUNT = 8;
+
+  // NOTE(kevinyu): More tasks than background threads, so some are still queued when shutdown()
+  // start. Every task must still run, see the cancel request and return before shutdown() finish.
+  std::atomic<u32> started_count   = 0;
+  std::atomic<u32> cancelled_count = 0;
+  {
+    TestRuntime test_runtime{runtime::Config{
+      .threadCount = THREAD_COUNT, .backgroundThreadCount = BACKGROUND_THREAD_COUNT}};
+    SOUL_TEST_ASSERT_FALSE(runtime::is_background_cancel_requested());
+    for (u32 task_index = 0; task_index < TASK_COUNT; task_index++)
+    {
+      runtime::create_background_task(
+        [&started_count, &cancelled_count]()
+        {
+          started_count.fetch_add(1, std::memory_order_relaxed);
+          while (!runtime::is_background_cancel_requested())
+          {
+            std::this_thread::yield();
+          }
+          cancelled_count.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    while (started_count.load(std::memory_order_relaxed) == 0)
+    {
+      std::this_thread::yield();
+    }
+  }
+  SOUL_TEST_ASSERT_EQ(started_count.load(), TASK_COUNT);
+  SOUL_TEST_ASSERT_EQ(cancelled_count.load(), TASK_COUNT);
+}
@@ -553,3 +553,124 @@ TEST_F(TestBitVectorManipulation, TestBitRef)
   SOUL_TEST_RUN(test_bit_flip(u8_filled_bit_vector, 0));
   SOUL_TEST_RUN(test_bit_flip(u8_filled_bit_vector, u8_filled_bit_vector.size() - 1));
 }
+
+auto get_set_bit_indexes(const std::vector<b8>& vector) -> std::vector<usize>
+{
+  std::vector<usize> result;
+  for (usize i = 0; i < vector.size(); i++)
+  {
+    if (vector[i])
+    {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+TEST_F(TestBitVectorManipulation, TestBitVectorCount)
+{
+  auto test_count = []<soul::ts_bit_block BlockType>(const soul::BitVector<BlockType>& test_vector)
+  {
+    const auto expected_vector = get_vector_from_bit_vector(test_vector);
+    SOUL_TEST_ASSERT_EQ(test_vector.count(), get_set_bit_indexes(expected_vector).size());
+  };
+
+  SOUL_TEST_ASSERT_EQ(empty_bit_vector.count(), 0);
+  SOUL_TEST_RUN(test_count(u8_filled_bit_vector));
+  SOUL_TEST_RUN(test_count(u32_filled_bit_vector));
+  SOUL_TEST_RUN(test_count(u64_filled_bit_vector));
+
+  // NOTE(kevinyu): Popped bits stay in the last block, they must not be counted.
+  auto test_vector = u64_filled_bit_vector.clone();
+  test_vector.pop_back(3);
+  SOUL_TEST_ASSERT_EQ(test_vector.count(), RANDOM_BOOL_VECTOR_SIZE - 3);
+  test_vector.set();
+  SOUL_TEST_ASSERT_EQ(test_vector.count(), RANDOM_BOOL_VECTOR_SIZE - 3);
+}
+
+TEST_F(TestBitVectorManipulation, TestBitVectorFind)
+{
+  auto test_find = []<soul::ts_bit_block BlockType>(const soul::BitVector<BlockType>& test_vector)
+  {
+    const auto expected_indexes = get_set_bit_indexes(get_vector_from_bit_vector(test_vector));
+
+    std::vector<usize> find_indexes;
+    auto index = test_vector.find_first();
+    while (index.is_some())
+    {
+      find_indexes.push_back(index.unwrap());
+      index = test_vector.find_next(index.unwrap());
+    }
+    SOUL_TEST_ASSERT_EQ(find_indexes, expected_indexes);
+
+    std::vector<usize> for_each_indexes;
+    test_vector.for_each_set_bit(
+      [&for_each_indexes](usize index)
+      {
+        for_each_indexes.push_back(index);
+      });
+    SOUL_TEST_ASSERT_EQ(for_each_indexes, expected_indexes);
+  };
+
+  SOUL_TEST_ASSERT_FALSE(empty_bit_vector.find_first().is_some());
+  SOUL_TEST_RUN(test_find(empty_bit_vector));
+  SOUL_TEST_RUN(test_find(u8_filled_bit_vector));
+  SOUL_TEST_RUN(test_find(u32_filled_bit_vector));
+  SOUL_TEST_RUN(test_find(u64_filled_bit_vector));
+
+  auto test_vector = soul::BitVector<u32>::FillN(RANDOM_BOOL_VECTOR_SIZE, false);
+  test_vector.set(0);
+  test_vector.set(31);
+  test_vector.set(32);
+  test_vector.set(RANDOM_BOOL_VECTOR_SIZE - 1);
+  SOUL_TEST_ASSERT_EQ(test_vector.find_first().unwrap(), 0);
+  SOUL_TEST_ASSERT_EQ(test_vector.find_next(0).unwrap(), 31);
+  SOUL_TEST_ASSERT_EQ(test_vector.find_next(31).unwrap(), 32);
+  SOUL_TEST_ASSERT_EQ(test_vector.find_next(32).unwrap(), RANDOM_BOOL_VECTOR_SIZE - 1);
+  SOUL_TEST_ASSERT_FALSE(test_vector.find_next(RANDOM_BOOL_VECTOR_SIZE - 1).is_some());
+
+  test_vector.pop_back();
+  SOUL_TEST_ASSERT_FALSE(test_vector.find_next(32).is_some());
+  SOUL_TEST_RUN(test_find(test_vector));
+}
+
+TEST_F(TestBitVectorManipulation, TestBitVectorBulkOperation)
+{
+  auto test_bulk_operation =
+    []<soul::ts_bit_block BlockType>(const soul::BitVector<BlockType>& sample_vector)
+  {
+    const auto lhs_vector = get_vector_from_bit_vector(sample_vector);
+    const auto rhs_vector = generate_random_bool_vector(sample_vector.size());
+    const auto rhs        = soul::BitVector<BlockType>::From(rhs_vector);
+
+    std::vector<b8> and_vector;
+    std::vector<b8> or_vector;
+    std::vector<b8> and_not_vector;
+    for (usize i = 0; i < lhs_vector.size(); i++)
+    {
+      and_vector.push_back(lhs_vector[i] && rhs_vector[i]);
+      or_vector.push_back(lhs_vector[i] || rhs_vector[i]);
+      and_not_vector.push_back(lhs_vector[i] && !rhs_vector[i]);
+    }
+
+    auto and_bit_vector  = sample_vector.clone();
+    and_bit_vector      &= rhs;
+    verify_sequence(and_bit_vector, and_vector);
+    SOUL_TEST_ASSERT_EQ(and_bit_vector.count(), get_set_bit_indexes(and_vector).size());
+
+    auto or_bit_vector  = sample_vector.clone();
+    or_bit_vector      |= rhs;
+    verify_sequence(or_bit_vector, or_vector);
+    SOUL_TEST_ASSERT_EQ(or_bit_vector.count(), get_set_bit_indexes(or_vector).size());
+
+    auto and_not_bit_vector = sample_vector.clone();
+    and_not_bit_vector.and_not(rhs);
+    verify_sequence(and_not_bit_vector, and_not_vector);
+    SOUL_TEST_ASSERT_EQ(and_not_bit_vector.count(), get_set_bit_indexes(and_not_vector).size());
+  };
+
+  SOUL_TEST_RUN(test_bulk_operation(u8_filled_bit_vector));
+  SOUL_TEST_RUN(test_bulk_operation(u32_filled_bit_vector));
+  SOUL_TEST_RUN(test_bulk_operation(u64_filled_bit_vector));
+  SOUL_TEST_RUN(test_bulk_operation(soul::BitVector<u64>::From(generate_random_bool_vector(1000))));
+}
@@ -0,0 +1,274 @@
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/concurrent_hash_map.h"
+#include "core/config.h"
+#include "core/string.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+// NOTE(kevinyu): TestAllocator counters are not atomic, so multithreaded tests serialize it.
+class LockedTestAllocator : public soul::memory::Allocator
+{
+public:
+  LockedTestAllocator() : Allocator("Locked test allocator"_str) {}
+
+  auto try_allocate(usize size, usize alignment, StringView tag)
+    -> soul::memory::Allocation override
+  {
+    std::lock_guard guard(mutex_);
+    return test_allocator_.try_allocate(size, alignment, tag);
+  }
+
+  auto get_allocation_size(void* addr) const -> usize override
+  {
+    return test_allocator_.get_allocation_size(addr);
+  }
+
+  auto deallocate(void* addr) -> void override
+  {
+    std::lock_guard guard(mutex_);
+    test_allocator_.deallocate(addr);
+  }
+
+  auto reset() -> void override {}
+
+private:
+  TestAllocator test_allocator_;
+  std::mutex mutex_;
+};
+
+using IntMap    = soul::ConcurrentHashMap<u64, u64>;
+using StringMap = soul::ConcurrentHashMap<u64, soul::String>;
+
+TEST(TestConcurrentHashMapConstruction, TestDefaultConstructor)
+{
+  const IntMap map;
+  SOUL_TEST_ASSERT_EQ(map.size(), 0);
+  SOUL_TEST_ASSERT_TRUE(map.empty());
+  SOUL_TEST_ASSERT_EQ(map.find(1), nullptr);
+  SOUL_TEST_ASSERT_FALSE(map.contains(1));
+}
+
+TEST(TestConcurrentHashMapFindOrCreate, TestFindOrCreate)
+{
+  IntMap map;
+  for (u64 key = 0; key < 1000; key++)
+  {
+    SOUL_TEST_ASSERT_EQ(map.find_or_create(key, [key]() -> u64 { return key * 3; }), key * 3);
+  }
+  SOUL_TEST_ASSERT_EQ(map.size(), 1000);
+  SOUL_TEST_ASSERT_FALSE(map.empty());
+
+  usize create_count = 0;
+  for (u64 key = 0; key < 1000; key++)
+  {
+    const u64& value = map.find_or_create(
+      key,
+      [&create_count]() -> u64
+      {
+        create_count++;
+        return 0;
+      });
+    SOUL_TEST_ASSERT_EQ(value, key * 3);
+    SOUL_TEST_ASSERT_EQ(map.find(key), &value);
+  }
+  SOUL_TEST_ASSERT_EQ(create_count, 0);
+  SOUL_TEST_ASSERT_EQ(map.size(), 1000);
+  SOUL_TEST_ASSERT_EQ(map.find(1000), nullptr);
+}
+
+// NOTE(kevinyu): Keys that only differ above the low 32 bits are the same key.
+struct LowBitsHash
+{
+  auto operator()(u64 key) const -> u64
+  {
+    return soul::HashOp<u64>()(key & 0xFFFF'FFFF);
+  }
+};
+
+struct LowBitsEqual
+{
+  auto operator()(u64 lhs, u64 rhs) const -> b8
+  {
+    return (lhs & 0xFFFF'FFFF) == (rhs & 0xFFFF'FFFF);
+  }
+};
+
+TEST(TestConcurrentHashMapFindOrCreate, TestCustomKeyEqual)
+{
+  soul::ConcurrentHashMap<u64, u64, LowBitsHash, LowBitsEqual> map;
+  for (u64 key = 0; key < 100; key++)
+  {
+    map.find_or_create(key, [key]() -> u64 { return key; });
+  }
+  for (u64 key = 0; key < 100; key++)
+  {
+    const u64 alias_key = key | (u64{1} << 40);
+    SOUL_TEST_ASSERT_NE(map.find(alias_key), nullptr);
+    SOUL_TEST_ASSERT_EQ(*map.find(alias_key), key);
+    SOUL_TEST_ASSERT_EQ(map.find_or_create(alias_key, []() -> u64 { return 0; }), key);
+  }
+  SOUL_TEST_ASSERT_EQ(map.size(), 100);
+  SOUL_TEST_ASSERT_TRUE(map.remove(u64{7} | (u64{1} << 40)));
+  SOUL_TEST_ASSERT_FALSE(map.contains(7));
+}
+
+TEST(TestConcurrentHashMapRemove, TestRemove)
+{
+  StringMap map;
+  for (u64 key = 0; key < 256; key++)
+  {
+    map.find_or_create(key, [key]() { return soul::String::Format("{}", key); });
+  }
+
+  for (u64 key = 0; key < 256; key += 2)
+  {
+    SOUL_TEST_ASSERT_TRUE(map.remove(key));
+    SOUL_TEST_ASSERT_FALSE(map.remove(key));
+  }
+  SOUL_TEST_ASSERT_FALSE(map.remove(256));
+  SOUL_TEST_ASSERT_EQ(map.size(), 128);
+  map.reclaim();
+
+  for (u64 key = 0; key < 256; key++)
+  {
+    const soul::String* value = map.find(key);
+    if (key % 2 == 0)
+    {
+      SOUL_TEST_ASSERT_EQ(value, nullptr);
+    } else
+    {
+      SOUL_TEST_ASSERT_NE(value, nullptr);
+      SOUL_TEST_ASSERT_EQ(*value, soul::String::Format("{}", key));
+    }
+  }
+
+  // NOTE(kevinyu): Reinsert over tombstones, and remove everything.
+  for (u64 key = 0; key < 256; key += 2)
+  {
+    map.find_or_create(key, [key]() { return soul::String::Format("{}", key); });
+  }
+  SOUL_TEST_ASSERT_EQ(map.size(), 256);
+  for (u64 key = 0; key < 256; key++)
+  {
+    SOUL_TEST_ASSERT_EQ(*map.find(key), soul::String::Format("{}", key));
+    SOUL_TEST_ASSERT_TRUE(map.remove(key));
+  }
+  SOUL_TEST_ASSERT_TRUE(map.empty());
+}
+
+TEST(TestConcurrentHashMapMultithread, TestConcurrentFindOrCreate)
+{
+  static constexpr usize THREAD_COUNT = 8;
+  static constexpr u64 KEY_COUNT      = 4096;
+
+  LockedTestAllocator allocator;
+  {
+    IntMap map(&allocator);
+    std::atomic<usize> create_count = 0;
+    std::vector<std::thread> threads;
+    for (usize thread_index = 0; thread_index < THREAD_COUNT; thread_index++)
+    {
+      threads.emplace_back(
+        [&map, &create_count, thread_index]()
+        {
+          for (u64 iteration = 0; iteration < KEY_COUNT; iteration++)
+          {
+            const u64 key = (iteration * 7 + thread_index) % KEY_COUNT;
+            if (const u64* value = map.find(key); value != nullptr)
+            {
+              SOUL_TEST_ASSERT_EQ(*value, key + 1);
+            }
+            const u64& value = map.find_or_create(
+              key,
+              [&create_count, key]() -> u64
+              {
+                create_count.fetch_add(1, std::memory_order_relaxed);
+                return key + 1;
+              });
+            SOUL_TEST_ASSERT_EQ(value, key + 1);
+          }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+
+    SOUL_TEST_ASSERT_EQ(create_count.load(), map.size());
+    SOUL_TEST_ASSERT_EQ(map.size(), KEY_COUNT);
+    for (u64 key = 0; key < KEY_COUNT; key++)
+    {
+      const u64* value = map.find(key);
+      if (value != nullptr)
+      {
+        SOUL_TEST_ASSERT_EQ(*value, key + 1);
+      }
+    }
+  }
+}
+
+TEST(TestConcurrentHashMapMultithread, TestConcurrentFindAndRemove)
+{
+  static constexpr usize THREAD_COUNT = 4;
+  static constexpr u64 KEY_COUNT      = 2048;
+
+  LockedTestAllocator allocator;
+  {
+    IntMap map(&allocator);
+    std::vector<std::thread> threads;
+    for (usize thread_index = 0; thread_index < THREAD_COUNT; thread_index++)
+    {
+      threads.emplace_back(
+        [&map, thread_index]()
+        {
+          for (u64 iteration = 0; iteration < KEY_COUNT * 4; iteration++)
+          {
+            const u64 key = (iteration * 13 + thread_index) % KEY_COUNT;
+            if (thread_index % 2 == 0 && iteration % 3 == 0)
+            {
+              map.remove(key);
+              continue;
+            }
+            if (const u64* value = map.find(key); value != nullptr)
+            {
+              SOUL_TEST_ASSERT_EQ(*value, key + 1);
+            }
+            const u64& value = map.find_or_create(key, [key]() -> u64 { return key + 1; });
+            SOUL_TEST_ASSERT_EQ(value, key + 1);
+          }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+    map.reclaim();
+
+    usize found_count = 0;
+    for (u64 key = 0; key < KEY_COUNT; key++)
+    {
+      if (const u64* value = map.find(key); value != nullptr)
+      {
+        SOUL_TEST_ASSERT_EQ(*value, key + 1);
+        found_count++;
+      }
+    }
+    SOUL_TEST_ASSERT_EQ(found_count, map.size());
+  }
+}
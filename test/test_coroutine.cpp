@@ -0,0 +1,150 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/path.h"
+#include "core/string.h"
+#include "memory/allocator.h"
+#include "misc/filesystem.h"
+#include "runtime/async_fs.h"
+#include "runtime/coroutine.h"
+
+#include "runtime_util.h"
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    if (runtime::is_worker_thread())
+    {
+      return runtime::get_context_allocator();
+    }
+    return &test_allocator;
+  }
+} // namespace soul
+
+using namespace soul;
+
+namespace
+{
+  constexpr u32 MAX_FRAME_COUNT = 10000;
+
+  // NOTE(kevinyu): Pump frames on the main thread until the coroutine set is_done. Coroutine that
+  // co_await next_frame() is resumed inside begin_frame().
+  auto run_frames_until(const std::atomic<b8>& is_done) -> b8
+  {
+    for (u32 frame_index = 0; frame_index < MAX_FRAME_COUNT; frame_index++)
+    {
+      if (is_done.load(std::memory_order_acquire))
+      {
+        return true;
+      }
+      runtime::begin_frame();
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return is_done.load(std::memory_order_acquire);
+  }
+
+  struct CoroutineResult
+  {
+    std::atomic<b8> is_done  = false;
+    i32 task_value           = 0;
+    b8 is_task_complete      = false;
+    i32 background_value     = 0;
+    u16 background_thread_id = 0;
+    u16 next_frame_thread_id = 1;
+  };
+
+  auto run_test_coroutine(CoroutineResult* result) -> runtime::Coroutine<void>
+  {
+    i32 task_value             = 0;
+    const runtime::TaskID task = runtime::create_and_run_task(
+      runtime::TaskID::ROOT(),
+      [&task_value](runtime::TaskID /* task_id */)
+      {
+        task_value = 7;
+      });
+    co_await task;
+    result->task_value       = task_value;
+    result->is_task_complete = runtime::System::get().is_task_complete(task);
+
+    result->background_value = co_await runtime::run_in_background(
+      [task_value]() -> i32
+      {
+        return task_value * 6;
+      });
+    result->background_thread_id = runtime::get_thread_id();
+
+    co_await runtime::next_frame();
+    result->next_frame_thread_id = runtime::get_thread_id();
+    result->is_done.store(true, std::memory_order_release);
+  }
+
+  auto read_file_coroutine(Path path, String* content, std::atomic<b8>* is_done)
+    -> runtime::Coroutine<void>
+  {
+    *content = co_await runtime::get_file_content_async(std::move(path));
+    co_await runtime::next_frame();
+    is_done->store(true, std::memory_order_release);
+  }
+
+  auto add_one_coroutine(i32 value) -> runtime::Coroutine<i32>
+  {
+    co_return value + 1;
+  }
+
+  auto nested_coroutine(i32* result, std::atomic<b8>* is_done) -> runtime::Coroutine<void>
+  {
+    *result = co_await add_one_coroutine(co_await add_one_coroutine(40));
+    is_done->store(true, std::memory_order_release);
+  }
+} // namespace
+
+class TestCoroutine : public testing::Test
+{
+public:
+  TestRuntime test_runtime{runtime::Config{.threadCount = 4}};
+};
+
+TEST_F(TestCoroutine, TestTaskBackgroundAndNextFrame)
+{
+  CoroutineResult result;
+  runtime::spawn_coroutine(run_test_coroutine(&result));
+  SOUL_TEST_ASSERT_TRUE(run_frames_until(result.is_done));
+  SOUL_TEST_ASSERT_EQ(result.task_value, 7);
+  SOUL_TEST_ASSERT_TRUE(result.is_task_complete);
+  SOUL_TEST_ASSERT_EQ(result.background_value, 42);
+  // NOTE(kevinyu): Background task only run on the workers, next_frame() resume on the main thread.
+  SOUL_TEST_ASSERT_NE(result.background_thread_id, 0);
+  SOUL_TEST_ASSERT_EQ(result.next_frame_thread_id, 0);
+}
+
+TEST_F(TestCoroutine, TestNestedCoroutine)
+{
+  i32 result              = 0;
+  std::atomic<b8> is_done = false;
+  runtime::spawn_coroutine(nested_coroutine(&result, &is_done));
+  SOUL_TEST_ASSERT_TRUE(is_done.load());
+  SOUL_TEST_ASSERT_EQ(result, 42);
+}
+
+TEST_F(TestCoroutine, TestGetFileContentAsync)
+{
+  const char* file_content = "soul coroutine file content";
+  const auto path = Path(std::filesystem::temp_directory_path() / "soul_test_coroutine.txt");
+  fs::write_file(path, StringView(file_content));
+
+  String content;
+  std::atomic<b8> is_done = false;
+  runtime::spawn_coroutine(read_file_coroutine(path.clone(), &content, &is_done));
+  SOUL_TEST_ASSERT_TRUE(run_frames_until(is_done));
+  SOUL_TEST_ASSERT_STREQ(content.c_str(), file_content);
+
+  fs::delete_file(path);
+}
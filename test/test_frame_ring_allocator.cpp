@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+#include "memory/allocators/frame_ring_allocator.h"
+#include "memory/allocators/page_allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+using soul::memory::FrameRingAllocator;
+
+namespace
+{
+  struct Block
+  {
+    byte* addr;
+    usize size;
+    u8 pattern;
+  };
+
+  auto is_block_intact(const Block& block) -> b8
+  {
+    return std::all_of(
+      block.addr,
+      block.addr + block.size,
+      [pattern = block.pattern](byte value)
+      {
+        return soul::cast<u8>(value) == pattern;
+      });
+  }
+
+  auto allocate_block(FrameRingAllocator* allocator, usize size, u8 pattern) -> Block
+  {
+    const auto allocation = allocator->try_allocate(size, alignof(std::max_align_t), "test"_str);
+    const Block block     = {soul::cast<byte*>(allocation.addr), size, pattern};
+    if (block.addr != nullptr)
+    {
+      std::memset(block.addr, block.pattern, block.size);
+    }
+    return block;
+  }
+
+  constexpr usize FRAME_COUNT            = 3;
+  constexpr usize RESERVE_SIZE_PER_FRAME = 16 * soul::ONE_MEGABYTE;
+} // namespace
+
+class TestFrameRingAllocator : public testing::Test
+{
+public:
+  soul::memory::PageAllocator page_allocator{"Test page allocator"_str};
+  FrameRingAllocator allocator{
+    "Test frame ring allocator"_str, FRAME_COUNT, RESERVE_SIZE_PER_FRAME, &page_allocator};
+};
+
+TEST_F(TestFrameRingAllocator, TestFrameLifetime)
+{
+  SOUL_TEST_ASSERT_EQ(allocator.get_frame_count(), FRAME_COUNT);
+
+  const Block first_block = allocate_block(&allocator, 1000, 0xA1);
+  SOUL_TEST_ASSERT_NE(first_block.addr, nullptr);
+  SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(first_block.addr), first_block.size);
+
+  // NOTE(kevinyu): The block must survive frame_count - 1 begin_frame() while the other segments
+  // are used.
+  for (usize frame_index = 1; frame_index < FRAME_COUNT; frame_index++)
+  {
+    allocator.begin_frame();
+    const Block block = allocate_block(&allocator, 1000, soul::cast<u8>(frame_index));
+    SOUL_TEST_ASSERT_NE(block.addr, nullptr);
+    SOUL_TEST_ASSERT_NE(block.addr, first_block.addr);
+    SOUL_TEST_ASSERT_TRUE(is_block_intact(first_block));
+  }
+
+  // NOTE(kevinyu): The next begin_frame() wrap around and release the segment of the first block.
+  allocator.begin_frame();
+  const Block reused_block = allocate_block(&allocator, 1000, 0xB2);
+  SOUL_TEST_ASSERT_EQ(reused_block.addr, first_block.addr);
+}
+
+TEST_F(TestFrameRingAllocator, TestSegmentExhausted)
+{
+  const auto allocation =
+    allocator.try_allocate(RESERVE_SIZE_PER_FRAME + 1, alignof(std::max_align_t), "test"_str);
+  SOUL_TEST_ASSERT_EQ(allocation.addr, nullptr);
+
+  const Block block = allocate_block(&allocator, 100, 0xC3);
+  SOUL_TEST_ASSERT_NE(block.addr, nullptr);
+}
+
+TEST_F(TestFrameRingAllocator, TestConcurrentAllocation)
+{
+  static constexpr usize THREAD_COUNT = 4;
+  static constexpr usize BLOCK_COUNT  = 2000;
+
+  std::vector<Block> thread_blocks[THREAD_COUNT];
+  std::atomic<usize> failed_count = 0;
+  std::vector<std::thread> threads;
+  for (usize thread_index = 0; thread_index < THREAD_COUNT; thread_index++)
+  {
+    threads.emplace_back(
+      [&, thread_index]()
+      {
+        std::mt19937 random_engine(soul::cast<u32>(thread_index));
+        std::uniform_int_distribution<usize> size_distribution(1, 512);
+        for (usize block_index = 0; block_index < BLOCK_COUNT; block_index++)
+        {
+          const auto pattern = soul::cast<u8>(thread_index * 61 + block_index);
+          const Block block  = allocate_block(&allocator, size_distribution(random_engine), pattern);
+          if (block.addr == nullptr)
+          {
+            failed_count++;
+            continue;
+          }
+          thread_blocks[thread_index].push_back(block);
+        }
+      });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  SOUL_TEST_ASSERT_EQ(failed_count.load(), 0);
+  for (const auto& blocks : thread_blocks)
+  {
+    for (const Block& block : blocks)
+    {
+      SOUL_TEST_ASSERT_TRUE(is_block_intact(block));
+      SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(block.addr), block.size);
+      SOUL_TEST_ASSERT_EQ(soul::cast<uptr>(block.addr) % alignof(std::max_align_t), 0);
+    }
+  }
+}
+
+TEST_F(TestFrameRingAllocator, TestDecommitOnReset)
+{
+  SOUL_TEST_ASSERT_EQ(allocator.get_committed_size(), 0);
+
+  static constexpr usize LARGE_SIZE = 4 * soul::ONE_MEGABYTE;
+  const Block large_block           = allocate_block(&allocator, LARGE_SIZE, 0xD4);
+  SOUL_TEST_ASSERT_NE(large_block.addr, nullptr);
+  SOUL_TEST_ASSERT_GE(allocator.get_committed_size(), LARGE_SIZE);
+
+  // NOTE(kevinyu): A segment keep what its last use needed, so the first reset() keep the large
+  // block committed and the second one, after an empty frame, give it back.
+  allocator.reset();
+  SOUL_TEST_ASSERT_GE(allocator.get_committed_size(), LARGE_SIZE);
+  allocator.reset();
+  SOUL_TEST_ASSERT_EQ(allocator.get_committed_size(), 0);
+
+  const Block small_block = allocate_block(&allocator, 100, 0xE5);
+  SOUL_TEST_ASSERT_NE(small_block.addr, nullptr);
+  SOUL_TEST_ASSERT_LT(allocator.get_committed_size(), LARGE_SIZE);
+  SOUL_TEST_ASSERT_TRUE(is_block_intact(small_block));
+}
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/hash.h"
+#include "core/hash_map.h"
+#include "core/string.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+template <soul::HashTableBackend BackendV>
+using TestStringMap = soul::HashMap<
+  soul::String,
+  u32,
+  soul::HashOp<soul::String>,
+  std::equal_to<soul::String>,
+  soul::memory::Allocator,
+  BackendV>;
+
+// NOTE(kevinyu): Every scenario run against all the hash table backends
+using TestMapTypes = testing::Types<
+  TestStringMap<soul::HashTableBackend::ROBIN>,
+  TestStringMap<soul::HashTableBackend::SWISS>>;
+
+struct TestIdQuery
+{
+  u32 id;
+
+  friend auto operator==(u64 key, TestIdQuery query) -> b8
+  {
+    return key == query.id;
+  }
+};
+
+struct TestIdHash
+{
+  using is_transparent = void;
+
+  auto operator()(u64 key) const -> u64
+  {
+    return soul::HashOp<u64>()(key);
+  }
+
+  auto operator()(TestIdQuery query) const -> u64
+  {
+    return soul::HashOp<u64>()(u64(query.id));
+  }
+};
+
+static_assert(soul::ts_hash_query<StringView, soul::String, soul::HashOp<soul::String>>);
+static_assert(soul::ts_hash_query<TestIdQuery, u64, TestIdHash>);
+static_assert(!soul::ts_hash_query<TestIdQuery, u64, soul::HashOp<u64>>);
+static_assert(!soul::ts_hash_query<soul::String, soul::String, soul::HashOp<soul::String>>);
+
+template <typename MapT>
+class TestHashMapLookup : public testing::Test
+{
+public:
+  static constexpr u32 ENTRY_COUNT = 1000;
+
+  MapT test_map;
+
+  TestHashMapLookup()
+  {
+    for (u32 i = 0; i < ENTRY_COUNT; i++)
+    {
+      test_map.insert(soul::String::Format("key_{}", i), i);
+    }
+  }
+};
+
+TYPED_TEST_SUITE(TestHashMapLookup, TestMapTypes);
+
+TYPED_TEST(TestHashMapLookup, TestFind)
+{
+  TypeParam empty_map;
+  SOUL_TEST_ASSERT_EQ(empty_map.find("key_0"_str), nullptr);
+  SOUL_TEST_ASSERT_EQ(empty_map.find(soul::String::From("key_0"_str)), nullptr);
+
+  auto& test_map = this->test_map;
+  for (u32 i = 0; i < TestFixture::ENTRY_COUNT; i++)
+  {
+    const auto key = soul::String::Format("key_{}", i);
+    u32* value     = test_map.find(key.cview());
+    SOUL_TEST_ASSERT_NE(value, nullptr);
+    SOUL_TEST_ASSERT_EQ(*value, i);
+    SOUL_TEST_ASSERT_EQ(test_map.find(key), value);
+    SOUL_TEST_ASSERT_EQ(&test_map.ref(key.cview()), value);
+    SOUL_TEST_ASSERT_TRUE(test_map.contains(key.cview()));
+  }
+  SOUL_TEST_ASSERT_EQ(test_map.find("key_1000"_str), nullptr);
+  SOUL_TEST_ASSERT_FALSE(test_map.contains("key_1000"_str));
+
+  *test_map.find("key_3"_str) = 30;
+  const TypeParam& const_map  = test_map;
+  SOUL_TEST_ASSERT_EQ(*const_map.find("key_3"_str), 30);
+  SOUL_TEST_ASSERT_EQ(const_map.find("key_1000"_str), nullptr);
+}
+
+TYPED_TEST(TestHashMapLookup, TestTryEmplace)
+{
+  auto& test_map = this->test_map;
+  SOUL_TEST_ASSERT_EQ(test_map.try_emplace(soul::String::From("key_5"_str), 100u), 5);
+  SOUL_TEST_ASSERT_EQ(test_map.size(), TestFixture::ENTRY_COUNT);
+
+  u32& value = test_map.try_emplace(soul::String::From("new_key"_str), 100u);
+  SOUL_TEST_ASSERT_EQ(value, 100);
+  SOUL_TEST_ASSERT_EQ(test_map.find("new_key"_str), &value);
+  SOUL_TEST_ASSERT_EQ(test_map.size(), TestFixture::ENTRY_COUNT + 1);
+}
+
+TYPED_TEST(TestHashMapLookup, TestFindOrInsertWith)
+{
+  auto& test_map = this->test_map;
+  usize fn_count = 0;
+  const auto fn  = [&fn_count]() -> u32
+  {
+    fn_count++;
+    return 0;
+  };
+  for (u32 i = 0; i < TestFixture::ENTRY_COUNT; i++)
+  {
+    SOUL_TEST_ASSERT_EQ(test_map.find_or_insert_with(soul::String::Format("key_{}", i), fn), i);
+  }
+  SOUL_TEST_ASSERT_EQ(fn_count, 0);
+  SOUL_TEST_ASSERT_EQ(test_map.size(), TestFixture::ENTRY_COUNT);
+
+  // NOTE(kevinyu): The returned value must be the inserted one even when the table grow or the
+  // entry displace another one.
+  for (u32 i = TestFixture::ENTRY_COUNT; i < TestFixture::ENTRY_COUNT * 3; i++)
+  {
+    const auto key = soul::String::Format("key_{}", i);
+    u32& value     = test_map.find_or_insert_with(
+      key.clone(),
+      [i]() -> u32
+      {
+        return i;
+      });
+    SOUL_TEST_ASSERT_EQ(value, i);
+    SOUL_TEST_ASSERT_EQ(test_map.find(key), &value);
+  }
+  SOUL_TEST_ASSERT_EQ(test_map.size(), TestFixture::ENTRY_COUNT * 3);
+  for (u32 i = 0; i < TestFixture::ENTRY_COUNT * 3; i++)
+  {
+    SOUL_TEST_ASSERT_EQ(test_map.ref(soul::String::Format("key_{}", i).cview()), i);
+  }
+}
+
+TYPED_TEST(TestHashMapLookup, TestFindOrInsertWithQuery)
+{
+  auto& test_map       = this->test_map;
+  usize make_key_count = 0;
+  const auto make_key  = [&make_key_count](StringView query) -> soul::String
+  {
+    make_key_count++;
+    return soul::String::From(query);
+  };
+
+  for (u32 i = 0; i < TestFixture::ENTRY_COUNT; i++)
+  {
+    const auto key = soul::String::Format("key_{}", i);
+    u32& value     = test_map.find_or_insert_with(
+      key.cview(),
+      make_key,
+      []() -> u32
+      {
+        return 0;
+      });
+    SOUL_TEST_ASSERT_EQ(value, i);
+  }
+  SOUL_TEST_ASSERT_EQ(make_key_count, 0);
+
+  for (u32 i = TestFixture::ENTRY_COUNT; i < TestFixture::ENTRY_COUNT * 2; i++)
+  {
+    const auto key = soul::String::Format("key_{}", i);
+    u32& value     = test_map.find_or_insert_with(
+      key.cview(),
+      make_key,
+      [i]() -> u32
+      {
+        return i;
+      });
+    SOUL_TEST_ASSERT_EQ(value, i);
+    SOUL_TEST_ASSERT_EQ(test_map.find(key.cview()), &value);
+  }
+  SOUL_TEST_ASSERT_EQ(make_key_count, TestFixture::ENTRY_COUNT);
+  SOUL_TEST_ASSERT_EQ(test_map.size(), TestFixture::ENTRY_COUNT * 2);
+}
+
+using TestBackendTypes = testing::Types<
+  std::integral_constant<soul::HashTableBackend, soul::HashTableBackend::ROBIN>,
+  std::integral_constant<soul::HashTableBackend, soul::HashTableBackend::SWISS>>;
+
+template <typename BackendT>
+class TestHashMapTransparent : public testing::Test
+{
+public:
+  using MapT = soul::HashMap<
+    u64,
+    u32,
+    TestIdHash,
+    std::equal_to<u64>,
+    soul::memory::Allocator,
+    BackendT::value>;
+};
+
+TYPED_TEST_SUITE(TestHashMapTransparent, TestBackendTypes);
+
+TYPED_TEST(TestHashMapTransparent, TestTransparentLookup)
+{
+  typename TestFixture::MapT test_map;
+  for (u32 i = 0; i < 500; i++)
+  {
+    test_map.insert(u64(i), i * 2);
+  }
+
+  for (u32 i = 0; i < 500; i++)
+  {
+    const auto query = TestIdQuery{.id = i};
+    SOUL_TEST_ASSERT_TRUE(test_map.contains(query));
+    SOUL_TEST_ASSERT_EQ(*test_map.find(query), i * 2);
+    SOUL_TEST_ASSERT_EQ(test_map.ref(query), i * 2);
+  }
+  SOUL_TEST_ASSERT_FALSE(test_map.contains(TestIdQuery{.id = 500}));
+  SOUL_TEST_ASSERT_EQ(test_map.find(TestIdQuery{.id = 500}), nullptr);
+
+  const u32& value = test_map.find_or_insert_with(
+    TestIdQuery{.id = 500},
+    [](TestIdQuery query) -> u64
+    {
+      return query.id;
+    },
+    []() -> u32
+    {
+      return 1000;
+    });
+  SOUL_TEST_ASSERT_EQ(value, 1000);
+  SOUL_TEST_ASSERT_EQ(test_map.find(u64(500)), &value);
+
+  test_map.remove(TestIdQuery{.id = 0});
+  SOUL_TEST_ASSERT_FALSE(test_map.contains(u64(0)));
+  SOUL_TEST_ASSERT_EQ(test_map.size(), 500);
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+#include "memory/allocators/linear_allocator.h"
+#include "memory/allocators/page_allocator.h"
+#include "memory/allocators/proxy_allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+using soul::memory::LinearAllocator;
+
+namespace
+{
+  constexpr usize RESERVE_SIZE = 64 * soul::ONE_MEGABYTE;
+  constexpr usize LARGE_SIZE   = 4 * soul::ONE_MEGABYTE;
+
+  auto allocate_filled(LinearAllocator* allocator, usize size, u8 value) -> byte*
+  {
+    auto* addr = soul::cast<byte*>(allocator->try_allocate(size, 16, "test"_str).addr);
+    if (addr != nullptr)
+    {
+      std::memset(addr, value, size);
+    }
+    return addr;
+  }
+} // namespace
+
+class TestLinearAllocator : public testing::Test
+{
+public:
+  soul::memory::PageAllocator page_allocator{"Test page allocator"_str};
+  LinearAllocator allocator{"Test linear allocator"_str, RESERVE_SIZE, &page_allocator};
+};
+
+TEST_F(TestLinearAllocator, TestCommitOnDemand)
+{
+  SOUL_TEST_ASSERT_EQ(allocator.get_committed_size(), 0);
+
+  byte* small_addr = allocate_filled(&allocator, 100, 0xA1);
+  SOUL_TEST_ASSERT_NE(small_addr, nullptr);
+  SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(small_addr), 100);
+  SOUL_TEST_ASSERT_GE(allocator.get_committed_size(), 100);
+  SOUL_TEST_ASSERT_LT(allocator.get_committed_size(), LARGE_SIZE);
+
+  byte* large_addr = allocate_filled(&allocator, LARGE_SIZE, 0xB2);
+  SOUL_TEST_ASSERT_NE(large_addr, nullptr);
+  SOUL_TEST_ASSERT_GT(large_addr, small_addr);
+  SOUL_TEST_ASSERT_GE(allocator.get_committed_size(), LARGE_SIZE);
+  SOUL_TEST_ASSERT_LT(allocator.get_committed_size(), RESERVE_SIZE);
+  SOUL_TEST_ASSERT_EQ(soul::cast<u8>(small_addr[99]), 0xA1);
+}
+
+TEST_F(TestLinearAllocator, TestDecommitToHighWaterMark)
+{
+  byte* first_addr = allocate_filled(&allocator, LARGE_SIZE, 0xC3);
+  SOUL_TEST_ASSERT_NE(first_addr, nullptr);
+
+  // NOTE(kevinyu): reset() keep what the period since the previous reset() needed, so the first
+  // reset() keep the large block committed and the second one, after an empty period, give it
+  // back.
+  allocator.reset();
+  SOUL_TEST_ASSERT_GE(allocator.get_committed_size(), LARGE_SIZE);
+  allocator.reset();
+  SOUL_TEST_ASSERT_EQ(allocator.get_committed_size(), 0);
+
+  byte* reused_addr = allocate_filled(&allocator, 100, 0xD4);
+  SOUL_TEST_ASSERT_EQ(reused_addr, first_addr);
+  SOUL_TEST_ASSERT_LT(allocator.get_committed_size(), LARGE_SIZE);
+}
+
+TEST_F(TestLinearAllocator, TestRewind)
+{
+  byte* first_addr   = allocate_filled(&allocator, 100, 0xE5);
+  void* const marker = allocator.get_marker();
+  byte* second_addr  = allocate_filled(&allocator, LARGE_SIZE, 0xF6);
+  SOUL_TEST_ASSERT_NE(second_addr, nullptr);
+
+  allocator.rewind(marker);
+  SOUL_TEST_ASSERT_EQ(allocator.get_marker(), marker);
+  byte* rewound_addr = allocate_filled(&allocator, 200, 0x17);
+  SOUL_TEST_ASSERT_EQ(rewound_addr, second_addr);
+  SOUL_TEST_ASSERT_EQ(soul::cast<u8>(first_addr[0]), 0xE5);
+
+  // NOTE(kevinyu): The rewound large block still count toward the high water mark.
+  allocator.reset();
+  SOUL_TEST_ASSERT_GE(allocator.get_committed_size(), LARGE_SIZE);
+}
+
+TEST_F(TestLinearAllocator, TestReserveExhausted)
+{
+  SOUL_TEST_ASSERT_EQ(allocator.try_allocate(RESERVE_SIZE * 2, 16, "test"_str).addr, nullptr);
+  SOUL_TEST_ASSERT_EQ(allocator.get_committed_size(), 0);
+
+  usize large_count = 0;
+  while (allocate_filled(&allocator, LARGE_SIZE, 0x28) != nullptr)
+  {
+    large_count++;
+  }
+  SOUL_TEST_ASSERT_GE(large_count, RESERVE_SIZE / LARGE_SIZE - 1);
+  SOUL_TEST_ASSERT_LE(
+    allocator.get_committed_size(), RESERVE_SIZE + page_allocator.get_page_size());
+
+  allocator.reset();
+  SOUL_TEST_ASSERT_NE(allocate_filled(&allocator, LARGE_SIZE, 0x39), nullptr);
+}
+
+TEST(TestProfiledLinearAllocator, TestReservation)
+{
+  // NOTE(kevinyu): Only the profile hook run on the reservation, nothing touch the uncommitted
+  // memory.
+  soul::memory::PageAllocator page_allocator{"Test page allocator"_str};
+  soul::memory::ProxyAllocator<soul::memory::PageAllocator, soul::memory::ProfileProxy>
+    profile_page_allocator(&page_allocator, soul::memory::ProfileProxy::Config());
+  LinearAllocator allocator("Test linear allocator"_str, RESERVE_SIZE, &profile_page_allocator);
+  SOUL_TEST_ASSERT_EQ(allocator.get_committed_size(), 0);
+  SOUL_TEST_ASSERT_NE(allocate_filled(&allocator, LARGE_SIZE, 0x4A), nullptr);
+}
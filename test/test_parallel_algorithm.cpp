@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "memory/allocator.h"
+#include "runtime/parallel_algorithm.h"
+
+#include "runtime_util.h"
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    if (runtime::is_worker_thread())
+    {
+      return runtime::get_context_allocator();
+    }
+    return &test_allocator;
+  }
+} // namespace soul
+
+namespace
+{
+  constexpr u32 BLOCK_SIZE = 64;
+
+  // NOTE(kevinyu): Sizes around the block boundary, plus one large enough to be split between all
+  // the workers.
+  constexpr u32 TEST_COUNTS[] = {
+    0, 1, 2, BLOCK_SIZE - 1, BLOCK_SIZE, BLOCK_SIZE + 1, 2 * BLOCK_SIZE, 3 * BLOCK_SIZE + 7, 10000};
+
+  auto generate_values(u32 count, u32 seed) -> std::vector<i64>
+  {
+    std::mt19937 random_engine(seed);
+    std::uniform_int_distribution<i64> distribution(-1000, 1000);
+    std::vector<i64> values(count);
+    std::generate(
+      values.begin(),
+      values.end(),
+      [&]() -> i64
+      {
+        return distribution(random_engine);
+      });
+    return values;
+  }
+
+  struct KeyIndex
+  {
+    i32 key;
+    u32 index;
+
+    friend auto operator==(const KeyIndex& lhs, const KeyIndex& rhs) -> b8 = default;
+  };
+
+  // NOTE(kevinyu): Neither default constructible nor copyable.
+  class MoveOnlyValue
+  {
+  public:
+    explicit MoveOnlyValue(i32 value) : value_(value) {}
+
+    MoveOnlyValue(const MoveOnlyValue&)                    = delete;
+    MoveOnlyValue(MoveOnlyValue&&)                         = default;
+    auto operator=(const MoveOnlyValue&) -> MoveOnlyValue& = delete;
+    auto operator=(MoveOnlyValue&&) -> MoveOnlyValue&      = default;
+    ~MoveOnlyValue()                                       = default;
+
+    [[nodiscard]]
+    auto value() const -> i32
+    {
+      return value_;
+    }
+
+  private:
+    i32 value_;
+  };
+
+  static_assert(!std::default_initializable<MoveOnlyValue>);
+} // namespace
+
+class TestParallelAlgorithm : public testing::Test
+{
+public:
+  TestRuntime test_runtime{soul::runtime::Config{.threadCount = 4}};
+};
+
+TEST_F(TestParallelAlgorithm, TestParallelReduce)
+{
+  for (const u32 count : TEST_COUNTS)
+  {
+    SOUL_TEST_MESSAGE(std::to_string(count).c_str());
+    const auto values = generate_values(count, count);
+    const i64 result  = soul::runtime::parallel_reduce(
+      count,
+      BLOCK_SIZE,
+      i64(0),
+      [&values](u32 index) -> i64
+      {
+        return values[index] * values[index];
+      },
+      std::plus<i64>());
+    const i64 expected = std::transform_reduce(
+      values.begin(),
+      values.end(),
+      i64(0),
+      std::plus<i64>(),
+      [](i64 value) -> i64
+      {
+        return value * value;
+      });
+    SOUL_TEST_ASSERT_EQ(result, expected);
+
+    const i64 max_result = soul::runtime::parallel_reduce(
+      count,
+      BLOCK_SIZE,
+      std::numeric_limits<i64>::min(),
+      [&values](u32 index) -> i64
+      {
+        return values[index];
+      },
+      [](i64 lhs, i64 rhs) -> i64
+      {
+        return std::max(lhs, rhs);
+      });
+    const i64 expected_max =
+      count == 0 ? std::numeric_limits<i64>::min() : std::ranges::max(values);
+    SOUL_TEST_ASSERT_EQ(max_result, expected_max);
+    soul::runtime::begin_frame();
+  }
+}
+
+TEST_F(TestParallelAlgorithm, TestParallelInclusiveScan)
+{
+  for (const u32 count : TEST_COUNTS)
+  {
+    SOUL_TEST_MESSAGE(std::to_string(count).c_str());
+    const auto values = generate_values(count, count + 1);
+    std::vector<i64> expected(count);
+    std::inclusive_scan(values.begin(), values.end(), expected.begin());
+
+    std::vector<i64> output(count, -1);
+    soul::runtime::parallel_inclusive_scan<i64>(
+      {values.data(), count}, {output.data(), count}, BLOCK_SIZE, i64(0), std::plus<i64>());
+    SOUL_TEST_ASSERT_TRUE(output == expected);
+
+    std::vector<i64> in_place = values;
+    soul::runtime::parallel_inclusive_scan<i64>(
+      {in_place.data(), count}, {in_place.data(), count}, BLOCK_SIZE, i64(0), std::plus<i64>());
+    SOUL_TEST_ASSERT_TRUE(in_place == expected);
+    soul::runtime::begin_frame();
+  }
+}
+
+TEST_F(TestParallelAlgorithm, TestParallelSort)
+{
+  for (const u32 count : TEST_COUNTS)
+  {
+    SOUL_TEST_MESSAGE(std::to_string(count).c_str());
+    auto values               = generate_values(count, count + 2);
+    std::vector<i64> expected = values;
+    std::sort(expected.begin(), expected.end());
+    soul::runtime::parallel_sort<i64>({values.data(), count}, BLOCK_SIZE);
+    SOUL_TEST_ASSERT_TRUE(values == expected);
+
+    std::vector<i64> descending = expected;
+    std::sort(descending.begin(), descending.end(), std::greater<>());
+    soul::runtime::parallel_sort<i64>({values.data(), count}, BLOCK_SIZE, std::greater<>());
+    SOUL_TEST_ASSERT_TRUE(values == descending);
+    soul::runtime::begin_frame();
+  }
+}
+
+TEST_F(TestParallelAlgorithm, TestParallelSortStable)
+{
+  for (const u32 count : TEST_COUNTS)
+  {
+    SOUL_TEST_MESSAGE(std::to_string(count).c_str());
+    std::mt19937 random_engine(count);
+    std::uniform_int_distribution<i32> distribution(0, 8);
+    std::vector<KeyIndex> values(count);
+    for (u32 index = 0; index < count; index++)
+    {
+      values[index] = {distribution(random_engine), index};
+    }
+    const auto compare_key = [](const KeyIndex& lhs, const KeyIndex& rhs) -> b8
+    {
+      return lhs.key < rhs.key;
+    };
+
+    std::vector<KeyIndex> expected = values;
+    std::stable_sort(expected.begin(), expected.end(), compare_key);
+    soul::runtime::parallel_sort<KeyIndex>({values.data(), count}, BLOCK_SIZE, compare_key);
+    SOUL_TEST_ASSERT_TRUE(values == expected);
+    soul::runtime::begin_frame();
+  }
+}
+
+TEST_F(TestParallelAlgorithm, TestParallelSortMoveOnly)
+{
+  for (const u32 count : TEST_COUNTS)
+  {
+    SOUL_TEST_MESSAGE(std::to_string(count).c_str());
+    const auto keys = generate_values(count, count + 3);
+    std::vector<MoveOnlyValue> values;
+    values.reserve(count);
+    for (const i64 key : keys)
+    {
+      values.emplace_back(soul::cast<i32>(key));
+    }
+    std::vector<i64> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    soul::runtime::parallel_sort<MoveOnlyValue>(
+      {values.data(), count},
+      BLOCK_SIZE,
+      [](const MoveOnlyValue& lhs, const MoveOnlyValue& rhs) -> b8
+      {
+        return lhs.value() < rhs.value();
+      });
+    for (u32 index = 0; index < count; index++)
+    {
+      SOUL_TEST_ASSERT_EQ(values[index].value(), expected[index]);
+    }
+    soul::runtime::begin_frame();
+  }
+}
+
+TEST_F(TestParallelAlgorithm, TestParallelForMatchFixedGrain)
+{
+  for (const u32 count : TEST_COUNTS)
+  {
+    SOUL_TEST_MESSAGE(std::to_string(count).c_str());
+    std::vector<std::atomic<u32>> adaptive_visits(count);
+    std::vector<std::atomic<u32>> fixed_grain_visits(count);
+
+    const auto adaptive_task_id = soul::runtime::parallel_for_task_create(
+      soul::runtime::TaskID::ROOT(),
+      count,
+      BLOCK_SIZE,
+      [&adaptive_visits](int index)
+      {
+        adaptive_visits[index].fetch_add(1, std::memory_order_relaxed);
+      });
+    soul::runtime::run_and_wait_task(adaptive_task_id);
+
+    const auto fixed_grain_task_id = soul::runtime::parallel_for_task_create_fixed_grain(
+      soul::runtime::TaskID::ROOT(),
+      count,
+      BLOCK_SIZE,
+      [&fixed_grain_visits](int index)
+      {
+        fixed_grain_visits[index].fetch_add(1, std::memory_order_relaxed);
+      });
+    soul::runtime::run_and_wait_task(fixed_grain_task_id);
+
+    for (u32 index = 0; index < count; index++)
+    {
+      SOUL_TEST_ASSERT_EQ(adaptive_visits[index].load(), 1u) << "Index : " << index;
+      SOUL_TEST_ASSERT_EQ(fixed_grain_visits[index].load(), 1u) << "Index : " << index;
+    }
+    soul::runtime::begin_frame();
+  }
+}
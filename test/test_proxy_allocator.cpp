@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+#include "memory/allocators/malloc_allocator.h"
+#include "memory/allocators/proxy_allocator.h"
+#include "memory/allocators/thread_caching_allocator.h"
+#include "runtime/data.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+namespace
+{
+  constexpr u8 ALLOCATE_CLEAR_VALUE = 0xCD;
+  constexpr u8 FREE_CLEAR_VALUE     = 0xDD;
+
+  // NOTE(kevinyu): The memory touching part of runtime::DefaultAllocatorProxy. The profile and
+  // frame allocation proxies need a running profiler and runtime.
+  using GuardProxy = soul::memory::MultiProxy<
+    soul::memory::CounterProxy,
+    soul::memory::ClearValuesProxy,
+    soul::memory::BoundGuardProxy>;
+
+  template <typename BackingAllocator>
+  using GuardAllocator = soul::memory::ProxyAllocator<BackingAllocator, GuardProxy>;
+
+  auto create_guard_proxy_config() -> GuardProxy::Config
+  {
+    return GuardProxy::Config(
+      soul::memory::CounterProxy::Config(),
+      soul::memory::ClearValuesProxy::Config{ALLOCATE_CLEAR_VALUE, FREE_CLEAR_VALUE},
+      soul::memory::BoundGuardProxy::Config());
+  }
+
+  using ThreadCachingDefaultAllocator = soul::memory::
+    ProxyAllocator<soul::memory::ThreadCachingAllocator, soul::runtime::DefaultAllocatorProxy>;
+
+  auto create_default_proxy_config() -> soul::runtime::DefaultAllocatorProxy::Config
+  {
+    return soul::runtime::DefaultAllocatorProxy::Config(
+      soul::memory::ProfileProxy::Config(),
+      soul::runtime::FrameAllocationProxy::Config(),
+      soul::memory::CounterProxy::Config(),
+      soul::memory::ClearValuesProxy::Config{ALLOCATE_CLEAR_VALUE, FREE_CLEAR_VALUE},
+      soul::memory::BoundGuardProxy::Config());
+  }
+
+  auto is_filled(const void* addr, usize size, u8 value) -> b8
+  {
+    const auto* bytes = soul::cast<const byte*>(addr);
+    return std::all_of(
+      bytes,
+      bytes + size,
+      [value](byte element)
+      {
+        return soul::cast<u8>(element) == value;
+      });
+  }
+
+  void test_alignment(soul::memory::Allocator* allocator)
+  {
+    const usize sizes[] = {1, 24, 100, 1000, 100000};
+    for (usize alignment = 1; alignment <= 4 * soul::ONE_KILOBYTE; alignment *= 2)
+    {
+      for (const usize size : sizes)
+      {
+        const auto allocation = allocator->try_allocate(size, alignment, "test"_str);
+        SOUL_TEST_ASSERT_NE(allocation.addr, nullptr);
+        SOUL_TEST_ASSERT_EQ(allocation.size, size);
+        SOUL_TEST_ASSERT_EQ(soul::cast<uptr>(allocation.addr) % alignment, 0)
+          << "Alignment : " << alignment << ", size : " << size;
+        SOUL_TEST_ASSERT_EQ(allocator->get_allocation_size(allocation.addr), size);
+        SOUL_TEST_ASSERT_TRUE(is_filled(allocation.addr, size, ALLOCATE_CLEAR_VALUE));
+        std::memset(allocation.addr, 0xAB, size);
+        allocator->deallocate(allocation.addr);
+      }
+    }
+  }
+
+  struct alignas(soul::SOUL_CACHELINE_SIZE) CacheLineObject
+  {
+    u64 values[3];
+  };
+} // namespace
+
+class TestProxyAllocator : public testing::Test
+{
+public:
+  soul::memory::MallocAllocator malloc_allocator{"Test malloc allocator"_str};
+  GuardAllocator<soul::memory::MallocAllocator> guard_allocator{
+    &malloc_allocator, create_guard_proxy_config()};
+};
+
+// NOTE(kevinyu): The stack of runtime::DefaultAllocator under SOUL_THREAD_CACHING_DEFAULT_ALLOCATOR.
+class TestThreadCachingDefaultAllocator : public testing::Test
+{
+public:
+  soul::memory::MallocAllocator malloc_allocator{"Test malloc allocator"_str};
+  soul::memory::ThreadCachingAllocator thread_caching_allocator{
+    "Test thread caching allocator"_str, &malloc_allocator};
+  ThreadCachingDefaultAllocator default_allocator{
+    &thread_caching_allocator, create_default_proxy_config()};
+};
+
+TEST_F(TestProxyAllocator, TestAlignment)
+{
+  test_alignment(&guard_allocator);
+}
+
+TEST_F(TestProxyAllocator, TestCacheLineAlignedObject)
+{
+  // NOTE(kevinyu): The runtime task pages are allocated like this and assert the alignment.
+  std::vector<CacheLineObject*> objects;
+  for (usize object_index = 0; object_index < 64; object_index++)
+  {
+    void* addr = guard_allocator.allocate(sizeof(CacheLineObject), alignof(CacheLineObject));
+    SOUL_TEST_ASSERT_EQ(soul::cast<uptr>(addr) % soul::SOUL_CACHELINE_SIZE, 0);
+    objects.push_back(new (addr) CacheLineObject{{object_index, object_index, object_index}});
+  }
+  for (CacheLineObject* object : objects)
+  {
+    SOUL_TEST_ASSERT_EQ(object->values[0], object->values[2]);
+    guard_allocator.deallocate(object);
+  }
+}
+
+TEST_F(TestThreadCachingDefaultAllocator, TestAlignment)
+{
+  test_alignment(&default_allocator);
+}
+
+TEST_F(TestThreadCachingDefaultAllocator, TestExactSize)
+{
+  // NOTE(kevinyu): Most of these sizes are rounded up by their size class. The clear values and
+  // bound guard proxies must still see the requested size, or they write over the back guard and
+  // check the wrong bytes on deallocate.
+  std::vector<std::pair<byte*, usize>> blocks;
+  for (usize size = 1; size <= 3 * soul::ONE_KILOBYTE; size += 13)
+  {
+    auto* addr = soul::cast<byte*>(default_allocator.allocate(size, alignof(std::max_align_t)));
+    SOUL_TEST_ASSERT_NE(addr, nullptr);
+    SOUL_TEST_ASSERT_EQ(default_allocator.get_allocation_size(addr), size);
+    SOUL_TEST_ASSERT_TRUE(is_filled(addr, size, ALLOCATE_CLEAR_VALUE));
+    std::memset(addr, soul::cast<u8>(size), size);
+    blocks.emplace_back(addr, size);
+  }
+  for (const auto& [addr, size] : blocks)
+  {
+    SOUL_TEST_ASSERT_TRUE(is_filled(addr, size, soul::cast<u8>(size)));
+    default_allocator.deallocate(addr);
+  }
+}
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/ring_queue.h"
+#include "core/string.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+static constexpr auto BLOCKING_CONFIG = soul::RingQueueConfig{.blocking_pop = true};
+
+using BlockingSpscQueue = soul::SpscQueue<u64, BLOCKING_CONFIG>;
+using BlockingMpmcQueue = soul::MpmcQueue<u64, BLOCKING_CONFIG>;
+
+template <typename QueueT>
+class TestRingQueue : public testing::Test
+{
+};
+
+using TestStringQueueTypes =
+  testing::Types<soul::SpscQueue<soul::String>, soul::MpmcQueue<soul::String>>;
+TYPED_TEST_SUITE(TestRingQueue, TestStringQueueTypes);
+
+TYPED_TEST(TestRingQueue, TestPushPop)
+{
+  TypeParam queue(5);
+  SOUL_TEST_ASSERT_EQ(queue.capacity(), 8);
+  SOUL_TEST_ASSERT_TRUE(queue.empty());
+  SOUL_TEST_ASSERT_FALSE(queue.try_pop().is_some());
+
+  for (usize i = 0; i < queue.capacity(); i++)
+  {
+    SOUL_TEST_ASSERT_TRUE(queue.try_push(soul::String::Format("long enough to allocate {}", i)));
+  }
+  SOUL_TEST_ASSERT_EQ(queue.size(), 8);
+
+  auto rejected = soul::String::From("rejected"_str);
+  SOUL_TEST_ASSERT_FALSE(queue.try_push(std::move(rejected)));
+  SOUL_TEST_ASSERT_EQ(rejected, soul::String::From("rejected"_str));
+
+  for (usize i = 0; i < 3; i++)
+  {
+    SOUL_TEST_ASSERT_EQ(
+      queue.try_pop().unwrap(), soul::String::Format("long enough to allocate {}", i));
+  }
+  SOUL_TEST_ASSERT_EQ(queue.size(), 5);
+
+  // NOTE(kevinyu): Values that are still queued are destroyed with the queue.
+  for (usize i = 0; i < 3; i++)
+  {
+    SOUL_TEST_ASSERT_TRUE(queue.try_push(soul::String::Format("wrap around value {}", i)));
+  }
+  SOUL_TEST_ASSERT_FALSE(queue.try_push(soul::String::From("rejected"_str)));
+}
+
+TYPED_TEST(TestRingQueue, TestBatch)
+{
+  TypeParam queue(8);
+  soul::String values[12];
+  for (usize i = 0; i < std::size(values); i++)
+  {
+    values[i] = soul::String::Format("batch value number {}", i);
+  }
+
+  SOUL_TEST_ASSERT_EQ(queue.push_batch({values, 5}), 5);
+  SOUL_TEST_ASSERT_EQ(queue.push_batch({values + 5, 7}), 3);
+  SOUL_TEST_ASSERT_EQ(queue.push_batch({values + 8, 4}), 0);
+  SOUL_TEST_ASSERT_EQ(values[8], soul::String::Format("batch value number {}", 8));
+
+  soul::String dst[16];
+  SOUL_TEST_ASSERT_EQ(queue.pop_batch({dst, 2}), 2);
+  SOUL_TEST_ASSERT_EQ(queue.pop_batch({dst + 2, 14}), 6);
+  SOUL_TEST_ASSERT_EQ(queue.pop_batch({dst + 8, 8}), 0);
+  for (usize i = 0; i < 8; i++)
+  {
+    SOUL_TEST_ASSERT_EQ(dst[i], soul::String::Format("batch value number {}", i));
+  }
+  SOUL_TEST_ASSERT_TRUE(queue.empty());
+}
+
+TEST(TestMpmcQueue, TestMinimumCapacity)
+{
+  soul::MpmcQueue<u64> queue(1);
+  SOUL_TEST_ASSERT_EQ(queue.capacity(), 2);
+  SOUL_TEST_ASSERT_TRUE(queue.try_push(1));
+  SOUL_TEST_ASSERT_TRUE(queue.try_push(2));
+  SOUL_TEST_ASSERT_FALSE(queue.try_push(3));
+  SOUL_TEST_ASSERT_EQ(queue.try_pop().unwrap(), 1);
+}
+
+// NOTE(kevinyu): Multithreaded tests only move u64 since TestAllocator is not thread safe. Threads
+// yield when the queue is full or empty so the tests also finish on a single core.
+TEST(TestSpscQueueMultithread, TestOrder)
+{
+  static constexpr u64 VALUE_COUNT = 200000;
+
+  soul::SpscQueue<u64> queue(256);
+  std::thread producer(
+    [&queue]()
+    {
+      u64 batch[16];
+      u64 value = 0;
+      while (value < VALUE_COUNT)
+      {
+        const u64 batch_size = std::min<u64>(value % 16 + 1, VALUE_COUNT - value);
+        for (u64 batch_index = 0; batch_index < batch_size; batch_index++)
+        {
+          batch[batch_index] = value + batch_index;
+        }
+        const usize push_count = queue.push_batch({batch, batch_size});
+        if (push_count == 0)
+        {
+          std::this_thread::yield();
+        }
+        value += push_count;
+      }
+    });
+
+  u64 expected_value = 0;
+  u64 batch[7];
+  while (expected_value < VALUE_COUNT)
+  {
+    const usize pop_count = queue.pop_batch({batch, 7});
+    if (pop_count == 0)
+    {
+      std::this_thread::yield();
+    }
+    for (usize batch_index = 0; batch_index < pop_count; batch_index++)
+    {
+      SOUL_TEST_ASSERT_EQ(batch[batch_index], expected_value);
+      expected_value++;
+    }
+  }
+  producer.join();
+  SOUL_TEST_ASSERT_TRUE(queue.empty());
+}
+
+TEST(TestMpmcQueueMultithread, TestProducerOrder)
+{
+  static constexpr usize PRODUCER_COUNT = 4;
+  static constexpr usize CONSUMER_COUNT = 4;
+  static constexpr u64 VALUE_COUNT      = 50000;
+
+  soul::MpmcQueue<u64> queue(128);
+  std::atomic<u64> pop_count = 0;
+  std::atomic<u64> value_sum = 0;
+  std::vector<std::thread> threads;
+  for (u64 producer_index = 0; producer_index < PRODUCER_COUNT; producer_index++)
+  {
+    threads.emplace_back(
+      [&queue, producer_index]()
+      {
+        u64 value = 0;
+        while (value < VALUE_COUNT)
+        {
+          if (queue.try_push((producer_index << 32) | value))
+          {
+            value++;
+          } else
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+  for (usize consumer_index = 0; consumer_index < CONSUMER_COUNT; consumer_index++)
+  {
+    threads.emplace_back(
+      [&queue, &pop_count, &value_sum]()
+      {
+        // NOTE(kevinyu): Values of one producer must be popped in the order they are pushed.
+        u64 next_values[PRODUCER_COUNT] = {};
+        u64 batch[5];
+        while (pop_count.load(std::memory_order_relaxed) < PRODUCER_COUNT * VALUE_COUNT)
+        {
+          const usize batch_size = queue.pop_batch({batch, 5});
+          if (batch_size == 0)
+          {
+            std::this_thread::yield();
+          }
+          for (usize batch_index = 0; batch_index < batch_size; batch_index++)
+          {
+            const u64 producer_index = batch[batch_index] >> 32;
+            const u64 value          = batch[batch_index] & 0xFFFFFFFF;
+            SOUL_TEST_ASSERT_LE(next_values[producer_index], value);
+            next_values[producer_index]  = value + 1;
+            value_sum                   += value;
+          }
+          pop_count.fetch_add(batch_size, std::memory_order_relaxed);
+        }
+      });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  SOUL_TEST_ASSERT_EQ(pop_count.load(), PRODUCER_COUNT * VALUE_COUNT);
+  SOUL_TEST_ASSERT_EQ(value_sum.load(), PRODUCER_COUNT * (VALUE_COUNT * (VALUE_COUNT - 1) / 2));
+  SOUL_TEST_ASSERT_TRUE(queue.empty());
+}
+
+template <typename QueueT>
+auto test_pop_wait(usize consumer_count)
+{
+  static constexpr u64 VALUE_COUNT = 20000;
+  static constexpr u64 STOP_VALUE  = ~u64(0);
+
+  QueueT queue(64);
+  std::atomic<u64> value_sum = 0;
+  std::vector<std::thread> consumers;
+  for (usize consumer_index = 0; consumer_index < consumer_count; consumer_index++)
+  {
+    consumers.emplace_back(
+      [&queue, &value_sum]()
+      {
+        for (u64 value = queue.pop_wait(); value != STOP_VALUE; value = queue.pop_wait())
+        {
+          value_sum += value;
+        }
+      });
+  }
+
+  const auto push = [&queue](u64 value)
+  {
+    while (!queue.try_push(value))
+    {
+      std::this_thread::yield();
+    }
+  };
+  for (u64 value = 0; value < VALUE_COUNT; value++)
+  {
+    push(value);
+  }
+  for (usize consumer_index = 0; consumer_index < consumer_count; consumer_index++)
+  {
+    push(STOP_VALUE);
+  }
+  for (std::thread& consumer : consumers)
+  {
+    consumer.join();
+  }
+  SOUL_TEST_ASSERT_EQ(value_sum.load(), VALUE_COUNT * (VALUE_COUNT - 1) / 2);
+}
+
+TEST(TestRingQueueMultithread, TestPopWait)
+{
+  SOUL_TEST_RUN(test_pop_wait<BlockingSpscQueue>(1));
+  SOUL_TEST_RUN(test_pop_wait<BlockingMpmcQueue>(4));
+}
@@ -10,6 +10,7 @@
 #include "core/panic.h"
 #include "core/robin_table.h"
 #include "core/string.h"
+#include "core/swiss_table.h"
 #include "core/type_traits.h"
 #include "core/util.h"
 #include "core/vector.h"
@@ -59,9 +60,16 @@ struct TestEntry
 
 static_assert(can_nontrivial_destruct_v<TestEntry>);
 
-using TestTable = soul::RobinTable<soul::String, TestEntry, TestEntry::GetKeyOp>;
-static_assert(ts_clone<TestTable>);
-static_assert(std::ranges::sized_range<TestTable>);
+using TestRobinTable = soul::RobinTable<soul::String, TestEntry, TestEntry::GetKeyOp>;
+static_assert(ts_clone<TestRobinTable>);
+static_assert(std::ranges::sized_range<TestRobinTable>);
+
+using TestSwissTable = soul::SwissTable<soul::String, TestEntry, TestEntry::GetKeyOp>;
+static_assert(ts_clone<TestSwissTable>);
+static_assert(std::ranges::sized_range<TestSwissTable>);
+
+// NOTE(kevinyu): Every scenario run against all the hash table backends
+using TestTableTypes = testing::Types<TestRobinTable, TestSwissTable>;
 
 template <typename TableT>
 auto verify_contain(const TableT& table, const typename TableT::value_type& entry)
@@ -98,9 +106,16 @@ auto verify_equal(const TableT& lhs, const TableT& rhs)
   }
 }
 
-TEST(TestRobinTableConstruction, TestDefaultConstruction)
+template <typename TableT>
+class TestRobinTableConstruction : public testing::Test
+{
+};
+
+TYPED_TEST_SUITE(TestRobinTableConstruction, TestTableTypes);
+
+TYPED_TEST(TestRobinTableConstruction, TestDefaultConstruction)
 {
-  TestTable test_table;
+  TypeParam test_table;
   SOUL_TEST_ASSERT_EQ(test_table.size(), 0);
   SOUL_TEST_ASSERT_EQ(test_table.begin(), test_table.end());
   SOUL_TEST_ASSERT_EQ(test_table.cbegin(), test_table.cend());
@@ -116,13 +131,13 @@ auto test_construction_with_capacity(usize capacity)
   SOUL_TEST_ASSERT_GE(test_table.capacity(), capacity);
 }
 
-TEST(TestRobinTableConstruction, TestConstructionWithCapacity)
+TYPED_TEST(TestRobinTableConstruction, TestConstructionWithCapacity)
 {
-  SOUL_TEST_RUN(test_construction_with_capacity<TestTable>(0));
-  SOUL_TEST_RUN(test_construction_with_capacity<TestTable>(100));
+  SOUL_TEST_RUN(test_construction_with_capacity<TypeParam>(0));
+  SOUL_TEST_RUN(test_construction_with_capacity<TypeParam>(100));
 }
 
-template <usize ArrSizeV>
+template <typename TableT, usize ArrSizeV>
 auto test_construction_from_array(Array<TestEntry, ArrSizeV>&& entries)
 {
   auto entry_vector = soul::Vector<TestEntry>::From(entries | soul::views::clone<TestEntry>());
@@ -134,7 +149,7 @@ auto test_construction_from_array(Array<TestEntry, ArrSizeV>&& entries)
       return std::ranges::lexicographical_compare(a.name.cview(), b.name.cview());
     });
 
-  const auto test_table = TestTable::From(entries | soul::views::move<TestEntry>());
+  const auto test_table = TableT::From(entries | soul::views::move<TestEntry>());
 
   SOUL_TEST_ASSERT_EQ(entry_vector.size(), test_table.size());
   for (const auto& entry : entry_vector)
@@ -155,21 +170,21 @@ auto test_construction_from_array(Array<TestEntry, ArrSizeV>&& entries)
   SOUL_TEST_ASSERT_EQ(entry_vector, table_entries);
 }
 
-TEST(TestRobinTableConstruction, TestConstructionFromRange)
+TYPED_TEST(TestRobinTableConstruction, TestConstructionFromRange)
 {
-  SOUL_TEST_RUN(test_construction_from_array(Array<TestEntry, 0>{}));
+  SOUL_TEST_RUN(test_construction_from_array<TypeParam>(Array<TestEntry, 0>{}));
 
-  SOUL_TEST_RUN(test_construction_from_array(Array{
+  SOUL_TEST_RUN(test_construction_from_array<TypeParam>(Array{
     TestEntry{"kevin"_str, TestObject(3)},
   }));
 
-  SOUL_TEST_RUN(test_construction_from_array(Array{
+  SOUL_TEST_RUN(test_construction_from_array<TypeParam>(Array{
     TestEntry{"kevin"_str, TestObject(3)},
     TestEntry{"yudi"_str, TestObject(10)},
     TestEntry{"utama"_str, TestObject(1000)},
   }));
 
-  SOUL_TEST_RUN(test_construction_from_array(Array{
+  SOUL_TEST_RUN(test_construction_from_array<TypeParam>(Array{
     TestEntry{"kevin29"_str, TestObject(1000)}, TestEntry{"kevin27"_str, TestObject(1000)},
     TestEntry{"kevin26"_str, TestObject(1000)}, TestEntry{"kevin25"_str, TestObject(1000)},
     TestEntry{"kevin24"_str, TestObject(1000)}, TestEntry{"kevin23"_str, TestObject(1000)},
@@ -187,11 +202,11 @@ TEST(TestRobinTableConstruction, TestConstructionFromRange)
   }));
 }
 
-TEST(TestRobinTableConstruction, TestMoveConstructor)
+TYPED_TEST(TestRobinTableConstruction, TestMoveConstructor)
 {
-  SOUL_TEST_RUN(test_move_constructor(TestTable()));
+  SOUL_TEST_RUN(test_move_constructor(TypeParam()));
   {
-    auto test_table = TestTable::From(
+    auto test_table = TypeParam::From(
       Array{
         TestEntry{"kevin29"_str, TestObject(1000)}, TestEntry{"kevin27"_str, TestObject(1000)},
         TestEntry{"kevin26"_str, TestObject(1000)}, TestEntry{"kevin25"_str, TestObject(1000)},
@@ -256,59 +271,61 @@ auto generate_random_entries(usize count) -> soul::Vector<TestEntry>
     });
 }
 
+template <typename TableT>
 class TestRobinTableManipulation : public testing::Test
 {
 public:
-  TestTable test_table1 =
-    TestTable::From(generate_random_entries(1) | soul::views::move<TestEntry>());
-  TestTable test_table2 =
-    TestTable::From(generate_random_entries(1000) | soul::views::move<TestEntry>());
+  TableT test_table1 = TableT::From(generate_random_entries(1) | soul::views::move<TestEntry>());
+  TableT test_table2 =
+    TableT::From(generate_random_entries(1000) | soul::views::move<TestEntry>());
 };
 
-TEST_F(TestRobinTableManipulation, TestClone)
+TYPED_TEST_SUITE(TestRobinTableManipulation, TestTableTypes);
+
+TYPED_TEST(TestRobinTableManipulation, TestClone)
 {
-  SOUL_TEST_RUN(test_clone(TestTable()));
-  SOUL_TEST_RUN(test_clone(test_table1));
-  SOUL_TEST_RUN(test_clone(test_table2));
+  SOUL_TEST_RUN(test_clone(TypeParam()));
+  SOUL_TEST_RUN(test_clone(this->test_table1));
+  SOUL_TEST_RUN(test_clone(this->test_table2));
 }
 
-TEST_F(TestRobinTableManipulation, TestCloneFrom)
+TYPED_TEST(TestRobinTableManipulation, TestCloneFrom)
 {
-  SOUL_TEST_RUN(test_clone_from(test_table1, test_table2));
-  SOUL_TEST_RUN(test_clone_from(test_table2, test_table1));
-  SOUL_TEST_RUN(test_clone_from(TestTable(), test_table1));
-  SOUL_TEST_RUN(test_clone_from(test_table1, TestTable()));
-  SOUL_TEST_RUN(test_clone_from(TestTable(), test_table2));
-  SOUL_TEST_RUN(test_clone_from(test_table2, TestTable()));
-  SOUL_TEST_RUN(test_clone_from(TestTable(), test_table2));
-  SOUL_TEST_RUN(test_clone_from(TestTable(), TestTable()));
+  SOUL_TEST_RUN(test_clone_from(this->test_table1, this->test_table2));
+  SOUL_TEST_RUN(test_clone_from(this->test_table2, this->test_table1));
+  SOUL_TEST_RUN(test_clone_from(TypeParam(), this->test_table1));
+  SOUL_TEST_RUN(test_clone_from(this->test_table1, TypeParam()));
+  SOUL_TEST_RUN(test_clone_from(TypeParam(), this->test_table2));
+  SOUL_TEST_RUN(test_clone_from(this->test_table2, TypeParam()));
+  SOUL_TEST_RUN(test_clone_from(TypeParam(), this->test_table2));
+  SOUL_TEST_RUN(test_clone_from(TypeParam(), TypeParam()));
 }
 
-TEST_F(TestRobinTableManipulation, TestMoveAssignment)
+TYPED_TEST(TestRobinTableManipulation, TestMoveAssignment)
 {
-  SOUL_TEST_RUN(test_move_assignment(test_table1, test_table2));
-  SOUL_TEST_RUN(test_move_assignment(test_table2, test_table1));
-  SOUL_TEST_RUN(test_move_assignment(TestTable(), test_table1));
-  SOUL_TEST_RUN(test_move_assignment(test_table1, TestTable()));
-  SOUL_TEST_RUN(test_move_assignment(TestTable(), test_table2));
-  SOUL_TEST_RUN(test_move_assignment(test_table2, TestTable()));
-  SOUL_TEST_RUN(test_move_assignment(TestTable(), test_table2));
-  SOUL_TEST_RUN(test_move_assignment(TestTable(), TestTable()));
+  SOUL_TEST_RUN(test_move_assignment(this->test_table1, this->test_table2));
+  SOUL_TEST_RUN(test_move_assignment(this->test_table2, this->test_table1));
+  SOUL_TEST_RUN(test_move_assignment(TypeParam(), this->test_table1));
+  SOUL_TEST_RUN(test_move_assignment(this->test_table1, TypeParam()));
+  SOUL_TEST_RUN(test_move_assignment(TypeParam(), this->test_table2));
+  SOUL_TEST_RUN(test_move_assignment(this->test_table2, TypeParam()));
+  SOUL_TEST_RUN(test_move_assignment(TypeParam(), this->test_table2));
+  SOUL_TEST_RUN(test_move_assignment(TypeParam(), TypeParam()));
 }
 
-TEST_F(TestRobinTableManipulation, TestSwap)
+TYPED_TEST(TestRobinTableManipulation, TestSwap)
 {
-  SOUL_TEST_RUN(test_swap(test_table1, test_table2));
-  SOUL_TEST_RUN(test_swap(test_table2, test_table1));
-  SOUL_TEST_RUN(test_swap(TestTable(), test_table1));
-  SOUL_TEST_RUN(test_swap(test_table1, TestTable()));
-  SOUL_TEST_RUN(test_swap(TestTable(), test_table2));
-  SOUL_TEST_RUN(test_swap(test_table2, TestTable()));
-  SOUL_TEST_RUN(test_swap(TestTable(), test_table2));
-  SOUL_TEST_RUN(test_swap(TestTable(), TestTable()));
+  SOUL_TEST_RUN(test_swap(this->test_table1, this->test_table2));
+  SOUL_TEST_RUN(test_swap(this->test_table2, this->test_table1));
+  SOUL_TEST_RUN(test_swap(TypeParam(), this->test_table1));
+  SOUL_TEST_RUN(test_swap(this->test_table1, TypeParam()));
+  SOUL_TEST_RUN(test_swap(TypeParam(), this->test_table2));
+  SOUL_TEST_RUN(test_swap(this->test_table2, TypeParam()));
+  SOUL_TEST_RUN(test_swap(TypeParam(), this->test_table2));
+  SOUL_TEST_RUN(test_swap(TypeParam(), TypeParam()));
 }
 
-TEST_F(TestRobinTableManipulation, TestClear)
+TYPED_TEST(TestRobinTableManipulation, TestClear)
 {
   const auto test_clear = []<typename TableT>(const TableT& table)
   {
@@ -323,12 +340,12 @@ TEST_F(TestRobinTableManipulation, TestClear)
     }
   };
 
-  SOUL_TEST_RUN(test_clear(TestTable()));
-  SOUL_TEST_RUN(test_clear(test_table1));
-  SOUL_TEST_RUN(test_clear(test_table2));
+  SOUL_TEST_RUN(test_clear(TypeParam()));
+  SOUL_TEST_RUN(test_clear(this->test_table1));
+  SOUL_TEST_RUN(test_clear(this->test_table2));
 }
 
-TEST_F(TestRobinTableManipulation, TestCleanup)
+TYPED_TEST(TestRobinTableManipulation, TestCleanup)
 {
   const auto test_cleanup = []<typename TableT>(const TableT& table)
   {
@@ -345,23 +362,23 @@ TEST_F(TestRobinTableManipulation, TestCleanup)
     SOUL_TEST_ASSERT_EQ(test_table.capacity(), 0);
   };
 
-  SOUL_TEST_RUN(test_cleanup(TestTable()));
-  SOUL_TEST_RUN(test_cleanup(test_table1));
-  SOUL_TEST_RUN(test_cleanup(test_table2));
+  SOUL_TEST_RUN(test_cleanup(TypeParam()));
+  SOUL_TEST_RUN(test_cleanup(this->test_table1));
+  SOUL_TEST_RUN(test_cleanup(this->test_table2));
 }
 
-TEST_F(TestRobinTableManipulation, TestReserve)
+TYPED_TEST(TestRobinTableManipulation, TestReserve)
 {
-  SOUL_TEST_RUN(test_reserve(TestTable(), 10));
-  SOUL_TEST_RUN(test_reserve(test_table1, 0));
-  SOUL_TEST_RUN(test_reserve(test_table1, 10));
-  SOUL_TEST_RUN(test_reserve(test_table2, 0));
-  SOUL_TEST_RUN(test_reserve(test_table2, 1));
-  SOUL_TEST_RUN(test_reserve(test_table2, test_table2.size() / 2));
-  SOUL_TEST_RUN(test_reserve(test_table2, test_table2.size() * 2));
+  SOUL_TEST_RUN(test_reserve(TypeParam(), 10));
+  SOUL_TEST_RUN(test_reserve(this->test_table1, 0));
+  SOUL_TEST_RUN(test_reserve(this->test_table1, 10));
+  SOUL_TEST_RUN(test_reserve(this->test_table2, 0));
+  SOUL_TEST_RUN(test_reserve(this->test_table2, 1));
+  SOUL_TEST_RUN(test_reserve(this->test_table2, this->test_table2.size() / 2));
+  SOUL_TEST_RUN(test_reserve(this->test_table2, this->test_table2.size() * 2));
 }
 
-TEST_F(TestRobinTableManipulation, TestInsert)
+TYPED_TEST(TestRobinTableManipulation, TestInsert)
 {
   const auto test_insert = []<typename TableT>(const TableT& table)
   {
@@ -390,46 +407,93 @@ TEST_F(TestRobinTableManipulation, TestInsert)
     SOUL_TEST_ASSERT_EQ(test_table.size(), initial_size + 1 + RANDOM_INSERT_COUNT);
   };
 
-  SOUL_TEST_RUN(test_insert(TestTable()));
-  SOUL_TEST_RUN(test_insert(test_table1));
-  SOUL_TEST_RUN(test_insert(test_table2));
+  SOUL_TEST_RUN(test_insert(TypeParam()));
+  SOUL_TEST_RUN(test_insert(this->test_table1));
+  SOUL_TEST_RUN(test_insert(this->test_table2));
 }
 
-TEST_F(TestRobinTableManipulation, TestRemove)
+TYPED_TEST(TestRobinTableManipulation, TestRemove)
 {
   {
-    auto test_table = TestTable();
+    auto test_table = TypeParam();
     test_table.remove("soul_test_str"_str);
     SOUL_TEST_RUN(verify_not_contain(test_table, "soul_test_str"_str));
     SOUL_TEST_ASSERT_EQ(test_table.size(), 0);
   }
 
   {
-    const auto name = test_table1.begin()->name.clone();
-    test_table1.remove(name);
-    SOUL_TEST_RUN(verify_not_contain(test_table1, name));
-    SOUL_TEST_ASSERT_EQ(test_table1.size(), 0);
+    const auto name = this->test_table1.begin()->name.clone();
+    this->test_table1.remove(name);
+    SOUL_TEST_RUN(verify_not_contain(this->test_table1, name));
+    SOUL_TEST_ASSERT_EQ(this->test_table1.size(), 0);
   }
 
   {
-    const auto initial_size = test_table2.size();
-    auto middle_iter        = test_table2.begin();
+    const auto initial_size = this->test_table2.size();
+    auto middle_iter        = this->test_table2.begin();
     for (auto i = 0; i < initial_size / 2; i++)
     {
       middle_iter++;
     }
     const auto names = Array{
-      test_table2.begin()->name.clone(),
+      this->test_table2.begin()->name.clone(),
       middle_iter->name.clone(),
     };
 
     for (const auto& name : names)
     {
-      test_table2.remove(name);
+      this->test_table2.remove(name);
     }
     for (const auto& name : names)
     {
-      SOUL_TEST_RUN(verify_not_contain(test_table2, name));
+      SOUL_TEST_RUN(verify_not_contain(this->test_table2, name));
+    }
+  }
+}
+
+TYPED_TEST(TestRobinTableManipulation, TestRemoveAndInsert)
+{
+  auto test_table         = this->test_table2.clone();
+  const auto initial_size = test_table.size();
+
+  soul::Vector<TestEntry> removed_entries;
+  usize entry_index = 0;
+  for (const auto& entry : this->test_table2)
+  {
+    if (entry_index % 2 == 0)
+    {
+      removed_entries.push_back(entry.clone());
+    }
+    entry_index++;
+  }
+  for (const auto& entry : removed_entries)
+  {
+    test_table.remove(entry.name);
+  }
+  SOUL_TEST_ASSERT_EQ(test_table.size(), initial_size - removed_entries.size());
+  for (const auto& entry : removed_entries)
+  {
+    SOUL_TEST_RUN(verify_not_contain(test_table, entry.name));
+  }
+
+  // NOTE(kevinyu): Reinsert into the slots that are just freed, then remove and insert repeatedly
+  // so the table has to reuse or drop the removed slots.
+  for (const auto& entry : removed_entries)
+  {
+    test_table.insert(entry.clone());
+  }
+  SOUL_TEST_RUN(verify_equal(test_table, this->test_table2));
+
+  for (usize round = 0; round < 8; round++)
+  {
+    for (const auto& entry : removed_entries)
+    {
+      test_table.remove(entry.name);
+    }
+    for (const auto& entry : removed_entries)
+    {
+      test_table.insert(entry.clone());
     }
   }
+  SOUL_TEST_RUN(verify_equal(test_table, this->test_table2));
 }
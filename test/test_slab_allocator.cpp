@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+#include "memory/allocators/proxy_allocator.h"
+#include "memory/allocators/slab_allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+using soul::memory::SlabAllocator;
+
+namespace
+{
+  struct Block
+  {
+    byte* addr;
+    usize size;
+    u8 pattern;
+  };
+
+  void fill_block(const Block& block)
+  {
+    std::memset(block.addr, block.pattern, block.size);
+  }
+
+  auto is_block_intact(const Block& block) -> b8
+  {
+    return std::all_of(
+      block.addr,
+      block.addr + block.size,
+      [pattern = block.pattern](byte value)
+      {
+        return soul::cast<u8>(value) == pattern;
+      });
+  }
+
+  auto allocate_block(soul::memory::Allocator* allocator, usize size, u8 pattern) -> Block
+  {
+    const auto allocation = allocator->try_allocate(size, alignof(std::max_align_t), "test"_str);
+    const Block block     = {soul::cast<byte*>(allocation.addr), size, pattern};
+    if (block.addr != nullptr)
+    {
+      fill_block(block);
+    }
+    return block;
+  }
+
+  auto get_expected_block_size(usize size) -> usize
+  {
+    return std::bit_ceil(std::max(size, SlabAllocator::MIN_BLOCK_SIZE));
+  }
+
+  // NOTE(kevinyu): Every thread allocate blocks and hand them to the next thread, which check the
+  // content and free them. Return the number of corrupted or failed blocks.
+  auto run_cross_thread_free(soul::memory::Allocator* allocator, usize max_size) -> usize
+  {
+    static constexpr usize THREAD_COUNT = 4;
+    static constexpr usize ROUND_COUNT  = 200;
+    static constexpr usize BLOCK_COUNT  = 64;
+
+    std::mutex mailbox_mutex;
+    std::vector<Block> mailboxes[THREAD_COUNT];
+    std::atomic<usize> error_count = 0;
+
+    std::vector<std::thread> threads;
+    for (usize thread_index = 0; thread_index < THREAD_COUNT; thread_index++)
+    {
+      threads.emplace_back(
+        [&, thread_index]()
+        {
+          std::mt19937 random_engine(soul::cast<u32>(thread_index));
+          std::uniform_int_distribution<usize> size_distribution(1, max_size);
+          for (usize round = 0; round < ROUND_COUNT; round++)
+          {
+            std::vector<Block> blocks;
+            for (usize block_index = 0; block_index < BLOCK_COUNT; block_index++)
+            {
+              const auto pattern = soul::cast<u8>(thread_index * BLOCK_COUNT + block_index);
+              const Block block =
+                allocate_block(allocator, size_distribution(random_engine), pattern);
+              if (block.addr == nullptr)
+              {
+                error_count++;
+                continue;
+              }
+              blocks.push_back(block);
+            }
+
+            std::vector<Block> received_blocks;
+            {
+              std::lock_guard guard(mailbox_mutex);
+              auto& next_mailbox = mailboxes[(thread_index + 1) % THREAD_COUNT];
+              next_mailbox.insert(next_mailbox.end(), blocks.begin(), blocks.end());
+              std::swap(received_blocks, mailboxes[thread_index]);
+            }
+            for (const Block& block : received_blocks)
+            {
+              if (!is_block_intact(block))
+              {
+                error_count++;
+              }
+              allocator->deallocate(block.addr);
+            }
+          }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (const auto& mailbox : mailboxes)
+    {
+      for (const Block& block : mailbox)
+      {
+        if (!is_block_intact(block))
+        {
+          error_count++;
+        }
+        allocator->deallocate(block.addr);
+      }
+    }
+    return error_count.load();
+  }
+} // namespace
+
+class TestSlabAllocator : public testing::Test
+{
+public:
+  TestAllocator backing_allocator{"Test backing allocator"_str};
+  SlabAllocator allocator{"Test slab allocator"_str, &backing_allocator, SlabAllocator::Config()};
+};
+
+TEST_F(TestSlabAllocator, TestSizeClassRounding)
+{
+  for (usize size = 1; size <= SlabAllocator::DEFAULT_MAX_BLOCK_SIZE; size += 5)
+  {
+    SOUL_TEST_MESSAGE(std::to_string(size).c_str());
+    const Block block = allocate_block(&allocator, size, soul::cast<u8>(size));
+    SOUL_TEST_ASSERT_NE(block.addr, nullptr);
+    const usize block_size = get_expected_block_size(size);
+    SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(block.addr), block_size);
+    SOUL_TEST_ASSERT_EQ(soul::cast<uptr>(block.addr) % block_size, 0);
+    SOUL_TEST_ASSERT_TRUE(is_block_intact(block));
+    allocator.deallocate(block.addr);
+  }
+}
+
+TEST_F(TestSlabAllocator, TestAlignment)
+{
+  for (usize alignment = 1; alignment <= 4 * SlabAllocator::DEFAULT_MAX_BLOCK_SIZE;
+       alignment *= 2)
+  {
+    const auto allocation = allocator.try_allocate(24, alignment, "test"_str);
+    SOUL_TEST_ASSERT_NE(allocation.addr, nullptr);
+    SOUL_TEST_ASSERT_EQ(allocation.size, 24);
+    SOUL_TEST_ASSERT_EQ(soul::cast<uptr>(allocation.addr) % alignment, 0)
+      << "Alignment : " << alignment;
+    std::memset(allocation.addr, 0xAB, allocation.size);
+    allocator.deallocate(allocation.addr);
+  }
+}
+
+TEST_F(TestSlabAllocator, TestDeallocateReuse)
+{
+  const Block first_block = allocate_block(&allocator, 100, 0x11);
+  allocator.deallocate(first_block.addr);
+  const Block second_block = allocate_block(&allocator, 120, 0x22);
+  SOUL_TEST_ASSERT_EQ(second_block.addr, first_block.addr);
+  allocator.deallocate(second_block.addr);
+}
+
+TEST_F(TestSlabAllocator, TestLargeAllocation)
+{
+  const usize sizes[] = {
+    SlabAllocator::DEFAULT_MAX_BLOCK_SIZE + 1,
+    SlabAllocator::DEFAULT_SLAB_SIZE,
+    4 * soul::ONE_MEGABYTE + 3};
+  for (const usize size : sizes)
+  {
+    const int alloc_count = backing_allocator.allocCount;
+    const int free_count  = backing_allocator.freeCount;
+    const Block block     = allocate_block(&allocator, size, soul::cast<u8>(size));
+    SOUL_TEST_ASSERT_NE(block.addr, nullptr);
+    SOUL_TEST_ASSERT_EQ(backing_allocator.allocCount, alloc_count + 1);
+    SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(block.addr), size);
+    SOUL_TEST_ASSERT_TRUE(is_block_intact(block));
+    allocator.deallocate(block.addr);
+    SOUL_TEST_ASSERT_EQ(backing_allocator.freeCount, free_count + 1);
+  }
+}
+
+TEST_F(TestSlabAllocator, TestResetReuse)
+{
+  static constexpr usize BLOCK_COUNT = 2000;
+  static constexpr usize BLOCK_SIZE  = 200;
+
+  std::set<byte*> block_addrs;
+  for (usize block_index = 0; block_index < BLOCK_COUNT; block_index++)
+  {
+    const Block block = allocate_block(&allocator, BLOCK_SIZE, 0x33);
+    SOUL_TEST_ASSERT_NE(block.addr, nullptr);
+    block_addrs.insert(block.addr);
+  }
+  const Block large_block = allocate_block(&allocator, 4 * soul::ONE_MEGABYTE, 0x44);
+  SOUL_TEST_ASSERT_NE(large_block.addr, nullptr);
+  const int alloc_count = backing_allocator.allocCount;
+  const int free_count  = backing_allocator.freeCount;
+
+  // NOTE(kevinyu): reset() free the large block and keep the slabs, so the same blocks are handed
+  // out again without asking the backing allocator.
+  allocator.reset();
+  SOUL_TEST_ASSERT_EQ(backing_allocator.freeCount, free_count + 1);
+  for (usize block_index = 0; block_index < BLOCK_COUNT; block_index++)
+  {
+    const Block block = allocate_block(&allocator, BLOCK_SIZE, 0x55);
+    SOUL_TEST_ASSERT_TRUE(block_addrs.contains(block.addr));
+  }
+  SOUL_TEST_ASSERT_EQ(backing_allocator.allocCount, alloc_count);
+  allocator.reset();
+}
+
+TEST_F(TestSlabAllocator, TestThreadMagazine)
+{
+  SlabAllocator magazine_allocator(
+    "Test magazine slab allocator"_str,
+    &backing_allocator,
+    SlabAllocator::Config{.thread_magazine = true});
+  SOUL_TEST_ASSERT_EQ(
+    run_cross_thread_free(&magazine_allocator, SlabAllocator::DEFAULT_MAX_BLOCK_SIZE * 2), 0);
+}
+
+TEST_F(TestSlabAllocator, TestProxyBacking)
+{
+  // NOTE(kevinyu): Without thread_magazine the slab allocator is shared behind a MutexProxy.
+  using SlabProxy =
+    soul::memory::MultiProxy<soul::memory::MutexProxy, soul::memory::CounterProxy>;
+  soul::memory::ProxyAllocator<SlabAllocator, SlabProxy> proxy_allocator(
+    &allocator,
+    SlabProxy::Config(soul::memory::MutexProxy::Config(), soul::memory::CounterProxy::Config()));
+  SOUL_TEST_ASSERT_EQ(
+    run_cross_thread_free(&proxy_allocator, SlabAllocator::DEFAULT_MAX_BLOCK_SIZE * 2), 0);
+
+  const Block block = allocate_block(&proxy_allocator, 100, 0x66);
+  SOUL_TEST_ASSERT_EQ(
+    proxy_allocator.get_allocation_size(block.addr), get_expected_block_size(100));
+  proxy_allocator.deallocate(block.addr);
+}
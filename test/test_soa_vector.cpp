@@ -120,3 +120,28 @@ TEST(TestSoaVector, TestSoaVector)
     SOUL_TEST_ASSERT_TRUE(soa_vector_from_move.empty());
   }
 }
+
+TEST(TestSoaVector, TestColumnAlignment)
+{
+  static constexpr auto CONFIG = soul::SoaVectorConfig{.column_alignment = 64};
+  using AlignedSoaVector       = soul::SoaVector<TestStructure, soul::memory::Allocator, CONFIG>;
+
+  AlignedSoaVector soa_vector;
+  static constexpr auto PUSH_BACK_COUNT = 100;
+  auto u64_sequence                     = generate_random_sequence<u64>(PUSH_BACK_COUNT);
+  auto testobj_sequence                 = generate_random_sequence<TestObject>(PUSH_BACK_COUNT);
+  auto i32_sequence                     = generate_random_sequence<i32>(PUSH_BACK_COUNT);
+  for (auto index = 0; index < PUSH_BACK_COUNT; index++)
+  {
+    soa_vector.push_back(u64_sequence[index], testobj_sequence[index].clone(), i32_sequence[index]);
+
+    // NOTE(kevinyu): Every column must stay aligned after each growth.
+    SOUL_TEST_ASSERT_EQ(uptr(soa_vector.span<0>().data()) % 64, 0);
+    SOUL_TEST_ASSERT_EQ(uptr(soa_vector.span<1>().data()) % 64, 0);
+    SOUL_TEST_ASSERT_EQ(uptr(soa_vector.span<2>().data()) % 64, 0);
+  }
+
+  SOUL_TEST_ASSERT_TRUE(std::ranges::equal(soa_vector.span<0>(), u64_sequence));
+  SOUL_TEST_ASSERT_TRUE(std::ranges::equal(soa_vector.span<1>(), testobj_sequence));
+  SOUL_TEST_ASSERT_TRUE(std::ranges::equal(soa_vector.span<2>(), i32_sequence));
+}
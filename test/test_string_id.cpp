@@ -0,0 +1,127 @@
+#include <format>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/hash.h"
+#include "core/hash_map.h"
+#include "core/string.h"
+#include "core/string_id.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+TEST(TestStringIdConstruction, TestDefaultConstructor)
+{
+  const soul::StringId id;
+  SOUL_TEST_ASSERT_TRUE(id.empty());
+  SOUL_TEST_ASSERT_EQ(id.size(), 0);
+  SOUL_TEST_ASSERT_STREQ(id.c_str(), "");
+  SOUL_TEST_ASSERT_TRUE(id == soul::StringId::From(""_str));
+}
+
+TEST(TestStringIdConstruction, TestFrom)
+{
+  const auto id = soul::StringId::From("render_pass"_str);
+  SOUL_TEST_ASSERT_FALSE(id.empty());
+  SOUL_TEST_ASSERT_EQ(id.size(), 11);
+  SOUL_TEST_ASSERT_STREQ(id.c_str(), "render_pass");
+  SOUL_TEST_ASSERT_TRUE(id.cview() == "render_pass"_str);
+  SOUL_TEST_ASSERT_EQ(id.hash_code(), soul::hash(StringView("render_pass"_str)));
+}
+
+TEST(TestStringIdEquality, TestSameContentSameId)
+{
+  const auto string = String::From("albedo_metallic"_str);
+  const auto id1    = soul::StringId::From("albedo_metallic"_str);
+  const auto id2    = soul::StringId::From(string.cview());
+  SOUL_TEST_ASSERT_TRUE(id1 == id2);
+  SOUL_TEST_ASSERT_EQ(id1.c_str(), id2.c_str());
+  SOUL_TEST_ASSERT_NE(id2.c_str(), string.data());
+
+  const auto id3 = soul::StringId::From("albedo_metal"_str);
+  SOUL_TEST_ASSERT_FALSE(id1 == id3);
+
+  // NOTE(kevinyu): Prefix of an interned string must get its own entry.
+  const auto id4 = soul::StringId::From(StringView(string.data(), 6));
+  SOUL_TEST_ASSERT_STREQ(id4.c_str(), "albedo");
+  SOUL_TEST_ASSERT_FALSE(id1 == id4);
+}
+
+TEST(TestStringIdLiteral, TestLiteral)
+{
+  const auto id = "normal_roughness"_sid;
+  SOUL_TEST_ASSERT_TRUE(id == soul::StringId::From("normal_roughness"_str));
+  SOUL_TEST_ASSERT_TRUE(id == "normal_roughness"_sid);
+  SOUL_TEST_ASSERT_FALSE(id == "normal"_sid);
+  SOUL_TEST_ASSERT_TRUE(""_sid == soul::StringId());
+}
+
+TEST(TestStringIdHashMap, TestHashMapKey)
+{
+  HashMap<soul::StringId, u32> map;
+  for (u32 i = 0; i < 100; i++)
+  {
+    map.insert(soul::StringId::From(String::Format("channel_{}", i).cview()), i);
+  }
+  SOUL_TEST_ASSERT_EQ(map.size(), 100);
+  for (u32 i = 0; i < 100; i++)
+  {
+    const auto id = soul::StringId::From(String::Format("channel_{}", i).cview());
+    SOUL_TEST_ASSERT_TRUE(map.contains(id));
+    SOUL_TEST_ASSERT_EQ(map[id], i);
+  }
+  SOUL_TEST_ASSERT_FALSE(map.contains("channel_100"_sid));
+}
+
+TEST(TestStringIdMultithread, TestConcurrentFrom)
+{
+  static constexpr usize THREAD_COUNT = 8;
+  static constexpr usize NAME_COUNT   = 1024;
+
+  // NOTE(kevinyu): TestAllocator is not thread safe, so names are built with std::format.
+  std::vector<std::vector<soul::StringId>> thread_ids(THREAD_COUNT);
+  std::vector<std::thread> threads;
+  for (usize thread_index = 0; thread_index < THREAD_COUNT; thread_index++)
+  {
+    threads.emplace_back(
+      [&ids = thread_ids[thread_index], thread_index]()
+      {
+        for (usize name_index = 0; name_index < NAME_COUNT; name_index++)
+        {
+          const usize name_key   = (name_index * 7 + thread_index) % NAME_COUNT;
+          const std::string name = std::format("concurrent_name_{}", name_key);
+          ids.push_back(soul::StringId::From(StringView(name.data(), name.size())));
+        }
+      });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (usize thread_index = 0; thread_index < THREAD_COUNT; thread_index++)
+  {
+    for (usize name_index = 0; name_index < NAME_COUNT; name_index++)
+    {
+      const usize name_key    = (name_index * 7 + thread_index) % NAME_COUNT;
+      const std::string name  = std::format("concurrent_name_{}", name_key);
+      const soul::StringId id = thread_ids[thread_index][name_index];
+      SOUL_TEST_ASSERT_STREQ(id.c_str(), name.c_str());
+      SOUL_TEST_ASSERT_TRUE(id == soul::StringId::From(StringView(name.data(), name.size())));
+    }
+  }
+}
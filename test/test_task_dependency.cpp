@@ -0,0 +1,246 @@
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "memory/allocator.h"
+#include "runtime/runtime.h"
+
+#include "runtime_util.h"
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    if (runtime::is_worker_thread())
+    {
+      return runtime::get_context_allocator();
+    }
+    return &test_allocator;
+  }
+} // namespace soul
+
+using namespace soul;
+
+namespace
+{
+  // NOTE(kevinyu): Keep the producer busy for a while, so the consumer is usually run before its
+  // dependencies are finished.
+  void spin_work(u32 iteration_count)
+  {
+    std::atomic<u32> counter = 0;
+    for (u32 iteration_index = 0; iteration_index < iteration_count; iteration_index++)
+    {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+} // namespace
+
+class TestTaskDependency : public testing::Test
+{
+public:
+  TestRuntime test_runtime{runtime::Config{.threadCount = 4}};
+};
+
+TEST_F(TestTaskDependency, TestFanIn)
+{
+  static constexpr u32 PRODUCER_COUNT = 64;
+
+  std::vector<i32> values(PRODUCER_COUNT, 0);
+  std::vector<runtime::TaskID> producers;
+  for (u32 producer_index = 0; producer_index < PRODUCER_COUNT; producer_index++)
+  {
+    producers.push_back(runtime::create_task(
+      runtime::TaskID::ROOT(),
+      [&values, producer_index](runtime::TaskID /* task_id */)
+      {
+        spin_work(1000 * (producer_index % 8));
+        values[producer_index] = soul::cast<i32>(producer_index) + 1;
+      }));
+  }
+
+  i32 sum                         = 0;
+  std::atomic<u32> complete_count = 0;
+  const runtime::TaskID consumer  = runtime::create_task(
+    runtime::TaskID::ROOT(),
+    [&](runtime::TaskID /* task_id */)
+    {
+      for (const runtime::TaskID producer : producers)
+      {
+        if (runtime::System::get().is_task_complete(producer))
+        {
+          complete_count.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      sum = std::accumulate(values.begin(), values.end(), 0);
+    });
+  for (const runtime::TaskID producer : producers)
+  {
+    runtime::add_task_dependency(consumer, producer);
+  }
+
+  runtime::run_task(consumer);
+  for (const runtime::TaskID producer : producers)
+  {
+    runtime::run_task(producer);
+  }
+  runtime::wait_task(consumer);
+
+  SOUL_TEST_ASSERT_EQ(complete_count.load(), PRODUCER_COUNT);
+  SOUL_TEST_ASSERT_EQ(sum, soul::cast<i32>(PRODUCER_COUNT * (PRODUCER_COUNT + 1) / 2));
+  runtime::begin_frame();
+}
+
+TEST_F(TestTaskDependency, TestCompletedDependency)
+{
+  i32 value                        = 0;
+  const runtime::TaskID dependency = runtime::create_and_run_task(
+    runtime::TaskID::ROOT(),
+    [&value](runtime::TaskID /* task_id */)
+    {
+      value = 42;
+    });
+  runtime::wait_task(dependency);
+  SOUL_TEST_ASSERT_TRUE(runtime::System::get().is_task_complete(dependency));
+
+  // NOTE(kevinyu): Depending on a finished task must not hold the consumer back.
+  i32 result                     = 0;
+  const runtime::TaskID consumer = runtime::create_and_run_task(
+    runtime::TaskID::ROOT(),
+    {dependency},
+    [&value, &result](runtime::TaskID /* task_id */)
+    {
+      result = value + 1;
+    });
+  runtime::wait_task(consumer);
+  SOUL_TEST_ASSERT_EQ(result, 43);
+  runtime::begin_frame();
+}
+
+TEST_F(TestTaskDependency, TestDependencyCompleteConcurrently)
+{
+  static constexpr u32 FRAME_COUNT          = 16;
+  static constexpr u32 PAIR_COUNT_PER_FRAME = 256;
+
+  // NOTE(kevinyu): The producer is already running when the dependency is added, so it finish
+  // before, during or after add_task_dependency(). The consumer must run exactly once and always
+  // after the producer.
+  u32 violation_count = 0;
+  for (u32 frame_index = 0; frame_index < FRAME_COUNT; frame_index++)
+  {
+    std::vector<std::atomic<u32>> states(PAIR_COUNT_PER_FRAME);
+    std::vector<runtime::TaskID> consumers;
+    for (u32 pair_index = 0; pair_index < PAIR_COUNT_PER_FRAME; pair_index++)
+    {
+      std::atomic<u32>* state        = &states[pair_index];
+      const runtime::TaskID consumer = runtime::create_task(
+        runtime::TaskID::ROOT(),
+        [state](runtime::TaskID /* task_id */)
+        {
+          u32 expected = 1;
+          state->compare_exchange_strong(expected, 2, std::memory_order_relaxed);
+        });
+      const runtime::TaskID producer = runtime::create_and_run_task(
+        runtime::TaskID::ROOT(),
+        [state, pair_index](runtime::TaskID /* task_id */)
+        {
+          spin_work(pair_index % 4 * 100);
+          state->store(1, std::memory_order_relaxed);
+        });
+      runtime::add_task_dependency(consumer, producer);
+      runtime::run_task(consumer);
+      consumers.push_back(consumer);
+    }
+    for (const runtime::TaskID consumer : consumers)
+    {
+      runtime::wait_task(consumer);
+    }
+    for (const std::atomic<u32>& state : states)
+    {
+      if (state.load(std::memory_order_relaxed) != 2)
+      {
+        violation_count++;
+      }
+    }
+    runtime::begin_frame();
+  }
+  SOUL_TEST_ASSERT_EQ(violation_count, 0);
+}
+
+TEST_F(TestTaskDependency, TestChainOrdering)
+{
+  static constexpr u32 TASK_COUNT = 256;
+
+  // NOTE(kevinyu): Every task depend on the previous one, so the plain vector is only touched by
+  // one task at a time and the order is the chain order.
+  std::vector<u32> order;
+  std::vector<runtime::TaskID> tasks;
+  for (u32 task_index = 0; task_index < TASK_COUNT; task_index++)
+  {
+    const runtime::TaskID task_id = runtime::create_task(
+      runtime::TaskID::ROOT(),
+      [&order, task_index](runtime::TaskID /* task_id */)
+      {
+        order.push_back(task_index);
+      });
+    if (!tasks.empty())
+    {
+      runtime::add_task_dependency(task_id, tasks.back());
+    }
+    tasks.push_back(task_id);
+  }
+  // NOTE(kevinyu): Run in reverse, so every task is run before its dependency is.
+  for (auto it = tasks.rbegin(); it != tasks.rend(); ++it)
+  {
+    runtime::run_task(*it);
+  }
+  runtime::wait_task(tasks.back());
+
+  SOUL_TEST_ASSERT_EQ(order.size(), TASK_COUNT);
+  for (u32 task_index = 0; task_index < TASK_COUNT; task_index++)
+  {
+    SOUL_TEST_ASSERT_EQ(order[task_index], task_index);
+  }
+  runtime::begin_frame();
+}
+
+TEST_F(TestTaskDependency, TestDependencyWaitForChildren)
+{
+  static constexpr u32 CHILD_COUNT = 32;
+
+  // NOTE(kevinyu): A dependency is only finished when all of its children are.
+  std::atomic<u32> child_done_count = 0;
+  const runtime::TaskID parent      = runtime::create_task(
+    runtime::TaskID::ROOT(),
+    [&child_done_count](runtime::TaskID task_id)
+    {
+      for (u32 child_index = 0; child_index < CHILD_COUNT; child_index++)
+      {
+        runtime::create_and_run_task(
+          task_id,
+          [&child_done_count, child_index](runtime::TaskID /* task_id */)
+          {
+            spin_work(child_index * 100);
+            child_done_count.fetch_add(1, std::memory_order_relaxed);
+          });
+      }
+    });
+
+  u32 observed_count             = 0;
+  const runtime::TaskID consumer = runtime::create_and_run_task(
+    runtime::TaskID::ROOT(),
+    {parent},
+    [&child_done_count, &observed_count](runtime::TaskID /* task_id */)
+    {
+      observed_count = child_done_count.load(std::memory_order_relaxed);
+    });
+  runtime::run_task(parent);
+  runtime::wait_task(consumer);
+
+  SOUL_TEST_ASSERT_EQ(observed_count, CHILD_COUNT);
+  runtime::begin_frame();
+}
@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/config.h"
+#include "core/type.h"
+#include "memory/allocator.h"
+#include "memory/allocators/malloc_allocator.h"
+#include "memory/allocators/thread_caching_allocator.h"
+
+#include "util.h"
+
+namespace soul
+{
+  auto get_default_allocator() -> memory::Allocator*
+  {
+    static TestAllocator test_allocator("Test default allocator"_str);
+    return &test_allocator;
+  }
+} // namespace soul
+
+using soul::memory::ThreadCachingAllocator;
+
+namespace
+{
+  struct Block
+  {
+    byte* addr;
+    usize size;
+    u8 pattern;
+  };
+
+  void fill_block(const Block& block)
+  {
+    std::memset(block.addr, block.pattern, block.size);
+  }
+
+  auto is_block_intact(const Block& block) -> b8
+  {
+    return std::all_of(
+      block.addr,
+      block.addr + block.size,
+      [pattern = block.pattern](byte value)
+      {
+        return soul::cast<u8>(value) == pattern;
+      });
+  }
+
+  auto allocate_block(ThreadCachingAllocator* allocator, usize size, u8 pattern) -> Block
+  {
+    const auto allocation = allocator->try_allocate(size, alignof(std::max_align_t), "test"_str);
+    const Block block     = {soul::cast<byte*>(allocation.addr), size, pattern};
+    if (block.addr != nullptr)
+    {
+      fill_block(block);
+    }
+    return block;
+  }
+} // namespace
+
+class TestThreadCachingAllocator : public testing::Test
+{
+public:
+  soul::memory::MallocAllocator backing_allocator{"Test backing allocator"_str};
+  ThreadCachingAllocator allocator{"Test thread caching allocator"_str, &backing_allocator};
+};
+
+TEST_F(TestThreadCachingAllocator, TestSizeClassRoundTrip)
+{
+  static constexpr usize MAX_SMALL_REQUEST_SIZE =
+    ThreadCachingAllocator::MAX_SMALL_SIZE - ThreadCachingAllocator::SIZE_TAG_SIZE;
+  for (usize size = 1; size <= MAX_SMALL_REQUEST_SIZE; size += 7)
+  {
+    SOUL_TEST_MESSAGE(std::to_string(size).c_str());
+    std::vector<Block> blocks;
+    for (u8 block_index = 0; block_index < 16; block_index++)
+    {
+      blocks.push_back(allocate_block(&allocator, size, block_index));
+      SOUL_TEST_ASSERT_NE(blocks.back().addr, nullptr);
+      SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(blocks.back().addr), size);
+    }
+    for (const Block& block : blocks)
+    {
+      SOUL_TEST_ASSERT_TRUE(is_block_intact(block));
+    }
+
+    // NOTE(kevinyu): Freed blocks stay in the thread cache, so the same size class hand them back.
+    std::vector<byte*> freed_addrs;
+    for (const Block& block : blocks)
+    {
+      freed_addrs.push_back(block.addr);
+      allocator.deallocate(block.addr);
+    }
+    for (usize block_index = 0; block_index < blocks.size(); block_index++)
+    {
+      void* addr = allocator.allocate(size, alignof(std::max_align_t));
+      SOUL_TEST_ASSERT_TRUE(std::ranges::find(freed_addrs, addr) != freed_addrs.end());
+      allocator.deallocate(addr);
+    }
+  }
+}
+
+TEST_F(TestThreadCachingAllocator, TestLargeAllocation)
+{
+  const usize sizes[] = {
+    ThreadCachingAllocator::MAX_SMALL_SIZE + 1,
+    ThreadCachingAllocator::CHUNK_SIZE,
+    4 * soul::ONE_MEGABYTE + 3};
+  std::vector<Block> blocks;
+  for (const usize size : sizes)
+  {
+    blocks.push_back(allocate_block(&allocator, size, soul::cast<u8>(size)));
+    SOUL_TEST_ASSERT_NE(blocks.back().addr, nullptr);
+    SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(blocks.back().addr), size);
+  }
+  for (const Block& block : blocks)
+  {
+    SOUL_TEST_ASSERT_TRUE(is_block_intact(block));
+    allocator.deallocate(block.addr);
+  }
+}
+
+TEST(TestThreadCachingAllocatorBacking, TestLargeBlockCache)
+{
+  TestAllocator backing_allocator("Test backing allocator"_str);
+  ThreadCachingAllocator allocator("Test thread caching allocator"_str, &backing_allocator);
+
+  // NOTE(kevinyu): A freed large block is cached and handed out again for a similar size.
+  const int alloc_count   = backing_allocator.allocCount;
+  const Block first_block = allocate_block(&allocator, 100 * soul::ONE_KILOBYTE, 0x11);
+  SOUL_TEST_ASSERT_NE(first_block.addr, nullptr);
+  SOUL_TEST_ASSERT_EQ(backing_allocator.allocCount, alloc_count + 1);
+  const int free_count = backing_allocator.freeCount;
+  allocator.deallocate(first_block.addr);
+  SOUL_TEST_ASSERT_EQ(backing_allocator.freeCount, free_count);
+
+  const Block second_block = allocate_block(&allocator, 90 * soul::ONE_KILOBYTE, 0x22);
+  SOUL_TEST_ASSERT_EQ(second_block.addr, first_block.addr);
+  SOUL_TEST_ASSERT_EQ(backing_allocator.allocCount, alloc_count + 1);
+  SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(second_block.addr), second_block.size);
+  allocator.deallocate(second_block.addr);
+
+  // NOTE(kevinyu): Blocks that do not fit in the cache go straight back to the backing allocator.
+  const Block huge_block =
+    allocate_block(&allocator, ThreadCachingAllocator::MAX_LARGE_CACHE_SIZE + 1, 0x33);
+  SOUL_TEST_ASSERT_NE(huge_block.addr, nullptr);
+  SOUL_TEST_ASSERT_EQ(backing_allocator.allocCount, alloc_count + 2);
+  allocator.deallocate(huge_block.addr);
+  SOUL_TEST_ASSERT_EQ(backing_allocator.freeCount, free_count + 1);
+}
+
+TEST(TestThreadCachingAllocatorBacking, TestReset)
+{
+  static constexpr usize BLOCK_COUNT = 2000;
+  static constexpr usize BLOCK_SIZE  = 200;
+
+  TestAllocator backing_allocator("Test backing allocator"_str);
+  ThreadCachingAllocator allocator("Test thread caching allocator"_str, &backing_allocator);
+  for (usize block_index = 0; block_index < BLOCK_COUNT; block_index++)
+  {
+    SOUL_TEST_ASSERT_NE(allocate_block(&allocator, BLOCK_SIZE, 0x44).addr, nullptr);
+  }
+  SOUL_TEST_ASSERT_NE(allocate_block(&allocator, soul::ONE_MEGABYTE, 0x55).addr, nullptr);
+  const int alloc_count = backing_allocator.allocCount;
+  const int free_count  = backing_allocator.freeCount;
+
+  // NOTE(kevinyu): reset() give the live large block back and keep the spans, so the small blocks
+  // are carved again without asking the backing allocator.
+  allocator.reset();
+  SOUL_TEST_ASSERT_EQ(backing_allocator.freeCount, free_count + 1);
+  for (usize block_index = 0; block_index < BLOCK_COUNT; block_index++)
+  {
+    const Block block = allocate_block(&allocator, BLOCK_SIZE, 0x66);
+    SOUL_TEST_ASSERT_NE(block.addr, nullptr);
+    SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(block.addr), BLOCK_SIZE);
+  }
+  SOUL_TEST_ASSERT_EQ(backing_allocator.allocCount, alloc_count);
+  allocator.reset();
+}
+
+TEST_F(TestThreadCachingAllocator, TestAlignment)
+{
+  const usize sizes[] = {1, 24, 100, 1000, ThreadCachingAllocator::MAX_SMALL_SIZE, 100000};
+  for (usize alignment = 1; alignment < ThreadCachingAllocator::CHUNK_SIZE; alignment *= 2)
+  {
+    for (const usize size : sizes)
+    {
+      const auto allocation = allocator.try_allocate(size, alignment, "test"_str);
+      SOUL_TEST_ASSERT_NE(allocation.addr, nullptr);
+      SOUL_TEST_ASSERT_EQ(allocation.size, size);
+      const usize effective_alignment = std::max(alignment, ThreadCachingAllocator::MIN_ALIGNMENT);
+      SOUL_TEST_ASSERT_EQ(soul::cast<uptr>(allocation.addr) % effective_alignment, 0)
+        << "Alignment : " << alignment << ", size : " << size;
+      SOUL_TEST_ASSERT_EQ(allocator.get_allocation_size(allocation.addr), size);
+      std::memset(allocation.addr, 0xAB, size);
+      allocator.deallocate(allocation.addr);
+    }
+  }
+}
+
+TEST_F(TestThreadCachingAllocator, TestCrossThreadFree)
+{
+  static constexpr usize THREAD_COUNT = 4;
+  static constexpr usize ROUND_COUNT  = 200;
+  static constexpr usize BLOCK_COUNT  = 64;
+
+  // NOTE(kevinyu): Every thread allocate blocks and hand them to the next thread, which check the
+  // content and free them. Blocks freed by a thread that did not allocate them must be reusable
+  // and never handed out twice.
+  std::mutex mailbox_mutex;
+  std::vector<Block> mailboxes[THREAD_COUNT];
+  std::atomic<usize> corrupted_count = 0;
+  std::atomic<usize> failed_count    = 0;
+
+  std::vector<std::thread> threads;
+  for (usize thread_index = 0; thread_index < THREAD_COUNT; thread_index++)
+  {
+    threads.emplace_back(
+      [&, thread_index]()
+      {
+        std::mt19937 random_engine(soul::cast<u32>(thread_index));
+        std::uniform_int_distribution<usize> size_distribution(1, 2 * soul::ONE_KILOBYTE);
+        for (usize round = 0; round < ROUND_COUNT; round++)
+        {
+          std::vector<Block> blocks;
+          for (usize block_index = 0; block_index < BLOCK_COUNT; block_index++)
+          {
+            const auto pattern = soul::cast<u8>(thread_index * BLOCK_COUNT + block_index);
+            const Block block  = allocate_block(&allocator, size_distribution(random_engine), pattern);
+            if (block.addr == nullptr)
+            {
+              failed_count++;
+              continue;
+            }
+            blocks.push_back(block);
+          }
+
+          std::vector<Block> received_blocks;
+          {
+            std::lock_guard guard(mailbox_mutex);
+            auto& next_mailbox = mailboxes[(thread_index + 1) % THREAD_COUNT];
+            next_mailbox.insert(next_mailbox.end(), blocks.begin(), blocks.end());
+            std::swap(received_blocks, mailboxes[thread_index]);
+          }
+          for (const Block& block : received_blocks)
+          {
+            if (!is_block_intact(block))
+            {
+              corrupted_count++;
+            }
+            allocator.deallocate(block.addr);
+          }
+        }
+      });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const auto& mailbox : mailboxes)
+  {
+    for (const Block& block : mailbox)
+    {
+      SOUL_TEST_ASSERT_TRUE(is_block_intact(block));
+      allocator.deallocate(block.addr);
+    }
+  }
+  SOUL_TEST_ASSERT_EQ(failed_count.load(), 0);
+  SOUL_TEST_ASSERT_EQ(corrupted_count.load(), 0);
+}
@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "memory/util.h"
+
 #include "util.h"
 
 TestObject::Diagnostic TestObject::s_diagnostic = TestObject::Diagnostic();
@@ -7,6 +12,23 @@ int TestAllocator::freeCountAll      = 0;
 size_t TestAllocator::allocVolumeAll = 0;
 void* TestAllocator::lastAllocation  = nullptr;
 
+namespace
+{
+  // NOTE(kevinyu): Stored right before the address returned to the user, the same layout as
+  // MallocAllocator, so the requested alignment is honored and the size does not depend on _msize.
+  struct TestAllocationHeader
+  {
+    void* base_addr;
+    usize size;
+  };
+
+  auto get_test_allocation_header(void* addr) -> TestAllocationHeader*
+  {
+    return soul::cast<TestAllocationHeader*>(
+      soul::memory::util::pointer_sub(addr, sizeof(TestAllocationHeader)));
+  }
+} // namespace
+
 auto TestAllocator::try_allocate(usize size, usize alignment, StringView tag)
   -> soul::memory::Allocation
 {
@@ -14,12 +36,21 @@ auto TestAllocator::try_allocate(usize size, usize alignment, StringView tag)
   {
     return {nullptr, 0};
   }
+  alignment       = std::max(alignment, alignof(TestAllocationHeader));
+  void* base_addr = malloc(size + sizeof(TestAllocationHeader) + alignment - 1); // NOLINT
+  if (base_addr == nullptr)
+  {
+    return {nullptr, 0};
+  }
+  const uptr addr_value =
+    (reinterpret_cast<uptr>(base_addr) + sizeof(TestAllocationHeader) + alignment - 1) &
+    ~(alignment - 1);
+  lastAllocation = reinterpret_cast<void*>(addr_value); // NOLINT(performance-no-int-to-ptr)
+  *get_test_allocation_header(lastAllocation) = {base_addr, size};
   ++allocCount;
   ++allocCountAll;
-  lastAllocation             = malloc(size);
-  const auto allocation_size = get_allocation_size(lastAllocation);
-  allocVolume += allocation_size;
-  allocVolumeAll += allocation_size;
+  allocVolume += size;
+  allocVolumeAll += size;
   return {lastAllocation, size};
 }
 
@@ -29,7 +60,7 @@ auto TestAllocator::get_allocation_size(void* addr) const -> usize
   {
     return 0;
   }
-  return _msize(addr);
+  return get_test_allocation_header(addr)->size;
 }
 
 auto TestAllocator::deallocate(void* addr) -> void
@@ -43,5 +74,5 @@ auto TestAllocator::deallocate(void* addr) -> void
   ++freeCountAll;
   allocVolume -= allocation_size;
   allocVolumeAll -= allocation_size;
-  free(addr);
+  free(get_test_allocation_header(addr)->base_addr); // NOLINT
 }